@@ -0,0 +1,28 @@
+#pragma once
+// Analog sensor backend (hall-effect, light beam, potentiometer, load cell amp)
+// SENSORS[] entries with PresentWhen::ABOVE / BELOW, a raw 12-bit `threshold`
+// and optional `hysteresis`, on ADC1 pins (GPIO 32-39). The ADC runs in
+// continuous mode and DMAs its conversions into a buffer on its own; the
+// input sampler only drains that buffer, filters each channel with a moving
+// average and publishes one "above threshold" bit per pin (EY_BANK_ANALOG).
+// The solve logic sees a plain digital sensor, debounced like any other.
+// Feature guard: #define HAS_ANALOG in prop config
+//   optional ANALOG_SAMPLE_HZ    (default 20000) — total conversions/s, shared by all channels
+//   optional ANALOG_AVG_SAMPLES  (default 16, power of two) — moving-average window per channel
+//   optional ANALOG_REPORT_RAW   — add each analog sensor's filtered reading to status details
+
+#include <Arduino.h>
+
+// Input pollers EY_Analog_Begin() registers (EY_Inputs.cpp sizes its table with them)
+#ifdef HAS_ANALOG
+static constexpr uint8_t EY_ANALOG_POLLERS = 1;
+#else
+static constexpr uint8_t EY_ANALOG_POLLERS = 0;
+#endif
+
+// Start continuous conversion on every analog sensor pin and register with
+// the input sampler. Call before EY_Inputs_Begin().
+void EY_Analog_Begin();
+
+// Filtered (moving-average) reading of an analog sensor pin, 0-4095
+uint16_t EY_Analog_GetValue(uint8_t gpio);
@@ -13,7 +13,9 @@
 // the puzzle is reset.
 //
 // Config (from prop header, under #ifdef HAS_BOBINE):
-//   BOBINE_PUCK_PINS[]     array of GPIO pins driving each puck
+//   BOBINE_PUCK_PINS[]     array of pins driving each puck (GPIO, or uint16_t
+//                          EY_HC595_PIN / EY_PCA9685_PIN / EY_PIXEL_PIN / EY_DMX_PIN,
+//                          see EY_Outputs.h)
 //   BOBINE_PUCK_COUNT      number of pucks (size of array)
 //   BOBINE_ACTIVE_HIGH     true if GPIO HIGH lights the puck
 //   BOBINE_SEQUENCE[]      order of puck indices to light
@@ -22,12 +24,10 @@
 //   BOBINE_GAP_MS          off-time between pucks
 //   BOBINE_PAUSE_MS        off-time after full sequence
 
-// Initialize pins (all pucks off). Call once in setup().
+// Initialize pins (all pucks off). Call once in setup(), after
+// EY_Loop_Begin(): the sequence steps on a loop timer (EY_Loop.h).
 void EY_Bobine_Begin();
 
-// Advance state machine. Non-blocking. Call every loop iteration.
-void EY_Bobine_Tick();
-
 // Begin the light sequence. Safe to call if already running (no-op).
 void EY_Bobine_Start();
 
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "EY_Types.h"  // For SensorDef, PresentWhen, SolveMode
+#include "EY_SolveExpr.h"  // For SOLVE_EXPR / EY_SENSOR in prop headers
+#include "EY_Sequence.h"   // For SEQUENCE_PATTERN / EY_SEQUENCE in prop headers
+#include "EY_Rhythm.h"     // For RHYTHM_PATTERN / EY_RHYTHM in prop headers
 
 // Firmware Version (increment when making changes)
 static constexpr const char* FIRMWARE_VERSION = "1.5.0";
@@ -53,16 +56,52 @@ static const unsigned long RESET_HOLD_MS           = 1000;  // Button hold time
 static const unsigned long RESET_FEEDBACK_MS       = 1500;  // Fast blink duration after reset
 static const unsigned long RESET_FEEDBACK_BLINK_MS = 100;   // Fast blink rate
 static const unsigned long IGNORE_SENSORS_MS       = 2000;  // Ignore sensors briefly after reset
-static const unsigned long DEBOUNCE_MS             = 20;    // Debounce window for mechanical sensors (ms)
+static const unsigned long DEBOUNCE_MS             = 20;    // Debounce window (ms): TRAILING hold time (sampled every DEBOUNCE_MS/4), LEADING lockout
+static const uint32_t INPUT_SAMPLE_HZ               = 1000;  // Fixed input sampling rate (esp_timer), see EY_Inputs.h
+static const uint32_t INPUT_RING_SIZE               = 64;    // Input changes buffered per consumer (power of two)
+static const uint32_t LOOP_POLL_MS                  = 10;    // Longest loop() sleep: MQTT/OTA/WiFi polling, see EY_Loop.h
+static const uint16_t EDGE_LOG_SIZE                 = 256;   // Raw sensor edges kept per session (EY_EdgeLog)
+static const uint16_t EDGE_LOG_CHUNK_BYTES          = 640;   // Max edge text per MQTT dump message
+static const unsigned long DEBOUNCE_ADAPTIVE_MIN_MS = 2;    // ADAPTIVE: shortest learned quiet window
+static const unsigned long DEBOUNCE_ADAPTIVE_MAX_MS = 80;   // ADAPTIVE: longest learned quiet window
+static const uint8_t DEBOUNCE_MAJORITY_SAMPLES      = 8;    // MAJORITY: samples per window (max 8), every DEBOUNCE_MS/samples
+static const uint8_t DEBOUNCE_MAJORITY_THRESHOLD    = 6;    // MAJORITY: samples needed to flip the level
+static const uint8_t RHYTHM_TOLERANCE_PCT           = 25;   // RHYTHM: max error per gap at the player's tempo
+static const unsigned long RHYTHM_TIMEOUT_MS        = 2500; // RHYTHM: pause that starts a new attempt
 
 // =====================
 // Per-Prop Config
 // =====================
 // Each prop has its own file in include/props/ defining:
 //   SITE_ID, ROOM_ID, DEVICE_ID, DEVICE_NAME
-//   SENSORS[], SENSOR_COUNT, SOLVE_MODE
+//   SENSORS[], SENSOR_COUNT, SOLVE_MODE (SOLVE_COUNT for SolveMode::COUNT,
+//     SOLVE_EXPR for SolveMode::CUSTOM, optional SEQUENCE_PATTERN for SolveMode::SEQUENCE,
+//     RHYTHM_PATTERN for SolveMode::RHYTHM)
 //   OUTPUTS[], OUTPUT_COUNT
 //   LED_ACTIVE_LOW, LED_MIRROR_SENSOR
+//   Optional input expanders (SensorDef::pin = EY_MCP23017_PIN / EY_HC165_PIN / EY_MATRIX_PIN):
+//     HAS_MCP23017: MCP23017_CHIPS[], MCP23017_COUNT, MCP23017_SDA_PIN, MCP23017_SCL_PIN
+//     HAS_HC165:    HC165_CHIP_COUNT, HC165_LOAD_PIN, HC165_CLK_PIN, HC165_DATA_PIN
+//     HAS_MATRIX:   MATRIX_ROW_PINS[], MATRIX_ROWS, MATRIX_COL_PINS[], MATRIX_COLS
+//   Optional output expanders (OutputDef::pin = EY_HC595_PIN / EY_PCA9685_PIN / EY_PIXEL_PIN / EY_DMX_PIN):
+//     HAS_HC595 (see EY_HC595.h), HAS_PCA9685 (see EY_PCA9685.h),
+//     HAS_PIXELS (WS2812 strip, see EY_Pixels.h), HAS_DMX (DMX512 universe, see EY_DMX.h)
+//   Optional servos (SERVOS[], SERVO_COUNT, motion profiles): HAS_SERVO (see EY_Servo.h)
+//   Optional stepper motors (STEPPERS[], STEPPER_COUNT, homing): HAS_STEPPER (see EY_Stepper.h)
+//   Optional analog sensors (PresentWhen::ABOVE/BELOW + threshold/hysteresis):
+//     HAS_ANALOG    (see EY_Analog.h)
+//   Optional touch sensors (PresentWhen::TOUCH): HAS_TOUCH (see EY_Touch.h)
+//   Optional rotary wheel (SensorDef::pin = EY_WHEEL_SEGMENT): HAS_WHEEL (see EY_Wheel.h)
+//   Optional SPI RFID readers (SensorDef::pin = EY_RFID_READER): HAS_RFID (see EY_RFID.h)
+//   Optional ESP-NOW sensor nodes (SensorDef::pin = EY_NODE_PIN): HAS_NODES (see EY_Nodes.h)
+//   Optional puzzle groups (several puzzles on one board, SensorDef/OutputDef::group):
+//     HAS_PUZZLE_GROUPS: PUZZLE_GROUPS[], PUZZLE_GROUP_COUNT (replace SOLVE_MODE/SOLVE_COUNT;
+//     propIds must differ from DEVICE_ID, which stays the board's own topic for
+//     diag, the MQTT will and board-wide commands; group propIds have no /lwt of
+//     their own, their presence is the board's /lwt). Generic sensor props only.
+//
+// SENSORS[] (and module pin tables like VEHICLE_PINS) must be constexpr:
+// input pin masks are built from them at compile time.
 //
 // Build with: pio run -e <prop_name>
 //
@@ -70,3 +109,33 @@ static const unsigned long DEBOUNCE_MS             = 20;    // Debounce window f
   #error "No prop selected! Use: pio run -e <prop_name>"
 #endif
 #include PROP_CONFIG
+
+// N-of-M threshold for SolveMode::COUNT (unused by other modes)
+#ifndef SOLVE_COUNT
+  #define SOLVE_COUNT 0
+#endif
+
+// Solve expression for SolveMode::CUSTOM (never true unless the prop defines one)
+#ifndef SOLVE_EXPR
+  #define SOLVE_EXPR EY_SolveExpr()
+#endif
+
+// Press pattern for SolveMode::SEQUENCE (default: each non-decorative sensor
+// once, in declaration order)
+#ifndef SEQUENCE_PATTERN
+  #define SEQUENCE_PATTERN EY_SeqPattern()
+#endif
+
+// Rhythm for SolveMode::RHYTHM (required by that mode)
+#ifndef RHYTHM_PATTERN
+  #define RHYTHM_PATTERN EY_RhythmPattern()
+#endif
+
+// Single implicit puzzle group unless the prop declares its own:
+// DEVICE_ID, SOLVE_MODE, every sensor and output
+#ifndef HAS_PUZZLE_GROUPS
+static constexpr PuzzleGroupDef PUZZLE_GROUPS[] = {
+  { nullptr, nullptr, SOLVE_MODE, SOLVE_COUNT },
+};
+static constexpr uint8_t PUZZLE_GROUP_COUNT = 1;
+#endif
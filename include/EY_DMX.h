@@ -0,0 +1,89 @@
+#pragma once
+// DMX512 transmitter (one universe on a UART + RS485 transceiver)
+// Modules write channel levels into a buffer at any time; the timer
+// service (EY_Timer.h) hands the whole universe to the UART driver every
+// refresh period (default 44 Hz). The driver's interrupt feeds the UART
+// FIFO and ends each frame with the break. The CPU only copies the buffer
+// once per frame, and fixtures keep getting frames even when nothing changes.
+//
+// DMX timing at 250 kbaud, 8N2 (4 µs per bit):
+//   break 25 bits (100 µs, spec >= 92), start code 0, then DMX_CHANNELS
+//   slots of 44 µs. The mark-after-break is the line idle from the end of
+//   the break to the next frame: whatever the refresh period leaves (55 µs
+//   for 512 channels at 44 Hz, ~77 ms at 10 Hz; spec 12 µs to 1 s), and
+//   never less than EY_DMX_MAB_BITS, the UART's idle time between transfers.
+// The first frame after boot has no break in front of it: fixtures drop it.
+//
+// Channels 1-64 are also output pins, EY_DMX_PIN(channel) in OUTPUTS[] or
+// with EY_Outputs_WritePin: on sets the channel to DMX_ON_LEVEL, off to 0.
+//
+// Feature guard: #define HAS_DMX in prop config, with
+//   DMX_TX_PIN
+//   optional DMX_ENABLE_PIN  RS485 driver enable, held HIGH (omit if hard-wired)
+//   optional DMX_UART        UART number (default 2; UART0 is Serial)
+//   optional DMX_CHANNELS    slots per frame, 24-512 (default 512)
+//   optional DMX_REFRESH_HZ  frames per second (default 44, the most a full universe allows)
+//   optional DMX_ON_LEVEL    level of a channel pin that is on (default 255)
+
+#include <Arduino.h>
+
+#ifndef DMX_CHANNELS
+  #define DMX_CHANNELS 512
+#endif
+
+// ---- Timing (ANSI E1.11), checked on the host by test/test_dmx ----
+static constexpr uint32_t EY_DMX_BAUD = 250000;
+static constexpr uint32_t EY_DMX_BIT_US = 1000000UL / EY_DMX_BAUD;  // 4 µs
+static constexpr uint32_t EY_DMX_SLOT_US = 11 * EY_DMX_BIT_US;      // Start + 8 data + 2 stop bits
+static constexpr uint8_t  EY_DMX_BREAK_BITS = 25;                   // Sent by the UART driver
+static constexpr uint8_t  EY_DMX_MAB_BITS = 3;                      // Shortest UART idle before the next frame
+static constexpr uint32_t EY_DMX_RETRY_US = 1000;                   // Previous frame still going out
+
+// Break, shortest mark-after-break, start code and `channels` slots, in µs
+constexpr uint32_t EY_DMX_FrameUs(uint16_t channels) {
+  return (EY_DMX_BREAK_BITS + EY_DMX_MAB_BITS) * EY_DMX_BIT_US + (1 + channels) * EY_DMX_SLOT_US;
+}
+
+// Frame scheduling, one timer pass at `nowUs`. `busy`: the previous frame
+// or its break is still going out. Returns true if a frame goes out now;
+// `atUs` is when the timer runs next. Frames are due every `periodUs` from
+// `nextUs`; a late frame does not make the next ones catch up, and a
+// frame held back by a busy UART restarts the period from when it goes out.
+inline bool EY_DMX_NextFrame(uint64_t& nextUs, uint32_t periodUs, uint64_t nowUs, bool busy, uint64_t& atUs) {
+  if (busy) {
+    nextUs = nowUs + EY_DMX_RETRY_US;
+    atUs = nextUs;
+    return false;
+  }
+  nextUs += periodUs;
+  if (nextUs <= nowUs) nextUs = nowUs + periodUs;
+  atUs = nextUs;
+  return true;
+}
+
+// Highest refresh rate a frame of `channels` slots allows
+constexpr uint32_t EY_DMX_MaxRefreshHz(uint16_t channels) {
+  return 1000000UL / EY_DMX_FrameUs(channels);
+}
+
+// Set up the UART and start sending frames (all channels 0).
+// Call before EY_Outputs_Begin().
+void EY_DMX_Begin();
+
+// ---- Levels (any task; sent with the next frame) ----
+// Channels are numbered 1-DMX_CHANNELS like on the fixtures.
+
+void EY_DMX_Set(uint16_t channel, uint8_t level);
+void EY_DMX_Fill(uint16_t first, uint16_t count, uint8_t level);
+void EY_DMX_SetRange(uint16_t first, const uint8_t* levels, uint16_t count);
+uint8_t EY_DMX_Get(uint16_t channel);
+
+// All channels to 0
+void EY_DMX_Blackout();
+
+// ---- Output pins (used by EY_Outputs) ----
+
+// Switch channels 1-64 (bit n = channel n + 1) to DMX_ON_LEVEL (set) or 0
+// (clear). Safe from any task, also inside a critical section. No refresh
+// needed: the next frame carries the change.
+void EY_DMX_Write(uint64_t set, uint64_t clear);
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <Arduino.h>
+#include <type_traits>
+
+// ============================================================
+// Bit-parallel input debouncer (vertical counter)
+// ============================================================
+// One debouncer covers every input of a module, packed one input per bit
+// into a 32- or 64-bit word. Each input owns a 2-bit counter stored
+// "vertically" across two words (ct0 = low bit, ct1 = high bit), so a
+// single sample debounces all inputs with a handful of bitwise ops:
+//
+//   - an input whose raw level matches its debounced level has its
+//     counter cleared;
+//   - an input that differs counts up once per sample, and flips its
+//     debounced level when the counter wraps — i.e. after 4 consecutive
+//     differing samples.
+//
+// Samples are taken on a fixed grid of windowMs / 4, so an input must
+// hold a new level for ~windowMs before it is accepted (same behavior as
+// the old per-input lastRaw/lastChangeMs debounce, without per-input
+// millis() arithmetic).
+//
+// Usage (driven by the input sampler's replay, see EY_Inputs.h):
+//   static EY_Debouncer<EY_DebounceWord<SENSOR_COUNT>> s_debouncer;
+//   s_debouncer.begin(DEBOUNCE_MS, rawBits);
+//   auto changed = s_debouncer.sampleUntil(timeMs, rawBits);  // bits that flipped
+//   auto levels  = s_debouncer.state;                         // debounced levels
+
+// Smallest word that holds N inputs
+template <uint16_t N>
+using EY_DebounceWord = typename std::conditional<(N <= 32), uint32_t, uint64_t>::type;
+
+template <typename Word>
+struct EY_Debouncer {
+  Word state;                  // Debounced level of every input (1 = active)
+  Word ct0;                    // Vertical counter, low bit-plane
+  Word ct1;                    // Vertical counter, high bit-plane
+  unsigned long periodMs;      // Sample cadence (window / 4)
+  unsigned long lastSampleMs;  // millis() of the last accepted sample
+
+  // Configure the window and seed the debounced state (no edges reported
+  // for inputs that are already active).
+  void begin(unsigned long windowMs, Word initial) {
+    periodMs = (windowMs >= 4) ? (windowMs / 4) : 1;
+    reset(initial);
+  }
+
+  // Re-seed the debounced state and clear every counter.
+  void reset(Word initial) {
+    state = initial;
+    ct0 = 0;
+    ct1 = 0;
+    lastSampleMs = millis();
+  }
+
+  // True when the next sample on the grid is due by nowMs (and consumes
+  // it). Signed compare: a nowMs slightly before the last sample is "not due".
+  bool due(unsigned long nowMs) {
+    if ((long)(nowMs - lastSampleMs) < (long)periodMs) return false;
+    lastSampleMs += periodMs;
+    return true;
+  }
+
+  // Take every sample due by nowMs, all with the same raw level (the level
+  // held since the previous call). Returns the OR of flipped inputs. More
+  // than 4 missed samples are collapsed: the counters saturate by then.
+  Word sampleUntil(unsigned long nowMs, Word raw) {
+    Word flipped = 0;
+    for (uint8_t n = 0; n < 4 && due(nowMs); n++) flipped |= sample(raw);
+    if ((long)(nowMs - lastSampleMs) >= (long)periodMs) lastSampleMs = nowMs;
+    return flipped;
+  }
+
+  // Feed one raw sample of every input. Returns the inputs whose debounced
+  // level flipped on this sample (read the new levels from `state`).
+  Word sample(Word raw) {
+    Word delta = raw ^ state;       // inputs disagreeing with their debounced level
+    ct1 = (ct1 ^ ct0) & delta;      // count up (high bit), clear where agreeing
+    ct0 = ~ct0 & delta;             // count up (low bit),  clear where agreeing
+    Word toggle = delta & ~(ct0 | ct1);  // counter wrapped 3 -> 0: 4 samples in a row
+    state ^= toggle;
+    return toggle;
+  }
+};
+
+// ============================================================
+// Per-input debounce policies (DebouncePolicy in EY_Types.h)
+// ============================================================
+// LEADING, ADAPTIVE and MAJORITY keep a little state per input, for up to
+// N inputs (bit i = input i). Each update() takes the raw levels held at
+// nowMs and the inputs of `mask` that use the policy, flips the inputs it
+// accepts in `level` and returns them. Work is proportional to the inputs
+// that use the policy and are actually moving. Replayed against bounce
+// traces on the host by test/test_debounce_replay.
+
+// Index of the lowest set bit (mask must be non-zero)
+inline uint8_t EY_Debounce_Lowest(uint64_t mask) {
+  return (uint8_t)__builtin_ctzll(mask);
+}
+
+// LEADING: act on the first edge, then hold the level for windowMs.
+// A release during the lockout is picked up as soon as it ends.
+template <uint8_t N>
+struct EY_LeadingDebounce {
+  uint64_t lockout;               // Inputs inside their post-edge lockout
+  unsigned long startMs[N];       // ...and when it started
+  unsigned long windowMs;
+
+  void begin(unsigned long window) {
+    windowMs = window;
+    reset();
+  }
+
+  void reset() { lockout = 0; }
+
+  uint64_t update(uint64_t raw, uint64_t& level, uint64_t mask, unsigned long nowMs) {
+    for (uint64_t m = lockout; m; m &= m - 1) {
+      uint8_t i = EY_Debounce_Lowest(m);
+      if (nowMs - startMs[i] >= windowMs) lockout &= ~(1ULL << i);
+    }
+
+    uint64_t flipped = (raw ^ level) & mask & ~lockout;
+    for (uint64_t m = flipped; m; m &= m - 1) startMs[EY_Debounce_Lowest(m)] = nowMs;
+    lockout |= flipped;
+    level ^= flipped;
+    return flipped;
+  }
+};
+
+// ADAPTIVE: trailing debounce whose quiet window tracks each input's bounce.
+// A burst starts on the first raw edge and ends once the input has been
+// quiet for the input's window; the burst width then nudges the window
+// towards twice the observed bounce (clamped to minMs..maxMs).
+template <uint8_t N>
+struct EY_AdaptiveDebounce {
+  struct Input {
+    unsigned long burstStartMs;
+    unsigned long lastEdgeMs;
+    unsigned long windowMs;       // Learned quiet window
+  };
+  uint64_t lastRaw;               // Raw level at the last update
+  uint64_t burst;                 // Inputs inside a bounce burst
+  Input inputs[N];
+  unsigned long minMs;
+  unsigned long maxMs;
+
+  // Start every input's window at `initialMs`. Learned windows are kept
+  // across reset().
+  void begin(unsigned long initialMs, unsigned long min, unsigned long max, uint64_t raw) {
+    minMs = min;
+    maxMs = max;
+    for (uint8_t i = 0; i < N; i++) inputs[i].windowMs = initialMs;
+    reset(raw);
+  }
+
+  void reset(uint64_t raw) {
+    lastRaw = raw;
+    burst = 0;
+  }
+
+  uint64_t update(uint64_t raw, uint64_t& level, uint64_t mask, unsigned long nowMs) {
+    uint64_t edges = (raw ^ lastRaw) & mask;
+    lastRaw = raw & mask;
+    for (uint64_t m = edges; m; m &= m - 1) {
+      uint8_t i = EY_Debounce_Lowest(m);
+      if (!(burst & (1ULL << i))) inputs[i].burstStartMs = nowMs;
+      inputs[i].lastEdgeMs = nowMs;
+    }
+    burst |= edges;
+
+    uint64_t flipped = 0;
+    for (uint64_t m = burst; m; m &= m - 1) {
+      uint8_t i = EY_Debounce_Lowest(m);
+      Input& in = inputs[i];
+      if (nowMs - in.lastEdgeMs < in.windowMs) continue;
+
+      unsigned long target = 2 * (in.lastEdgeMs - in.burstStartMs);
+      if (target < minMs) target = minMs;
+      if (target > maxMs) target = maxMs;
+      // Smooth, rounding towards the target so the window reaches it
+      // exactly: down while it shrinks, up while it grows
+      in.windowMs = (3 * in.windowMs + target + (target > in.windowMs ? 3 : 0)) / 4;
+
+      burst &= ~(1ULL << i);
+      flipped |= (raw ^ level) & (1ULL << i);  // glitches that came back are dropped
+    }
+    level ^= flipped;
+    return flipped;
+  }
+};
+
+// MAJORITY: oversample `samples` times per window and flip once
+// `threshold` of the recent samples disagree with the current level
+// (hysteresis on both edges).
+template <uint8_t N>
+struct EY_MajorityDebounce {
+  uint8_t history[N];             // Last samples per input (bit 0 = newest)
+  unsigned long periodMs;
+  unsigned long lastMs;           // Last sample on the grid
+  uint8_t samples;                // 1-8
+  uint8_t threshold;
+
+  void begin(unsigned long windowMs, uint8_t count, uint8_t needed, uint64_t raw) {
+    samples = count;
+    threshold = needed;
+    periodMs = (windowMs >= samples) ? (windowMs / samples) : 1;
+    reset(raw);
+  }
+
+  // Seed every history with the current level
+  void reset(uint64_t raw) {
+    lastMs = millis();
+    for (uint8_t i = 0; i < N; i++) history[i] = (raw & (1ULL << i)) ? 0xFF : 0x00;
+  }
+
+  uint64_t update(uint64_t raw, uint64_t& level, uint64_t mask, unsigned long nowMs) {
+    const uint8_t historyMask = (uint8_t)((1u << samples) - 1);
+    uint64_t flipped = 0;
+
+    // Every sample on the grid up to nowMs sees the same held level; after
+    // a full window of them the history is saturated, so stop there.
+    for (uint8_t n = 0; n < samples; n++) {
+      if ((long)(nowMs - lastMs) < (long)periodMs) break;
+      lastMs += periodMs;
+
+      uint64_t sampleFlipped = 0;
+      for (uint64_t m = mask; m; m &= m - 1) {
+        uint8_t i = EY_Debounce_Lowest(m);
+        uint64_t bit = 1ULL << i;
+        history[i] = (uint8_t)(((history[i] << 1) | ((raw & bit) ? 1 : 0)) & historyMask);
+
+        uint8_t highCount = (uint8_t)__builtin_popcount(history[i]);
+        uint8_t agreeing = (level & bit) ? highCount : (uint8_t)(samples - highCount);
+        if (samples - agreeing >= threshold) sampleFlipped |= bit;
+      }
+      level ^= sampleFlipped;
+      flipped |= sampleFlipped;
+    }
+    if ((long)(nowMs - lastMs) >= (long)periodMs) lastMs = nowMs;
+    return flipped;
+  }
+};
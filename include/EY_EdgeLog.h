@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ============================================================
+// Sensor Edge Flight Recorder
+// ============================================================
+// Records every raw edge of every sensor (as seen by the input sampler,
+// µs timestamps) into a per-session ring of EDGE_LOG_SIZE entries, and
+// keeps running statistics per sensor:
+//   - raw edges, accepted (debounced) transitions, bounces (the rest)
+//   - histogram of pulse widths (time between consecutive raw edges)
+//   - latency from the first raw edge of a change to its acceptance
+//
+// Cleared on every prop reset. Dumped on demand with the MQTT command
+// {"type":"cmd","command":"dump_edges"}, published on <base>/diag:
+//
+//   {"type":"edge_stats","sensorId":"star1","edges":14,"accepted":2,"bounces":12,
+//    "hist":[9,3,0,0,0,0,0,2],"latUs":[2100,4800,3450]}          (min,max,avg)
+//   {"type":"edge_log","part":0,"last":false,"t0":8123456,"dropped":0,"e":"0+0;0-120;0+95;3+40211"}
+//
+// In "e", each entry is <sensor index><+|-><µs since previous entry>
+// ('+' = present); the first entry of a part is at t0 (µs since session
+// start). "dropped" counts edges overwritten because the ring was full.
+//
+// Histogram buckets (µs): <1000, <2000, <5000, <10000, <20000, <50000,
+// <100000, >=100000.
+
+static const uint8_t EY_EDGE_HIST_BUCKETS = 8;
+
+// Start a new session (clears the ring and statistics)
+void EY_EdgeLog_Reset();
+
+// A sensor's raw level changed. `debounced` is its debounced level at
+// that instant (used to time the edge-to-accept latency).
+void EY_EdgeLog_RawEdge(uint8_t sensor, bool level, bool debounced, uint64_t timeUs);
+
+// A sensor's debounced level flipped
+void EY_EdgeLog_Accepted(uint8_t sensor, uint64_t timeUs);
+
+// Publish statistics and the edge ring over MQTT
+void EY_EdgeLog_Dump();
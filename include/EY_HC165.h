@@ -0,0 +1,21 @@
+#pragma once
+// 74HC165 shift-register input backend
+// Up to 16 daisy-chained chips x 8 inputs, addressed in SENSORS[] with
+// EY_HC165_PIN(chip, input). The whole chain is latched with one LOAD
+// pulse and clocked in by a single SPI DMA transaction per sampler tick.
+// Feature guard: #define HAS_HC165 in prop config, with
+//   HC165_CHIP_COUNT, HC165_LOAD_PIN (SH/LD), HC165_CLK_PIN, HC165_DATA_PIN (QH of chip 0)
+//   optional HC165_SPI_HZ (default 1 MHz)
+
+#include <Arduino.h>
+
+// Input pollers EY_HC165_Begin() registers (EY_Inputs.cpp sizes its table with them)
+#ifdef HAS_HC165
+static constexpr uint8_t EY_HC165_POLLERS = 1;
+#else
+static constexpr uint8_t EY_HC165_POLLERS = 0;
+#endif
+
+// Set up the SPI bus and register with the input sampler.
+// Call before EY_Inputs_Begin().
+void EY_HC165_Begin();
@@ -0,0 +1,25 @@
+#pragma once
+// 74HC595 shift-register output backend
+// Up to 8 daisy-chained chips x 8 outputs, addressed in OUTPUTS[] (or with
+// EY_Outputs_WritePin) as EY_HC595_PIN(chip, output). Writes update a
+// shadow of the chain; the whole chain is then shifted out by a single SPI
+// DMA transaction and latched with one RCLK pulse, from the shared timer
+// service — every change made before the refresh runs goes out together.
+// Feature guard: #define HAS_HC595 in prop config, with
+//   HC595_CHIP_COUNT, HC595_LATCH_PIN (RCLK), HC595_CLK_PIN (SRCLK), HC595_DATA_PIN (SER of chip 0)
+//   optional HC595_OE_PIN   /OE, pulled up: outputs stay off until the first frame is latched
+//   optional HC595_SPI_HZ   (default 4 MHz)
+//   optional HC595_SPI_HOST (default SPI2_HOST, SPI3_HOST when HAS_HC165 uses SPI2)
+
+#include <Arduino.h>
+
+// Set up the SPI bus. Call before EY_Outputs_Begin().
+void EY_HC595_Begin();
+
+// Set then clear bits of the chain's shadow (bit chip * 8 + output).
+// Safe from any task, also inside a critical section. Returns true if the
+// shadow changed and needs a refresh.
+bool EY_HC595_Write(uint64_t set, uint64_t clear);
+
+// Send the shadow to the chain as soon as possible (from the timer task)
+void EY_HC595_Refresh();
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ============================================================
+// Bulk Input Snapshot API
+// ============================================================
+// Every input a prop reads (sensors, LED mirror, vehicle switches,
+// reset buttons, expander pins) comes from one snapshot: an input frame.
+// A frame is a handful of 64-bit banks:
+//
+//   bank 0                = ESP32 GPIO_IN_REG/GPIO_IN1_REG (bit n = GPIO n)
+//   EY_BANK_MCP23017..+1  = MCP23017 I2C expanders (16 pins per chip, 8 chips)
+//   EY_BANK_HC165..+1     = 74HC165 shift-register chain (8 inputs per chip, 16 chips)
+//   EY_BANK_MATRIX        = scanned key matrix (up to 8x8, bit set = key down)
+//   EY_BANK_ANALOG        = analog sensors (bit n = ADC on GPIO n reads above threshold)
+//   EY_BANK_TOUCH         = touch pads (bit n = pad on GPIO n touched)
+//   EY_BANK_WHEEL         = rotary wheel (bit n = settled on segment n)
+//   EY_BANK_RFID          = SPI RFID readers (allowed tag / any tag per reader)
+//   EY_BANK_NODES         = ESP-NOW wireless nodes (8 channels per node)
+//
+// Pins are 16-bit "virtual pins": (bank << 8) | bit. A plain GPIO number
+// is a bank-0 virtual pin, so existing pin tables keep working. Backends
+// (EY_MCP23017, EY_HC165, EY_Matrix, EY_Analog, EY_Touch, EY_Wheel,
+// EY_RFID, EY_Nodes) publish their bank words; the sampler merges them with the
+// GPIO registers, so a scan costs the same whatever bank an input lives
+// on, and all inputs in a frame are sampled together.
+//
+// Fixed-rate sampler
+// ------------------
+// An esp_timer samples every input at INPUT_SAMPLE_HZ, independent of
+// how often loop() runs. Only frames that differ from the previous one
+// are stored, with their esp_timer µs timestamp, in a ring of
+// INPUT_RING_SIZE entries. Each consumer (sensors, Simon, vehicles)
+// owns a cursor and replays the changes it has not seen yet, in order,
+// with the time they were sampled — so debounce decisions depend on
+// when the inputs moved, not on when loop() got around to looking.
+//
+// Worst-case latency from a clean edge to its debounced transition is
+// one sample period + the debounce window; loop() only adds the delay
+// before the result is acted on. A consumer that falls
+// INPUT_RING_SIZE - 1 changes behind loses the oldest ones (counted in
+// its cursor's `overruns`): the slot the sampler writes next is never read.
+
+// ---- Banks ----
+static const uint8_t EY_BANK_GPIO     = 0;
+static const uint8_t EY_BANK_MCP23017 = 1;  // 2 banks
+static const uint8_t EY_BANK_HC165    = 3;  // 2 banks
+static const uint8_t EY_BANK_MATRIX   = 5;
+static const uint8_t EY_BANK_ANALOG   = 6;
+static const uint8_t EY_BANK_TOUCH    = 7;
+static const uint8_t EY_BANK_WHEEL    = 8;
+static const uint8_t EY_BANK_RFID     = 9;
+static const uint8_t EY_BANK_NODES    = 10;
+static const uint8_t EY_INPUT_BANKS   = 11;
+
+// ---- Virtual pins ----
+constexpr uint16_t EY_Pin(uint8_t bank, uint8_t bit) {
+  return (uint16_t)((bank << 8) | bit);
+}
+
+constexpr uint8_t EY_PinBank(uint16_t pin) {
+  return (uint8_t)(pin >> 8);
+}
+
+// Mask bit of a pin within its bank. constexpr so modules can build their
+// pin masks at compile time from SENSORS[] / VEHICLE_PINS.
+constexpr uint64_t EY_PinBit(uint16_t pin) {
+  return ((pin & 0xFF) < 64) ? (1ULL << (pin & 0xFF)) : 0;
+}
+
+// Pin `pin` (0-15, GPA0-7 then GPB0-7) of MCP23017 chip `chip` (index in MCP23017_CHIPS[])
+constexpr uint16_t EY_MCP23017_PIN(uint8_t chip, uint8_t pin) {
+  return EY_Pin(EY_BANK_MCP23017 + chip / 4, (uint8_t)((chip % 4) * 16 + pin));
+}
+
+// Input `input` (0-7 = A-H) of 74HC165 chip `chip` (0 = nearest the ESP32)
+constexpr uint16_t EY_HC165_PIN(uint8_t chip, uint8_t input) {
+  return EY_Pin(EY_BANK_HC165 + (chip * 8 + input) / 64, (uint8_t)((chip * 8 + input) % 64));
+}
+
+// Key at `row`, `col` (0-7, index in MATRIX_ROW_PINS[] / MATRIX_COL_PINS[])
+// of the scanned matrix. HIGH = pressed, so use PresentWhen::HIGH_LEVEL.
+constexpr uint16_t EY_MATRIX_PIN(uint8_t row, uint8_t col) {
+  return EY_Pin(EY_BANK_MATRIX, (uint8_t)(row * 8 + col));
+}
+
+// "Wheel stopped on segment `segment`" (0-63). Use PresentWhen::HIGH_LEVEL.
+constexpr uint16_t EY_WHEEL_SEGMENT(uint8_t segment) {
+  return EY_Pin(EY_BANK_WHEEL, segment);
+}
+
+// RFID reader `reader` (index in RFID_READERS[]) holds a tag on its
+// allow-list / holds any tag. Use PresentWhen::HIGH_LEVEL.
+constexpr uint16_t EY_RFID_READER(uint8_t reader) {
+  return EY_Pin(EY_BANK_RFID, reader);
+}
+
+constexpr uint16_t EY_RFID_ANY_TAG(uint8_t reader) {
+  return EY_Pin(EY_BANK_RFID, (uint8_t)(32 + reader));
+}
+
+// Channel `channel` (0-7) of ESP-NOW node `node` (0-7). HIGH = the node
+// reports the input active.
+constexpr uint16_t EY_NODE_PIN(uint8_t node, uint8_t channel) {
+  return EY_Pin(EY_BANK_NODES, (uint8_t)(node * 8 + channel));
+}
+
+// ---- Frames ----
+struct EY_InputFrame {
+  uint64_t bank[EY_INPUT_BANKS];
+};
+
+inline bool operator==(const EY_InputFrame& a, const EY_InputFrame& b) {
+  for (uint8_t i = 0; i < EY_INPUT_BANKS; i++) {
+    if (a.bank[i] != b.bank[i]) return false;
+  }
+  return true;
+}
+
+inline bool operator!=(const EY_InputFrame& a, const EY_InputFrame& b) {
+  return !(a == b);
+}
+
+// Level of one pin in a frame
+inline bool EY_Inputs_PinHigh(const EY_InputFrame& frame, uint16_t pin) {
+  uint8_t bank = EY_PinBank(pin);
+  return bank < EY_INPUT_BANKS && (frame.bank[bank] & EY_PinBit(pin)) != 0;
+}
+
+// Level of one GPIO in a GPIO-register snapshot
+inline bool EY_Inputs_PinHigh(uint64_t gpioSnapshot, uint8_t pin) {
+  return (gpioSnapshot & EY_PinBit(pin)) != 0;
+}
+
+// One stored frame
+struct EY_InputSample {
+  uint64_t timeUs;       // esp_timer_get_time() when sampled
+  EY_InputFrame frame;
+};
+
+// Per-consumer read position in the sampler ring
+struct EY_InputCursor {
+  uint32_t seq;          // Next ring entry to replay
+  EY_InputFrame frame;   // Last frame replayed (level held until the next one)
+  uint64_t lastUs;       // Last time handed out (kept monotonic)
+  uint32_t overruns;     // Changes lost because the consumer fell behind
+};
+
+// ---- Backends ----
+
+// Called by the sampler before every frame is captured, with the GPIO
+// registers of that frame (e.g. to check an expander's INT line). Runs in
+// the sampler's esp_timer task. Register from a backend's Begin, before
+// EY_Inputs_Begin(), and declare the count next to the backend's HAS_*
+// guard in its header (EY_<X>_POLLERS, summed by EY_Inputs.cpp).
+typedef void (*EY_InputPoller)(uint64_t gpio);
+void EY_Inputs_AddPoller(EY_InputPoller poller);
+
+// Store the latest word of a backend bank; picked up by the next frame.
+// Safe from any task.
+void EY_Inputs_PublishBank(uint8_t bank, uint64_t bits);
+
+// ---- Sampling ----
+
+// Start the fixed-rate sampler. Call once in setup(), after input backends
+// and before any module that reads inputs is initialized.
+void EY_Inputs_Begin();
+
+// Wait until the sampler has captured a whole frame after this call, so
+// pollers have seen state set before it (e.g. a backend reset) and the
+// next EY_Inputs_CursorBegin() seeds from that frame. Takes 1-2 sample
+// periods. Loop task only.
+void EY_Inputs_Sync();
+
+// Longest sampler scan (GPIO read, backend pollers, frame merge) since the
+// last call, in µs. Published in the status details to check a prop's
+// expanders fit the sample period.
+uint32_t EY_Inputs_TakeScanMaxUs();
+
+// Read the GPIO registers and latch this tick's live frame (GPIO + the
+// latest backend banks). Call once at the top of loop(). For live,
+// undebounced reads (LED mirror, reset buttons, PIR).
+void EY_Inputs_Sample();
+
+// GPIO registers latched by the last EY_Inputs_Sample()
+uint64_t EY_Inputs_Snapshot();
+
+// Full frame latched by the last EY_Inputs_Sample()
+const EY_InputFrame& EY_Inputs_SnapshotFrame();
+
+// Read both GPIO input registers immediately, without latching.
+uint64_t EY_Inputs_Read();
+
+// ---- Consumers ----
+
+// Start (or restart) a consumer at "now": cursor.frame holds the current
+// input levels to seed from, and only later changes will be replayed.
+void EY_Inputs_CursorBegin(EY_InputCursor& cursor);
+
+// Next change this consumer has not seen, oldest first. Returns false once
+// caught up. Updates cursor.frame.
+bool EY_Inputs_Next(EY_InputCursor& cursor, EY_InputSample& out);
+
+// Consumer's "now" (esp_timer µs), never earlier than the last change it
+// replayed
+uint64_t EY_Inputs_CursorNowUs(EY_InputCursor& cursor);
+
+// Sample time in the millis() time base
+inline unsigned long EY_Inputs_Millis(uint64_t timeUs) {
+  return (unsigned long)(timeUs / 1000);
+}
+
+// Replay every pending change for one consumer. `step(frame, timeUs)` is
+// called twice per change — with the frame held up to that change, then
+// with the new frame, both at the change's sample time — and once more
+// with the current frame at the consumer's now.
+template <typename Step>
+void EY_Inputs_Replay(EY_InputCursor& cursor, Step step) {
+  EY_InputSample sample;
+  EY_InputFrame held = cursor.frame;
+  while (EY_Inputs_Next(cursor, sample)) {
+    step((const EY_InputFrame&)held, sample.timeUs);
+    held = sample.frame;
+    step((const EY_InputFrame&)held, sample.timeUs);
+  }
+  step((const EY_InputFrame&)held, EY_Inputs_CursorNowUs(cursor));
+}
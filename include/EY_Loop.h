@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Arduino.h>
+#include "EY_Timer.h"  // For EY_TimerCallback
+
+// ============================================================
+// Event-Driven Main Loop
+// ============================================================
+// loop() no longer spins: each pass starts with EY_Loop_Wait(), which
+// blocks the loop task on a FreeRTOS task notification until
+//   - the earliest loop timer deadline or EY_Loop_WakeAt() time,
+//   - EY_Loop_Wake() from another task: the input sampler on every input
+//     change, ESP-NOW packets...
+//   - LOOP_POLL_MS at the latest, for what can only be polled: the MQTT
+//     socket, OTA, WiFi reconnects, sensor debounce windows.
+// In between, the CPU runs the FreeRTOS idle task.
+//
+// Loop timers are the loop-task counterpart of the timer service
+// (EY_Timer.h), for module state machines that log, publish or call other
+// modules (LED flash phases, Simon blinks, the Bobine sequence...). Same
+// slot model and "no later than" rule; deadlines are millis() times and
+// callbacks run inside EY_Loop_Wait(), before the next pass.
+
+static const uint8_t EY_LOOP_TIMER_SLOTS = 8;
+
+// Register the calling task (the Arduino loop task) for wake-ups.
+// Call first in setup().
+void EY_Loop_Begin();
+
+// Claim a loop timer slot. Returns its id, or -1 if every slot is taken.
+int8_t EY_Loop_TimerCreate(EY_TimerCallback callback, void* arg);
+
+// Run a slot's callback no later than `atMs` (millis() time, wrap-safe;
+// a time in the past runs it before the next pass). Loop task only.
+void EY_Loop_At(int8_t timer, uint32_t atMs);
+
+// Same, `ms` from now
+void EY_Loop_After(int8_t timer, uint32_t ms);
+
+// Drop a slot's pending deadline
+void EY_Loop_Cancel(int8_t timer);
+
+// Run the next pass no later than `atMs`, for polled logic with a deadline
+// (hold-to-reset buttons, solve timeouts...). Loop task only.
+void EY_Loop_WakeAt(uint32_t atMs);
+
+// Run the next pass now. Safe from any task, not from interrupts.
+void EY_Loop_Wake();
+
+// Sleep until the next wake-up, then run the loop timers that are due.
+// Call at the top of loop().
+void EY_Loop_Wait();
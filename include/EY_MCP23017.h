@@ -0,0 +1,28 @@
+#pragma once
+// MCP23017 I2C input expander backend
+// Up to 8 chips x 16 inputs, addressed in SENSORS[] with EY_MCP23017_PIN(chip, pin).
+// SENSORS[] itself holds at most 64 sensors (SensorMask is one 64-bit
+// word), so a prop uses at most 64 of the 128 expander inputs.
+// The input sampler only watches the INT lines; a small read task reads a
+// chip when it pulls INT LOW (one 2-byte burst read of GPIOA/GPIOB, about
+// 0.12 ms of bus time at 400 kHz) and publishes the bank, plus a resync of every chip
+// each 100 ms in case an edge was missed. A slow or stuck bus delays these
+// inputs only, never the sampler.
+// Feature guard: #define HAS_MCP23017 in prop config, with
+//   MCP23017_CHIPS[], MCP23017_COUNT, MCP23017_SDA_PIN, MCP23017_SCL_PIN
+
+#include <Arduino.h>
+
+// Input pollers EY_MCP23017_Begin() registers (EY_Inputs.cpp sizes its table with them)
+#ifdef HAS_MCP23017
+static constexpr uint8_t EY_MCP23017_POLLERS = 1;
+#else
+static constexpr uint8_t EY_MCP23017_POLLERS = 0;
+#endif
+
+// Configure every chip (all pins inputs with pull-ups, interrupt on change)
+// and register with the input sampler. Call before EY_Inputs_Begin().
+void EY_MCP23017_Begin();
+
+// Duration of the last resync (every chip read once), in µs
+uint32_t EY_MCP23017_GetResyncUs();
@@ -0,0 +1,29 @@
+#pragma once
+// Scanned key matrix input backend
+// Up to 8 rows x 8 columns on rows + columns GPIOs, addressed in SENSORS[]
+// with EY_MATRIX_PIN(row, col) and PresentWhen::HIGH_LEVEL (bit set = key down).
+// Scanned from the input sampler: one "any key" read with every row driven
+// LOW, and a full row-by-row scan only while a key is down — an 8x8 grid is
+// fully scanned every sample period (1 ms at INPUT_SAMPLE_HZ = 1000).
+// Feature guard: #define HAS_MATRIX in prop config, with
+//   MATRIX_ROW_PINS[], MATRIX_ROWS   (open-drain outputs, GPIO 0-33)
+//   MATRIX_COL_PINS[], MATRIX_COLS   (inputs, internal or external pull-ups)
+//   optional MATRIX_SETTLE_US  (default 3) — wait after driving a row, raise for long cables
+//   optional MATRIX_HAS_DIODES       — one diode per key: skip ghost-key detection
+
+#include <Arduino.h>
+
+// Input pollers EY_Matrix_Begin() registers (EY_Inputs.cpp sizes its table with them)
+#ifdef HAS_MATRIX
+static constexpr uint8_t EY_MATRIX_POLLERS = 1;
+#else
+static constexpr uint8_t EY_MATRIX_POLLERS = 0;
+#endif
+
+// Configure the row/column pins and register with the input sampler.
+// Call before EY_Inputs_Begin().
+void EY_Matrix_Begin();
+
+// Scans where a ghost (three keys forming a rectangle corner) was detected
+// and the ambiguous keys held at their previous level
+uint32_t EY_Matrix_GhostCount();
@@ -27,10 +27,11 @@ namespace EY_MQTT {
   static constexpr const char* SRC_DEVICE  = "device";
 }
 
-// Callbacks
-typedef void (*ResetCallback)();
-typedef void (*SetSolvedCallback)(bool solved, const char* source);
-typedef void (*ArmCallback)();
+// Callbacks. `group` is the puzzle group a command was addressed to
+// (index in PUZZLE_GROUPS[]), or EY_ALL_GROUPS for the board / broadcast topics.
+typedef void (*ResetCallback)(uint8_t group);
+typedef void (*SetSolvedCallback)(uint8_t group, bool solved, const char* source);
+typedef void (*ArmCallback)(uint8_t group);
 
 // Network lifecycle
 void EY_Net_Begin(ResetCallback onReset, SetSolvedCallback onSetSolved = nullptr, ArmCallback onArm = nullptr);
@@ -41,7 +42,12 @@ bool EY_Mqtt_Connected();
 void EY_PublishEventOk(const char* sensorName);
 void EY_PublishSolved(bool solved);
 
-// New publishing helpers (v2 contract)
+// New publishing helpers (v2 contract). Events without a group are
+// published under puzzle group 0's propId.
 void EY_PublishEvent(const char* action, const char* source);
+void EY_PublishGroupEvent(uint8_t group, const char* action, const char* source);
 void EY_PublishEventWithData(const char* action, const char* source, const char* dataKey, const char* dataValue);
-void EY_PublishStatus(bool solved, const char* lastChangeSource, bool overrideActive);
+void EY_PublishStatus(uint8_t group, bool solved, const char* lastChangeSource, bool overrideActive);
+
+// Diagnostics (not part of the v1 contract): raw JSON payload on <base>/diag
+void EY_PublishDiag(const char* payload, size_t len);
@@ -0,0 +1,50 @@
+#pragma once
+// ESP-NOW wireless sensor nodes
+// Battery nodes (up to 8, 8 input channels each) broadcast their input
+// states over ESP-NOW. Each channel is a virtual pin, EY_NODE_PIN(node,
+// channel), so a SENSORS[] entry on it goes through the same debounce and
+// solve pipeline as a wired input. Channel bits read HIGH when the node
+// reports the input active; a node silent for NODE_TIMEOUT_MS drops to all LOW.
+//
+// Packet (little-endian, packed), 10 + 3 * count bytes:
+//   uint8_t  magic      0xE5
+//   uint8_t  version    1
+//   uint8_t  node       0 .. NODE_COUNT-1
+//   uint8_t  count      change records that follow (0 = heartbeat)
+//   uint16_t seq        packet number, +1 per packet (link statistics)
+//   uint16_t battMv     battery voltage
+//   uint8_t  states     current level of every channel (bit c = channel c)
+//   uint8_t  reserved
+//   { uint16_t changeSeq; uint8_t states; } changes[count]   oldest first
+// A node sends a packet on every input change and a heartbeat every few
+// seconds, repeating its last few changes in each packet: a change lost
+// with one packet is recovered from the next. Changes are applied in
+// changeSeq order, one per input sample, so a short press inside a batch
+// is still seen as press + release.
+//
+// The receive path is lock-free: the WiFi task copies packets into a
+// single-producer/single-consumer ring, drained by the input sampler.
+// Link statistics are published on <base>/diag every NODE_STATS_MS:
+//   {"type":"node_stats","node":0,"online":true,"rx":812,"lost":3,"dup":40,
+//    "recovered":2,"battMv":2950,"lastSeenMs":840}
+// Feature guard: #define HAS_NODES in prop config, with NODE_COUNT (1-8)
+//   optional NODE_TIMEOUT_MS (default 5000), NODE_STATS_MS (default 60000)
+
+#include <Arduino.h>
+
+// Input pollers EY_Nodes_Begin() registers (EY_Inputs.cpp sizes its table with them)
+#ifdef HAS_NODES
+static constexpr uint8_t EY_NODES_POLLERS = 1;
+#else
+static constexpr uint8_t EY_NODES_POLLERS = 0;
+#endif
+
+// Register with the input sampler. Call before EY_Inputs_Begin().
+// ESP-NOW itself starts from EY_Nodes_Tick() once WiFi is connected.
+void EY_Nodes_Begin();
+
+// Deferred ESP-NOW start and periodic link statistics (call every loop)
+void EY_Nodes_Tick();
+
+// Nodes heard from within NODE_TIMEOUT_MS
+uint8_t EY_Nodes_GetOnlineCount();
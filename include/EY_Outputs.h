@@ -1,26 +1,110 @@
 #pragma once
 
-#include "EY_Types.h"  // For OutputDef, OutputPinState
+#include "EY_Types.h"   // For OutputDef, OutputPinState
+#include "EY_Inputs.h"  // For EY_Pin, EY_PinBank, EY_PinBit
 
 // ============================================================
 // Output System API (Maglocks, Relays, etc.)
 // ============================================================
+// Output pins are 16-bit virtual pins like input pins, (bank << 8) | bit,
+// on their own banks:
+//
+//   bank 0                 = ESP32 GPIO 0-33 (a plain GPIO number)
+//   EY_OUT_BANK_HC595      = 74HC595 shift-register chain (8 outputs per chip, 8 chips)
+//   EY_OUT_BANK_PCA9685    = PCA9685 I2C PWM controllers (16 channels per chip, 4 chips)
+//   EY_OUT_BANK_PIXELS     = WS2812 strip pixels 0-63 (on = the pixel's on color)
+//   EY_OUT_BANK_DMX        = DMX512 channels 1-64 (on = DMX_ON_LEVEL)
+//
+// GPIO outputs switch on the spot through the GPIO_OUT_W1TS/W1TC
+// registers. Expander outputs update a shadow of their chain/chips; the
+// backend sends every change made since its last refresh in one bus
+// transaction or strip frame, from the shared timer service (EY_Timer.h) —
+// so a group release, a Simon frame or a pattern edge costs one transfer
+// however many lamps and relays it touches.
+
+// ---- Banks ----
+static const uint8_t EY_OUT_BANK_GPIO    = 0;
+static const uint8_t EY_OUT_BANK_HC595   = 1;
+static const uint8_t EY_OUT_BANK_PCA9685 = 2;
+static const uint8_t EY_OUT_BANK_PIXELS  = 3;
+static const uint8_t EY_OUT_BANK_DMX     = 4;
+static const uint8_t EY_OUTPUT_BANKS     = 5;
+
+// Output `output` (0-7 = QA-QH) of 74HC595 chip `chip` (0 = nearest the ESP32)
+constexpr uint16_t EY_HC595_PIN(uint8_t chip, uint8_t output) {
+  return EY_Pin(EY_OUT_BANK_HC595, (uint8_t)(chip * 8 + output));
+}
+
+// Channel `channel` (0-15) of PCA9685 chip `chip` (index in PCA9685_ADDRS[])
+constexpr uint16_t EY_PCA9685_PIN(uint8_t chip, uint8_t channel) {
+  return EY_Pin(EY_OUT_BANK_PCA9685, (uint8_t)(chip * 16 + channel));
+}
+
+// Pixel `index` (0-63) of the WS2812 strip (EY_Pixels.h)
+constexpr uint16_t EY_PIXEL_PIN(uint8_t index) {
+  return EY_Pin(EY_OUT_BANK_PIXELS, index);
+}
+
+// DMX512 channel `channel` (1-64) of the universe (EY_DMX.h)
+constexpr uint16_t EY_DMX_PIN(uint8_t channel) {
+  return EY_Pin(EY_OUT_BANK_DMX, (uint8_t)(channel - 1));
+}
+
+// ---- Raw pins (module LEDs, pucks...) ----
+
+// Configure an output pin and drive it to `high` (pinMode on GPIO)
+void EY_Outputs_BeginPin(uint16_t pin, bool high);
+
+// digitalWrite() for virtual output pins
+void EY_Outputs_WritePin(uint16_t pin, bool high);
+
+// ---- OUTPUTS[] ----
 
 // Initialize all output pins (call once in setup)
 // Sets all pins to INACTIVE (fail-safe: maglock unlocked)
 void EY_Outputs_Begin();
 
-// Activate all outputs (lock maglocks) — called on GM "arm" command
-void EY_Outputs_Arm();
+// The functions below act on the outputs of one puzzle group
+// (OutputDef::group), or on every output with EY_ALL_GROUPS. The group's
+// pins switch together — one GPIO_OUT_W1TS/W1TC register write per level
+// and one transaction per expander, from masks built in EY_Outputs_Begin —
+// and are logged afterwards.
+
+// Activate outputs (lock maglocks) — called on GM "arm" command
+void EY_Outputs_Arm(uint8_t group);
+
+// Deactivate outputs (unlock maglocks) — called on solve/force_solve
+void EY_Outputs_Release(uint8_t group);
+
+// Re-arm outputs (re-lock maglocks) — called on reset
+void EY_Outputs_Reset(uint8_t group);
 
-// Deactivate all outputs (unlock maglocks) — called on solve/force_solve
-void EY_Outputs_Release();
+// ---- Per-output control (MQTT set_output with an outputId) ----
+// One output at a time, by index in OUTPUTS[]. Pulse and pattern edges
+// run on the shared timer service (EY_Timer.h), independent of loop() and
+// the network. Any new command on an output, and Arm/Release/Reset of its
+// group, replaces its pulse or pattern.
 
-// Re-arm all outputs (re-lock maglocks) — called on reset
-void EY_Outputs_Reset();
+// Index of the output `outputId` in `group` (or any group with
+// EY_ALL_GROUPS), -1 if none
+int8_t EY_Outputs_Find(uint8_t group, const char* outputId);
 
-// Get individual output state
+// Drive one output active (on) or inactive (off)
+void EY_Outputs_Set(uint8_t index, bool active);
+
+// Active for `ms`, then inactive (solenoids, door strikes)
+void EY_Outputs_Pulse(uint8_t index, uint32_t ms);
+
+// `count` cycles of `onMs` active then `offMs` inactive, ending inactive
+// (0 = repeat until the next command or reset)
+void EY_Outputs_Pattern(uint8_t index, uint32_t onMs, uint32_t offMs, uint16_t count);
+
+// Get individual output state (ARMED = active, RELEASED = inactive)
 OutputPinState EY_Outputs_GetState(uint8_t index);
 
 // Get output count
 uint8_t EY_Outputs_GetCount();
+
+// esp_timer µs when a group's outputs were released, 0 if they have not
+// been released since the last arm/reset (or the group has no outputs)
+uint64_t EY_Outputs_GetReleasedAtUs(uint8_t group);
@@ -0,0 +1,39 @@
+#pragma once
+// PCA9685 I2C PWM output backend
+// Up to 4 chips x 16 channels, addressed in OUTPUTS[] (or with
+// EY_Outputs_WritePin) as EY_PCA9685_PIN(chip, channel). On/off writes use
+// the chip's full-on / full-off bits; modules can also dim a channel with
+// EY_PCA9685_SetDuty. Changes update a shadow; each chip's changed
+// channels are then sent in one auto-increment I2C write from a small
+// refresh task, so a whole frame of lamps costs one transaction per chip
+// and a slow bus never holds up the timer service (EY_Timer.h).
+// Feature guard: #define HAS_PCA9685 in prop config, with
+//   PCA9685_ADDRS[] (0x40-0x7F), PCA9685_COUNT, PCA9685_SDA_PIN, PCA9685_SCL_PIN
+//   optional PCA9685_PWM_HZ     (default 1000, 24-1526)
+//   optional PCA9685_OPEN_DRAIN (outputs open-drain instead of totem-pole)
+// With HAS_MCP23017 the chips share its I2C bus (same SDA/SCL pins).
+
+#include <Arduino.h>
+
+#ifndef PCA9685_PWM_HZ
+  #define PCA9685_PWM_HZ 1000  // Also read by EY_Servo (servos need 50)
+#endif
+
+// Full-on duty for EY_PCA9685_SetDuty (4095 is the longest real PWM pulse)
+static const uint16_t EY_PCA9685_FULL_ON = 4096;
+
+// Configure every chip (all channels off). Call before EY_Outputs_Begin().
+void EY_PCA9685_Begin();
+
+// Turn channels fully on (set) or off (clear), bit chip * 16 + channel.
+// Safe from any task, also inside a critical section. Returns true if a
+// channel changed and needs a refresh.
+bool EY_PCA9685_Write(uint64_t set, uint64_t clear);
+
+// Dim one channel (chip * 16 + channel): 0 = off .. EY_PCA9685_FULL_ON.
+// Refreshes on its own.
+void EY_PCA9685_SetDuty(uint8_t channel, uint16_t duty);
+
+// Send changed channels as soon as possible (from the refresh task).
+// Safe from any task, not from interrupts or inside a critical section.
+void EY_PCA9685_Refresh();
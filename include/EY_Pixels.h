@@ -0,0 +1,66 @@
+#pragma once
+// WS2812 addressable LED strip backend (RMT)
+// One strip of PIXELS_COUNT LEDs on one RMT channel. Frames are
+// double-buffered: modules draw colors into a back buffer at any time, and
+// the timer service (EY_Timer.h) encodes the changed pixels into the RMT
+// item buffer and starts the transfer once the previous frame has finished
+// and latched. The RMT peripheral then clocks the whole frame out on its
+// own, so WiFi interrupts cannot stretch a bit. A refresh only sends the
+// strip up to the last changed pixel; the pixels after it keep their colors.
+//
+// The first 64 pixels are also output pins, EY_PIXEL_PIN(index) in
+// OUTPUTS[] or with EY_Outputs_WritePin: on shows the pixel's on color
+// (EY_Pixels_SetOnColor, default PIXELS_ON_COLOR), off is black.
+//
+// Feature guard: #define HAS_PIXELS in prop config, with
+//   PIXELS_PIN, PIXELS_COUNT (1-512)
+//   optional PIXELS_ON_COLOR       (default EY_RGB(255, 255, 255))
+//   optional PIXELS_BRIGHTNESS     (0-255 scale applied to every pixel, default 255)
+//   optional PIXELS_RMT_CHANNEL    (default 0)
+//   optional PIXELS_RMT_MEM_BLOCKS (RMT RAM blocks of 64 items, default 4:
+//                                   fewer refill interrupts per frame)
+
+#include <Arduino.h>
+
+#ifndef PIXELS_RMT_CHANNEL
+  #define PIXELS_RMT_CHANNEL 0
+#endif
+#ifndef PIXELS_RMT_MEM_BLOCKS
+  #define PIXELS_RMT_MEM_BLOCKS 4  // Also read by EY_Stepper (its channels come next)
+#endif
+
+// 0xRRGGBB
+constexpr uint32_t EY_RGB(uint8_t r, uint8_t g, uint8_t b) {
+  return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+}
+
+// Set up the RMT channel and clear the strip. Call before EY_Outputs_Begin().
+void EY_Pixels_Begin();
+
+// ---- Drawing (any task; the strip refreshes on its own) ----
+
+void EY_Pixels_Set(uint16_t index, uint32_t color);
+void EY_Pixels_Fill(uint16_t first, uint16_t count, uint32_t color);
+uint32_t EY_Pixels_Get(uint16_t index);
+
+// Color shown by a pixel pin when it is on
+void EY_Pixels_SetOnColor(uint16_t first, uint16_t count, uint32_t color);
+
+// ---- Effects (stepped at 50 Hz by the timer service) ----
+// A new Set/Fill/Fade/Pulse on a pixel replaces its running effect.
+
+// Cross-fade from the current colors to `color` over `ms`
+void EY_Pixels_Fade(uint16_t first, uint16_t count, uint32_t color, uint32_t ms);
+
+// Flash `color`, then fade back to the current colors over `ms`
+void EY_Pixels_Pulse(uint16_t first, uint16_t count, uint32_t color, uint32_t ms);
+
+// ---- Output pins (used by EY_Outputs) ----
+
+// Switch pixels 0-63 to their on color (set) or black (clear).
+// Safe from any task, also inside a critical section. Returns true if a
+// pixel changed and needs a refresh.
+bool EY_Pixels_Write(uint64_t set, uint64_t clear);
+
+// Send the changed pixels as soon as the strip is free (from the timer task)
+void EY_Pixels_Refresh();
@@ -0,0 +1,34 @@
+#pragma once
+// MFRC522 RFID readers on one SPI bus
+// Only the MFRC522 is supported: PN532 readers (and other NFC front ends)
+// are not, on SPI or I2C.
+// Up to 16 readers share SCK/MISO/MOSI, each with its own chip select, and
+// are polled round-robin by a background task: WUPA, anticollision and
+// select (4- or 7-byte UIDs), then HLTA so the tag answers the next WUPA.
+// Each read is checked against the reader's allow-list in RFID_READERS[].
+// Results are published as input bank bits, so readers feed the solve modes
+// like any other sensor:
+//   EY_RFID_READER(r)   — reader r holds an allowed tag
+//   EY_RFID_ANY_TAG(r)  — reader r holds any tag (e.g. a "wrong tag" decorative)
+// Every newly seen tag publishes a "rfid_tag" event with "uid": "<reader id>:<UID hex>".
+// Feature guard: #define HAS_RFID in prop config, with
+//   RFID_READERS[], RFID_READER_COUNT, RFID_SCK_PIN, RFID_MISO_PIN, RFID_MOSI_PIN
+//   optional RFID_SPI_HZ (default 4 MHz)
+//   optional RFID_ROUND_BUDGET_MS (default 50): longest acceptable polling
+//     round over all readers. Slower rounds are logged by EY_RFID_Tick(), and
+//     the status reports the longest round ("rfidRoundMaxMs").
+
+#include <Arduino.h>
+
+// Reset and configure every reader, then start the polling task.
+// Call before EY_Inputs_Begin().
+void EY_RFID_Begin();
+
+// Publish UIDs read since the last call (call every loop)
+void EY_RFID_Tick();
+
+// Duration of the last full polling round over all readers, in µs
+uint32_t EY_RFID_GetRoundUs();
+
+// Longest polling round since the last call, in µs (status reports)
+uint32_t EY_RFID_TakeRoundMaxUs();
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ============================================================
+// Rhythm matching (SolveMode::RHYTHM)
+// ============================================================
+// A RHYTHM group is solved when its non-decorative sensors (any of them,
+// e.g. a knock sensor or a few pads) are pressed in the prop's rhythm:
+//
+//   static constexpr SolveMode SOLVE_MODE = SolveMode::RHYTHM;
+//   #define RHYTHM_PATTERN EY_RHYTHM(2, 1, 1, 2)   // 5 knocks: long, short, short, long
+//
+// The numbers are the gaps between consecutive presses, in any unit: only
+// their ratios matter. A press is timed at its first raw edge as stamped
+// by the input sampler (µs, see EY_Inputs.h), not when loop() sees it.
+//
+// Matching is tempo-normalized: the presses so far set the tempo (their
+// total time over the pattern units they cover) and every gap must be
+// within RHYTHM_TOLERANCE_PCT of its expected length at that tempo. A gap
+// that breaks the rhythm keeps the longest run of recent presses that
+// still fits the start of the pattern; a pause longer than
+// RHYTHM_TIMEOUT_MS starts over.
+//
+// Live progress (% of presses matched) and quality (100 - worst gap
+// error, %) are reported in the group's status.
+
+static const uint8_t EY_RHYTHM_MAX_GAPS = 15;
+
+struct EY_RhythmPattern {
+  uint16_t gaps[EY_RHYTHM_MAX_GAPS];
+  uint8_t gapCount;  // Presses - 1 (0 = no pattern declared)
+};
+
+// Gaps as written in EY_RHYTHM(...) (unused slots stay 0)
+struct EY_RhythmGaps {
+  uint16_t gaps[EY_RHYTHM_MAX_GAPS];
+};
+
+constexpr EY_RhythmPattern EY_Rhythm_Build(const EY_RhythmGaps& in) {
+  EY_RhythmPattern pattern{};
+  for (uint8_t j = 0; j < EY_RHYTHM_MAX_GAPS && in.gaps[j] > 0; j++) {
+    pattern.gaps[pattern.gapCount++] = in.gaps[j];
+  }
+  return pattern;
+}
+
+// Declare the rhythm of the current prop's RHYTHM group(s)
+#define EY_RHYTHM(...) EY_Rhythm_Build(EY_RhythmGaps{ { __VA_ARGS__ } })
+
+// ---- Runtime (driven by EY_Sensors) ----
+
+// Forget a group's presses (prop/group reset)
+void EY_Rhythm_Reset(uint8_t group);
+
+// A press of one of the group's sensors at `timeUs` (esp_timer µs).
+// Returns true once the whole rhythm has been matched.
+bool EY_Rhythm_Press(uint8_t group, uint64_t timeUs);
+
+// GM force-trigger: one more press, placed at `timeUs` exactly on the
+// rhythm, so one force per press solves the group. Returns true once solved.
+bool EY_Rhythm_ForcePress(uint8_t group, uint64_t timeUs);
+
+bool EY_Rhythm_IsSolved(uint8_t group);
+
+// Presses of the current attempt that fit the rhythm, 0-100 %
+uint8_t EY_Rhythm_GetProgress(uint8_t group);
+
+// 100 - worst gap error of the current attempt, 0-100 %
+uint8_t EY_Rhythm_GetQuality(uint8_t group);
@@ -1,40 +1,85 @@
 #pragma once
 
-#include "EY_Types.h"  // For SensorDef, SensorState, PresentWhen, SolveMode
+#include "EY_Types.h"   // For SensorDef, SensorState, PresentWhen, SolveMode
+#include "EY_Inputs.h"  // For EY_Pin, EY_BANK_ANALOG
 
 // ============================================================
 // Sensor System API
 // ============================================================
 
+// Input-frame pin a sensor reads: its GPIO / virtual pin, or for analog
+// (ABOVE/BELOW) and TOUCH sensors its GPIO's bit in the backend's bank
+constexpr uint16_t EY_Sensors_InputPin(const SensorDef& def) {
+  return EY_IsAnalog(def.presentWhen) ? EY_Pin(EY_BANK_ANALOG, (uint8_t)def.pin)
+       : (def.presentWhen == PresentWhen::TOUCH) ? EY_Pin(EY_BANK_TOUCH, (uint8_t)def.pin)
+       : def.pin;
+}
+
+// True if a sensor is present when its input pin reads LOW
+constexpr bool EY_Sensors_ActiveLow(const SensorDef& def) {
+  return def.presentWhen == PresentWhen::LOW_LEVEL || def.presentWhen == PresentWhen::BELOW;
+}
+
 // Initialize all sensors (call once in setup)
 void EY_Sensors_Begin();
 
-// Poll all sensors, publish events on transitions, return true if solve condition met
+// Poll all sensors, publish events on transitions and update each puzzle
+// group's solve condition (read it with EY_Sensors_IsSolved).
 // Call every loop iteration (non-blocking)
-bool EY_Sensors_Tick();
+void EY_Sensors_Tick();
 
-// Reset all sensor states (call on prop reset)
+// Reset all sensor states and re-seed debouncing (call on prop reset)
 void EY_Sensors_Reset();
 
-// Check if solve condition is currently met (without side effects)
-bool EY_Sensors_IsSolved();
+// Skip every input change since the last EY_Sensors_Tick(): the next tick
+// starts from the current levels, as after a reset, without clearing any
+// game state. Call when loop() resumes ticking after ignoring sensors, so
+// presses made in between do not count.
+void EY_Sensors_Resync();
+
+// Reset the sensors of one puzzle group (GM reset of that group only)
+void EY_Sensors_ResetGroup(uint8_t group);
+
+// Check if a group's solve condition is currently met (without side effects).
+// Cached: only recomputed when one of its sensors changes state.
+bool EY_Sensors_IsSolved(uint8_t group);
+
+// Called the moment a group's solve condition becomes true — inside
+// EY_Sensors_Tick() or EY_Sensors_ForceTrigger(), before the change that
+// solved it is logged or published. Keep it to actuation (outputs);
+// report from loop().
+typedef void (*SensorsSolvedCallback)(uint8_t group);
+void EY_Sensors_OnSolved(SensorsSolvedCallback cb);
 
-// Get individual sensor state (for debugging/status)
-const SensorState* EY_Sensors_GetState(uint8_t index);
+// Sample time (esp_timer µs) of the accepted input change that solved a
+// group, 0 if it has not been solved since the last reset
+uint64_t EY_Sensors_GetSolvedAtUs(uint8_t group);
+
+// Sensors of a puzzle group (bit i = SENSORS[i])
+SensorMask EY_Sensors_GetGroupMask(uint8_t group);
+
+// Get packed state of all sensors (for debugging/status); bit i = SENSORS[i]
+const SensorState& EY_Sensors_GetState();
+
+// Number of sensors currently present (after debounce)
+uint8_t EY_Sensors_GetPresentCount();
 
 // Get sensor count
 uint8_t EY_Sensors_GetCount();
 
-// Force-trigger a sensor remotely (for GM override)
+// Force-trigger a sensor of `group` (or EY_ALL_GROUPS) remotely (for GM override)
 // Returns true if sensor found and triggered
-bool EY_Sensors_ForceTrigger(const char* sensorId);
+bool EY_Sensors_ForceTrigger(uint8_t group, const char* sensorId);
+
+// SEQUENCE mode: how many sequence steps of a group have been completed
+// so far. Returns 0 in other solve modes.
+uint8_t EY_Sensors_GetSequenceIndex(uint8_t group);
 
-// SEQUENCE mode: how many sequence steps have been completed so far.
-// Returns 0 in other solve modes. Used by status publisher to mark
-// completed steps as "triggered" for the GM dashboard.
-uint8_t EY_Sensors_GetSequenceIndex();
+// SEQUENCE mode: sensors whose step is completed. Used by status publisher
+// to mark them as "triggered" for the GM dashboard.
+SensorMask EY_Sensors_GetSequenceDone(uint8_t group);
 
-// True if the most recent EY_Sensors_Tick() saw at least one sensor change
-// present-state (press or release). Used by main.cpp to republish status
-// so the GM dashboard sees per-sensor triggers in real time.
-bool EY_Sensors_StateChangedThisTick();
+// True if the most recent EY_Sensors_Tick() saw at least one sensor of the
+// group change present-state (press or release). Used by main.cpp to
+// republish status so the GM dashboard sees per-sensor triggers in real time.
+bool EY_Sensors_StateChangedThisTick(uint8_t group);
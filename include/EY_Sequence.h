@@ -0,0 +1,125 @@
+#pragma once
+
+#include "EY_Types.h"      // For SensorDef, SensorMask
+#include "EY_SolveExpr.h"  // For EY_Solve_IdEquals
+
+// ============================================================
+// Compile-time sequence automata (SolveMode::SEQUENCE)
+// ============================================================
+// By default a SEQUENCE puzzle expects each non-decorative sensor of its
+// group once, in declaration order. A prop can instead declare the exact
+// press pattern, with repeats and up to EY_SEQ_MAX_LEN presses:
+//
+//   static constexpr SolveMode SOLVE_MODE = SolveMode::SEQUENCE;
+//   #define SEQUENCE_PATTERN EY_SEQUENCE("red", "blue", "red", "red", "green")
+//
+// Either way the pattern is folded at compile time into a KMP automaton:
+// one row per prefix matched so far, one column per distinct sensor in the
+// pattern. A press is a single table lookup. A wrong press falls back to
+// the longest prefix of the pattern that the recent presses still match
+// (after "red blue red", a "blue" keeps "red blue") instead of restarting
+// from zero. Other sensors of the group restart the pattern; decorative
+// sensors stay decoys.
+//
+// The pattern's sensors must be non-decorative and belong to a single
+// SEQUENCE group (checked in EY_Sensors.cpp). An unknown id or more than
+// EY_SEQ_MAX_SYMBOLS distinct sensors fails constant evaluation, naming
+// one of the functions below in the diagnostic.
+
+static const uint8_t EY_SEQ_MAX_LEN     = 32;    // Presses per pattern
+static const uint8_t EY_SEQ_MAX_SYMBOLS = 32;    // Distinct sensors per pattern
+static const uint8_t EY_SEQ_NONE        = 0xFF;  // Sensor not in the pattern
+
+// Deliberately not constexpr: reaching one of these while folding a
+// SEQUENCE_PATTERN makes the compiler reject it.
+inline uint8_t EY_Seq_UnknownSensorId() { return EY_SEQ_NONE; }
+inline void EY_Seq_TooManySensors() {}
+
+// Sensor ids as written in EY_SEQUENCE(...) (unused slots stay nullptr)
+struct EY_SeqIds {
+  const char* ids[EY_SEQ_MAX_LEN];
+};
+
+// Pattern as sensor indices (bit i = SENSORS[i])
+struct EY_SeqPattern {
+  uint8_t sensors[EY_SEQ_MAX_LEN];
+  uint8_t length;  // 0 = no pattern declared
+};
+
+struct EY_SeqDfa {
+  uint8_t length;                                   // Presses to solve (0 = never solved)
+  uint8_t steps[EY_SEQ_MAX_LEN];                    // Sensor index of each press
+  uint8_t symbol[64];                               // Sensor index -> column, or EY_SEQ_NONE
+  uint8_t next[EY_SEQ_MAX_LEN + 1][EY_SEQ_MAX_SYMBOLS];  // [presses matched][column]
+
+  // Presses matched after `sensor` is pressed with `state` matched
+  constexpr uint8_t advance(uint8_t state, uint8_t sensor) const {
+    uint8_t column = (sensor < 64) ? symbol[sensor] : EY_SEQ_NONE;
+    return (column == EY_SEQ_NONE) ? 0 : next[state][column];
+  }
+};
+
+// Build the KMP automaton of a pattern. The accepting row is absorbing:
+// a solved sequence stays solved until reset.
+constexpr EY_SeqDfa EY_Seq_Compile(const EY_SeqPattern& pattern) {
+  EY_SeqDfa dfa{};
+  for (uint8_t s = 0; s < 64; s++) dfa.symbol[s] = EY_SEQ_NONE;
+  dfa.length = pattern.length;
+  if (dfa.length == 0) return dfa;
+
+  uint8_t symbolCount = 0;
+  for (uint8_t j = 0; j < dfa.length; j++) {
+    uint8_t sensor = pattern.sensors[j];
+    if (dfa.symbol[sensor] == EY_SEQ_NONE) {
+      if (symbolCount >= EY_SEQ_MAX_SYMBOLS) {
+        EY_Seq_TooManySensors();
+        return dfa;
+      }
+      dfa.symbol[sensor] = symbolCount++;
+    }
+    dfa.steps[j] = sensor;
+  }
+
+  // Row j copies the row of the longest proper border x of the first j
+  // presses, then the matching press advances to j + 1
+  dfa.next[0][dfa.symbol[dfa.steps[0]]] = 1;
+  uint8_t x = 0;
+  for (uint8_t j = 1; j < dfa.length; j++) {
+    for (uint8_t c = 0; c < symbolCount; c++) dfa.next[j][c] = dfa.next[x][c];
+    uint8_t column = dfa.symbol[dfa.steps[j]];
+    dfa.next[j][column] = (uint8_t)(j + 1);
+    x = dfa.next[x][column];
+  }
+  for (uint8_t c = 0; c < symbolCount; c++) dfa.next[dfa.length][c] = dfa.length;
+  return dfa;
+}
+
+// Default pattern: every sensor of a mask once, in declaration order
+constexpr EY_SeqPattern EY_Seq_FromMask(SensorMask mask) {
+  EY_SeqPattern pattern{};
+  for (uint8_t i = 0; i < 64 && pattern.length < EY_SEQ_MAX_LEN; i++) {
+    if (mask & EY_SensorBit(i)) pattern.sensors[pattern.length++] = i;
+  }
+  return pattern;
+}
+
+// Pattern of sensor ids, looked up in a sensor table
+template <size_t N>
+constexpr EY_SeqPattern EY_Seq_Pattern(const SensorDef (&defs)[N], uint8_t count, const EY_SeqIds& ids) {
+  EY_SeqPattern pattern{};
+  for (uint8_t j = 0; j < EY_SEQ_MAX_LEN && ids.ids[j]; j++) {
+    uint8_t sensor = EY_SEQ_NONE;
+    for (uint8_t i = 0; i < count && i < N; i++) {
+      if (EY_Solve_IdEquals(defs[i].id, ids.ids[j])) {
+        sensor = i;
+        break;
+      }
+    }
+    if (sensor == EY_SEQ_NONE) sensor = EY_Seq_UnknownSensorId();
+    pattern.sensors[pattern.length++] = sensor;
+  }
+  return pattern;
+}
+
+// Declare the press pattern of the current prop's SEQUENCE group
+#define EY_SEQUENCE(...) EY_Seq_Pattern(SENSORS, SENSOR_COUNT, EY_SeqIds{ { __VA_ARGS__ } })
@@ -0,0 +1,41 @@
+#pragma once
+// Servo motion-profile engine
+// Any number of hobby servos (SERVOS[]), each following its own motion
+// profile: a move goes from the current angle to a target over a duration,
+// shaped by a ServoProfile. The shared timer service (EY_Timer.h) advances
+// every running move at the 50 Hz servo frame rate, so motion stays smooth
+// whatever loop() or the network is doing, and nothing here blocks.
+// GPIO servos get one LEDC channel each (16 at most); servos on PCA9685
+// channels (EY_PCA9685_PIN) need PCA9685_PWM_HZ 50.
+// Feature guard: #define HAS_SERVO in prop config, with
+//   SERVOS[], SERVO_COUNT
+//   optional SERVO_MOVE_MS        solve/reset move duration (default 0 = as fast as the servo goes)
+//   optional SERVO_PROFILE        solve/reset ServoProfile (default ServoProfile::EASE)
+//   optional SERVO_BOOT_SWEEP_MS  on boot, go to openAngle and back, this long each way
+//                                 (wiring check, runs in the background)
+
+#include "EY_Types.h"  // For ServoDef, ServoProfile
+
+// Set up the channels and park every servo at its closedAngle.
+// Call after EY_PCA9685_Begin() when servos use its channels.
+void EY_Servo_Begin();
+
+// Move to `angle` (0-180) over `ms`, replacing the current move
+void EY_Servo_Move(uint8_t index, float angle, uint32_t ms, ServoProfile profile);
+
+// Move to `angle` over `ms` once the current move has finished
+// (one queued move per servo; a newer one replaces it)
+void EY_Servo_Queue(uint8_t index, float angle, uint32_t ms, ServoProfile profile);
+
+// Every servo of `group` (or all with EY_ALL_GROUPS) to its openAngle /
+// closedAngle, over SERVO_MOVE_MS
+void EY_Servo_Open(uint8_t group);
+void EY_Servo_Close(uint8_t group);
+
+// Index of the servo `id` in `group` (or any group with EY_ALL_GROUPS), -1 if none
+int8_t EY_Servo_Find(uint8_t group, const char* id);
+
+// Angle currently commanded (follows the profile while moving)
+float EY_Servo_GetAngle(uint8_t index);
+
+bool EY_Servo_IsMoving(uint8_t index);
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "EY_Types.h"  // For SensorDef, SensorMask, EY_SensorBit
+
+// ============================================================
+// Compile-time solve expressions (SolveMode::CUSTOM)
+// ============================================================
+// Lets a prop header describe its solve logic in terms of sensor IDs:
+//
+//   static constexpr SolveMode SOLVE_MODE = SolveMode::CUSTOM;
+//   #define SOLVE_EXPR ((EY_SENSOR("star1") && EY_SENSOR("star2")) || (EY_SENSOR("star3") && !EY_SENSOR("decoy")))
+//
+// The expression is folded at compile time into disjunctive normal form:
+// a list of terms, each a pair of masks over the sensor bitset. It is
+// true when any term has all of its `pos` sensors present and none of
+// its `neg` sensors present. Nothing is parsed or dispatched at runtime —
+// evaluation is a few AND/compare operations per term.
+//
+// Presence is the same "effective" presence ANY/ALL use (latched state
+// for latching sensors). Decorative sensors may be referenced explicitly.
+//
+// Errors surface at compile time: an ID not found in SENSORS[] or an
+// expression that expands past EY_SOLVE_MAX_TERMS fails constant
+// evaluation, naming one of the functions below in the diagnostic.
+
+static const uint8_t EY_SOLVE_MAX_TERMS = 16;
+
+// Deliberately not constexpr: reaching one of these while folding a
+// SOLVE_EXPR makes the compiler reject the expression.
+inline SensorMask EY_Solve_UnknownSensorId() { return 0; }
+inline void EY_Solve_TooManyTerms() {}
+
+// All `pos` sensors present and no `neg` sensor present
+struct EY_SolveTerm {
+  SensorMask pos;
+  SensorMask neg;
+};
+
+struct EY_SolveExpr {
+  EY_SolveTerm terms[EY_SOLVE_MAX_TERMS];
+  uint8_t termCount;  // 0 terms = never true
+
+  constexpr EY_SolveExpr() : terms{}, termCount(0) {}
+
+  constexpr bool eval(SensorMask present) const {
+    for (uint8_t i = 0; i < termCount; i++) {
+      if ((present & terms[i].pos) == terms[i].pos && (present & terms[i].neg) == 0) return true;
+    }
+    return false;
+  }
+};
+
+constexpr EY_SolveExpr EY_Solve_AddTerm(EY_SolveExpr expr, EY_SolveTerm term) {
+  if (term.pos & term.neg) return expr;  // "X and not X" can never be true
+  if (expr.termCount >= EY_SOLVE_MAX_TERMS) {
+    EY_Solve_TooManyTerms();
+    return expr;
+  }
+  expr.terms[expr.termCount++] = term;
+  return expr;
+}
+
+// Expression that is always true (single empty term)
+constexpr EY_SolveExpr EY_Solve_True() {
+  return EY_Solve_AddTerm(EY_SolveExpr(), EY_SolveTerm{0, 0});
+}
+
+constexpr EY_SolveExpr operator||(const EY_SolveExpr& a, const EY_SolveExpr& b) {
+  EY_SolveExpr result = a;
+  for (uint8_t i = 0; i < b.termCount; i++) result = EY_Solve_AddTerm(result, b.terms[i]);
+  return result;
+}
+
+constexpr EY_SolveExpr operator&&(const EY_SolveExpr& a, const EY_SolveExpr& b) {
+  EY_SolveExpr result;
+  for (uint8_t i = 0; i < a.termCount; i++) {
+    for (uint8_t j = 0; j < b.termCount; j++) {
+      result = EY_Solve_AddTerm(result, EY_SolveTerm{a.terms[i].pos | b.terms[j].pos,
+                                                     a.terms[i].neg | b.terms[j].neg});
+    }
+  }
+  return result;
+}
+
+// De Morgan: !(t1 || t2) = !t1 && !t2, and each !t is an OR of negated literals
+constexpr EY_SolveExpr operator!(const EY_SolveExpr& a) {
+  EY_SolveExpr result = EY_Solve_True();
+  for (uint8_t i = 0; i < a.termCount; i++) {
+    EY_SolveExpr notTerm;
+    for (uint8_t bit = 0; bit < 64; bit++) {
+      SensorMask m = EY_SensorBit(bit);
+      if (a.terms[i].pos & m) notTerm = EY_Solve_AddTerm(notTerm, EY_SolveTerm{0, m});
+      if (a.terms[i].neg & m) notTerm = EY_Solve_AddTerm(notTerm, EY_SolveTerm{m, 0});
+    }
+    result = result && notTerm;
+  }
+  return result;
+}
+
+constexpr bool EY_Solve_IdEquals(const char* a, const char* b) {
+  while (*a && *a == *b) { a++; b++; }
+  return *a == *b;
+}
+
+// Single-sensor expression, looked up by id in a sensor table
+template <size_t N>
+constexpr EY_SolveExpr EY_Solve_Sensor(const SensorDef (&defs)[N], uint8_t count, const char* id) {
+  for (uint8_t i = 0; i < count && i < N; i++) {
+    if (EY_Solve_IdEquals(defs[i].id, id)) {
+      return EY_Solve_AddTerm(EY_SolveExpr(), EY_SolveTerm{EY_SensorBit(i), 0});
+    }
+  }
+  return EY_Solve_AddTerm(EY_SolveExpr(), EY_SolveTerm{EY_Solve_UnknownSensorId(), 0});
+}
+
+// Reference a sensor of the current prop by id inside SOLVE_EXPR
+#define EY_SENSOR(id) EY_Solve_Sensor(SENSORS, SENSOR_COUNT, id)
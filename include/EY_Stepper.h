@@ -0,0 +1,61 @@
+#pragma once
+// Stepper motors on STEP/DIR drivers (A4988, DRV8825, TMC2209...)
+// Step pulses come from the RMT peripheral, one RMT channel per motor: the
+// RMT interrupt refills its memory with the next steps of the move, each
+// with its own period from an acceleration ramp (trapezoidal: accelerate
+// at `accel` up to `maxSpeed`, cruise, decelerate to a stop on target).
+// Pulse timing is hardware-clocked, so WiFi and MQTT traffic cannot add
+// jitter. The position is tracked in steps from home.
+//
+// Homing seeks the limit switch in short bursts at `homeSpeed`, checking
+// it between bursts. The switch is a SENSORS[] entry (usually decorative),
+// read from the fixed-rate input sampler like every other sensor, so it can
+// live on any input bank. Once the switch trips, the motor backs off
+// STEPPER_HOME_BACKOFF steps: that is position 0. A move that hits the
+// switch outside homing stops at once (within ~64 steps of RMT buffering)
+// and marks the motor unhomed.
+//
+// Feature guard: #define HAS_STEPPER in prop config, with
+//   STEPPERS[], STEPPER_COUNT
+//   optional STEPPER_PULSE_US       STEP high time (default 5 µs)
+//   optional STEPPER_HOME_BACKOFF   steps away from the switch after homing (default 50)
+//   optional STEPPER_HOME_MAX_STEPS give up homing after this many steps (default 100000)
+//   optional STEPPER_HOME_ON_BOOT   home every motor with a switch at boot
+//   optional STEPPER_RMT_CHANNEL    first RMT channel (default 0, after the pixels' with HAS_PIXELS)
+// Flash writes (OTA) stall the refill interrupt: main stops every motor
+// with EY_Stepper_StopAll() before an OTA update starts.
+
+#include "EY_Types.h"  // For StepperDef
+
+// Set up the drivers and RMT channels (motors enabled, position unknown).
+// Call after EY_Inputs_Begin().
+void EY_Stepper_Begin();
+
+// Print what the motors' timer task logged (homing, errors). Call every loop.
+void EY_Stepper_Tick();
+
+// Move to `position` (steps from home) at up to `speed` steps/s
+// (0 = maxSpeed). A moving motor first decelerates to a stop. An unhomed
+// motor with a home switch homes first.
+void EY_Stepper_MoveTo(uint8_t index, int32_t position, uint16_t speed);
+
+// Seek the home switch, then back off to position 0
+void EY_Stepper_Home(uint8_t index);
+
+// Decelerate to a stop (drops a pending move)
+void EY_Stepper_Stop(uint8_t index);
+
+// Stop every motor and wait until none is moving, up to `timeoutMs`.
+// Returns false on timeout. Loop task only.
+bool EY_Stepper_StopAll(uint32_t timeoutMs);
+
+// Every motor of `group` (or all with EY_ALL_GROUPS) to its openPosition / to 0
+void EY_Stepper_Open(uint8_t group);
+void EY_Stepper_Close(uint8_t group);
+
+// Index of the motor `id` in `group` (or any group with EY_ALL_GROUPS), -1 if none
+int8_t EY_Stepper_Find(uint8_t group, const char* id);
+
+int32_t EY_Stepper_GetPosition(uint8_t index);
+bool EY_Stepper_IsMoving(uint8_t index);
+bool EY_Stepper_IsHomed(uint8_t index);
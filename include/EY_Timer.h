@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ============================================================
+// Shared Timer Service
+// ============================================================
+// Deadlines for every module's timed actions (output pulses and patterns,
+// ...) run on a single one-shot esp_timer, re-armed for the earliest
+// pending deadline. Nothing runs (and nothing is polled from loop()) while
+// no deadline is pending.
+//
+// Each client owns one timer slot and schedules it at absolute esp_timer
+// µs times. Callbacks run in the esp_timer task, so their timing does not
+// depend on loop() load: keep them short (register writes, state updates),
+// no Serial, MQTT or blocking calls.
+
+static const uint8_t EY_TIMER_SLOTS = 8;
+
+typedef void (*EY_TimerCallback)(void* arg);
+
+// Claim a slot. Returns its id, or -1 if every slot is taken or the
+// esp_timer could not be created.
+int8_t EY_Timer_Create(EY_TimerCallback callback, void* arg);
+
+// Run a slot's callback no later than `atUs` (esp_timer µs; a time in the
+// past runs it as soon as possible). An earlier pending deadline is kept,
+// so a client whose callback recomputes its next deadline from its own
+// state never loses a wake-up to a racing caller — at worst it runs once
+// with nothing due. Safe from any task, including timer callbacks.
+void EY_Timer_At(int8_t timer, uint64_t atUs);
+
+// Drop a slot's pending deadline
+void EY_Timer_Cancel(int8_t timer);
@@ -0,0 +1,30 @@
+#pragma once
+// Capacitive touch sensor backend
+// SENSORS[] entries with PresentWhen::TOUCH on a touch-capable GPIO
+// (4, 0, 2, 15, 13, 12, 14, 27, 33, 32). The touch peripheral measures
+// every pad on its own timer with the driver's IIR filter running; a touch
+// raises the pad's threshold interrupt, and only touched pads are checked
+// for release from the input sampler — loop() does no polling at all.
+// Each pad's baseline is calibrated at startup and follows slow drift
+// (humidity, temperature) while the pad is untouched.
+// Per-sensor tuning in SensorDef (0 = default):
+//   threshold  — touch when the reading drops below this % of baseline (TOUCH_THRESHOLD_PCT)
+//   hysteresis — release only once back above threshold + this % (TOUCH_HYSTERESIS_PCT)
+// Feature guard: #define HAS_TOUCH in prop config
+
+#include <Arduino.h>
+
+// Input pollers EY_Touch_Begin() registers (EY_Inputs.cpp sizes its table with them)
+#ifdef HAS_TOUCH
+static constexpr uint8_t EY_TOUCH_POLLERS = 1;
+#else
+static constexpr uint8_t EY_TOUCH_POLLERS = 0;
+#endif
+
+// Calibrate every touch pad and enable the touch interrupt.
+// Call before EY_Inputs_Begin(), with nothing touching the pads.
+void EY_Touch_Begin();
+
+// Filtered reading and current baseline of a touch pin (for diagnostics)
+uint16_t EY_Touch_GetValue(uint8_t gpio);
+uint16_t EY_Touch_GetBaseline(uint8_t gpio);
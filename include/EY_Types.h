@@ -12,53 +12,164 @@
 enum class PresentWhen : uint8_t {
   HIGH_LEVEL,  // present when digitalRead() == HIGH
   LOW_LEVEL,   // present when digitalRead() == LOW (e.g., reed switch to GND)
+  ABOVE,       // analog (HAS_ANALOG): present when the filtered ADC reading >= threshold
+  BELOW,       // analog (HAS_ANALOG): present when the filtered ADC reading < threshold
+  TOUCH,       // capacitive touch pad (HAS_TOUCH): present while touched
+};
+
+constexpr bool EY_IsAnalog(PresentWhen when) {
+  return when == PresentWhen::ABOVE || when == PresentWhen::BELOW;
+}
+
+// How is a sensor's raw level debounced? (DEBOUNCE_* tuning in EY_Config.h)
+enum class DebouncePolicy : uint8_t {
+  TRAILING,  // Accept a level once it has held for DEBOUNCE_MS (default)
+  LEADING,   // Accept the first edge immediately, then ignore the input for
+             // DEBOUNCE_MS (lowest latency for clean contacts, e.g. reed switches)
+  ADAPTIVE,  // Trailing, but the quiet window is learned per input from the
+             // bounce width it actually shows (clean inputs converge to a few ms)
+  MAJORITY,  // Oversampled: level follows the majority of the last
+             // DEBOUNCE_MAJORITY_SAMPLES samples (noisy lines, long cables)
 };
 
 // How do we determine "solved"?
 enum class SolveMode : uint8_t {
   ANY,       // Solved when ANY sensor becomes present
   ALL,       // Solved when ALL sensors are present simultaneously
-  SEQUENCE,  // Sensors must trigger (press transition) in declaration order.
-             // Wrong press resets progress to 0. Releases are ignored.
-  // Future extensions:
-  // CUSTOM,    // Prop-specific logic via callback
+  SEQUENCE,  // Sensors must trigger (press transition) in declaration order, or
+             // in the prop's SEQUENCE_PATTERN (EY_Sequence.h). A wrong press
+             // keeps only the progress it still matches. Releases are ignored.
+  COUNT,     // Solved when at least SOLVE_COUNT non-decorative sensors are
+             // present simultaneously (N-of-M). Prop header defines SOLVE_COUNT.
+  CUSTOM,    // Solved when the prop's SOLVE_EXPR (EY_SolveExpr.h) is true
+  RHYTHM,    // Solved when non-decorative sensors are pressed in the prop's
+             // RHYTHM_PATTERN, tempo-normalized (EY_Rhythm.h)
 };
 
+// Independent puzzle served by a shared board (compile-time configuration,
+// HAS_PUZZLE_GROUPS). Each group solves on its own sensors, releases its
+// own outputs and is reported under its own propId.
+struct PuzzleGroupDef {
+  const char* propId;        // Virtual propId (status/event/cmd topics); nullptr = DEVICE_ID.
+                             // No /lwt: the group is online while DEVICE_ID's /lwt says so
+  const char* name;          // Status "name"; nullptr = DEVICE_NAME
+  SolveMode solveMode;
+  uint8_t solveCount;        // SolveMode::COUNT threshold (unused by other modes)
+};
+
+// Group argument meaning "every group" (broadcast commands, BOOT button)
+static const uint8_t EY_ALL_GROUPS = 0xFF;
+
 // Sensor definition (compile-time configuration).
 // Trailing fields can be omitted in aggregate initializers — they zero-init.
 struct SensorDef {
   const char* id;            // Stable identifier, e.g., "rfid1", "magnet_left"
-  uint8_t pin;               // GPIO pin number
+  uint16_t pin;              // GPIO number, or an expander virtual pin
+                             // (EY_MCP23017_PIN / EY_HC165_PIN, see EY_Inputs.h)
   PresentWhen presentWhen;   // Polarity rule
   const char* actionEvent;   // Event action string, e.g., "rfid_present"
   bool needsArming;          // Must see "not present" at least once before "present" counts
-  bool decorative;           // If true: sensor is ignored by ANY/ALL/SEQUENCE solve logic.
+  bool decorative;           // If true: sensor is ignored by ANY/ALL/COUNT/SEQUENCE solve logic
+                             // (CUSTOM expressions may still reference it by id).
                              // Used for sound-feedback buttons / cosmetic inputs that publish
                              // events on every press but never advance or reset the puzzle.
                              // Omit (defaults to false) for normal puzzle sensors.
   bool latching;             // If true: once the sensor reads "present" it stays latched until
-                             // reset — both for the dashboard "triggered" field and ANY/ALL solve.
+                             // reset — both for the dashboard "triggered" field and ANY/ALL/COUNT solve.
                              // Use for momentary-pulse readers (e.g. RFID modules that pulse on a
                              // read instead of holding the line). Omit (defaults to false) for
                              // level-holding sensors like reed switches.
+  DebouncePolicy debounce;   // Debounce strategy. Omit (defaults to TRAILING) for today's
+                             // fixed DEBOUNCE_MS window.
+  uint16_t threshold;        // ABOVE/BELOW: raw 12-bit ADC level (0-4095)
+                             // TOUCH: % of baseline that counts as a touch (0 = default)
+  uint16_t hysteresis;       // ABOVE/BELOW: the "above" state clears below
+                             // threshold - hysteresis (0 = no hysteresis)
+                             // TOUCH: extra % above threshold to release (0 = default)
+  uint8_t group;             // Index in PUZZLE_GROUPS[] (HAS_PUZZLE_GROUPS). Omit (0) otherwise.
 };
 
-// Sensor runtime state
+// One bit per sensor: bit i = SENSORS[i] (up to 64 sensors)
+typedef uint64_t SensorMask;
+
+constexpr SensorMask EY_SensorBit(uint8_t index) {
+  return (index < 64) ? (1ULL << index) : 0;
+}
+
+// Sensor runtime state, packed as one mask per flag (bit i = SENSORS[i])
 struct SensorState {
-  bool armed;      // Only relevant if needsArming == true
-  bool present;    // Current computed presence (after debounce)
-  bool latched;    // Set once a latching sensor reads present; cleared on reset
-  bool eventSent;  // One-shot event sent this session (reset clears this)
-  bool forceLocked;        // Set by GM force-trigger, preserved until reset
-  bool lastRaw;            // Last raw GPIO reading (for debounce)
-  unsigned long lastChangeMs;  // millis() when lastRaw changed (for debounce)
+  SensorMask armed;        // Only relevant if needsArming == true
+  SensorMask present;      // Current computed presence (after debounce)
+  SensorMask latched;      // Set once a latching sensor reads present; cleared on reset
+  SensorMask eventSent;    // One-shot event sent this session (reset clears this)
+  SensorMask forceLocked;  // Set by GM force-trigger, preserved until reset
+  SensorMask decorative;   // Copy of SENSORS[i].decorative, for status consumers
+  // Debounce state lives in EY_Sensors' shared bit-parallel debouncer (EY_Debounce.h)
+};
+
+// MCP23017 I2C expander (compile-time configuration, HAS_MCP23017)
+struct Mcp23017Def {
+  uint8_t address;   // I2C address, 0x20-0x27
+  uint8_t intPin;    // GPIO wired to the chip's INTA (open-drain, may be shared)
+};
+
+// RFID tag UID (4- or 7-byte ISO 14443A)
+struct RfidUid {
+  uint8_t length;
+  uint8_t bytes[7];
+};
+
+// MFRC522 SPI reader (compile-time configuration, HAS_RFID)
+struct RfidReaderDef {
+  const char* id;            // Reported with tag UIDs, e.g. "star1"
+  uint8_t csPin;             // Chip select (SDA/SS on most boards)
+  const RfidUid* allowed;    // Tags this reader accepts; omit (nullptr) = any tag
+  uint8_t allowedCount;
 };
 
 // Output definition (compile-time configuration)
 struct OutputDef {
   const char* id;    // Stable identifier, e.g., "maglock1", "relay_door"
-  uint8_t pin;       // GPIO pin number
+  uint16_t pin;      // GPIO number, or an expander virtual pin
+                     // (EY_HC595_PIN / EY_PCA9685_PIN / EY_PIXEL_PIN, see EY_Outputs.h)
   bool activeLow;    // true = LOW activates the relay/maglock (common for relay modules)
+  uint8_t group;     // Index in PUZZLE_GROUPS[] (HAS_PUZZLE_GROUPS). Omit (0) otherwise.
+};
+
+// Servo motion profile (HAS_SERVO, see EY_Servo.h)
+enum class ServoProfile : uint8_t {
+  LINEAR,     // Constant speed (starts and stops with a jolt)
+  TRAPEZOID,  // Constant acceleration over the first and last third, cruise between
+  EASE,       // Smoothstep: speed rises and falls continuously
+};
+
+// Servo definition (compile-time configuration, HAS_SERVO)
+struct ServoDef {
+  const char* id;        // For MQTT set_output mode "move", e.g. "trapdoor"
+  uint16_t pin;          // GPIO (LEDC channel), or EY_PCA9685_PIN with PCA9685_PWM_HZ 50
+  uint16_t minUs;        // Pulse width at 0° (DS3225: 500)
+  uint16_t maxUs;        // Pulse width at 180° (DS3225: 2500)
+  uint8_t closedAngle;   // Position on boot and reset
+  uint8_t openAngle;     // Position on solve
+  uint8_t group;         // Index in PUZZLE_GROUPS[] (HAS_PUZZLE_GROUPS). Omit (0) otherwise.
+};
+
+// Optional pin not wired
+static const uint8_t EY_NO_PIN = 0xFF;
+
+// Stepper motor on a STEP/DIR driver (compile-time configuration, HAS_STEPPER)
+struct StepperDef {
+  const char* id;            // For MQTT set_output modes "move" / "home" / "stop"
+  uint8_t stepPin;
+  uint8_t dirPin;            // HIGH = positive direction
+  uint8_t enablePin;         // Active-LOW driver enable, EY_NO_PIN if hard-wired
+  const char* limitSensorId; // SENSORS[] id of the home switch, nullptr = no homing
+  int8_t homeDir;            // Direction of the home switch: -1 or +1
+  uint16_t maxSpeed;         // Steps/s
+  uint16_t accel;            // Steps/s²
+  uint16_t homeSpeed;        // Steps/s while seeking the home switch
+  int32_t openPosition;      // Steps from home (0, next to the switch) on solve
+  uint8_t group;             // Index in PUZZLE_GROUPS[] (HAS_PUZZLE_GROUPS). Omit (0) otherwise.
 };
 
 // Output runtime state
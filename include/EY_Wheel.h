@@ -0,0 +1,47 @@
+#pragma once
+// Rotary wheel input (PCNT hardware pulse counter)
+// Counts encoder or magnet pulses in the PCNT peripheral — no interrupt
+// per pulse — and derives position, spin speed and settle detection from
+// the input sampler. When a spin settles, the segment under the pointer is
+// published as an input bank bit: SENSORS[] entries on EY_WHEEL_SEGMENT(n)
+// with PresentWhen::HIGH_LEVEL read "the wheel stopped on segment n" and
+// solve like any other sensor. The bit clears when the next spin starts.
+// On settle, a "wheel_stopped" event (data: segment) is published, and the
+// spin telemetry goes to <base>/diag:
+//   {"type":"wheel_spin","segment":5,"pulses":412,"revs":3.43,"dir":1,"durationMs":6120,"peakRpm":48.5}
+// Feature guard: #define HAS_WHEEL in prop config, with
+//   WHEEL_PULSE_PIN        encoder A / magnet sensor (rising edges counted)
+//   WHEEL_PULSES_PER_REV   pulses per full turn
+//   WHEEL_SEGMENTS         segments on the wheel (1-64)
+//   optional WHEEL_DIR_PIN        encoder B: LOW reverses the count (quadrature x1)
+//   optional WHEEL_INDEX_PIN      active-LOW home switch: position 0 on its falling edge
+//   optional WHEEL_SEGMENT_OFFSET pulses from position 0 to the start of segment 0
+//   optional WHEEL_SETTLE_MS      no pulse for this long = stopped (default 1500)
+//   optional WHEEL_MIN_SPIN_PULSES pulses that make a spin (default half a turn)
+
+#include <Arduino.h>
+
+// Input pollers EY_Wheel_Begin() registers (EY_Inputs.cpp sizes its table with them)
+#ifdef HAS_WHEEL
+static constexpr uint8_t EY_WHEEL_POLLERS = 1;
+#else
+static constexpr uint8_t EY_WHEEL_POLLERS = 0;
+#endif
+
+// Configure the pulse counter and register with the input sampler.
+// Call before EY_Inputs_Begin().
+void EY_Wheel_Begin();
+
+// Publish the telemetry of a spin that just settled (call every loop)
+void EY_Wheel_Tick();
+
+// Clear the settled segment (a new spin is needed to solve again). Returns
+// once the input sampler has stored a frame without it (1-2 ms), so call
+// it before EY_Sensors_Reset().
+void EY_Wheel_Reset();
+
+// Segment currently under the pointer (live, also while spinning)
+uint8_t EY_Wheel_GetSegment();
+
+// Current speed in revolutions per minute
+float EY_Wheel_GetRpm();
@@ -31,7 +31,7 @@ static const char* DEVICE_NAME = "Bobine";
 static const IPAddress STATIC_IP(192, 168, 2, 205);
 
 // No physical sensors
-static const SensorDef SENSORS[] = {
+static constexpr SensorDef SENSORS[] = {
   { "", 0, PresentWhen::HIGH_LEVEL, "", false },  // Placeholder (SENSOR_COUNT=0 prevents access)
 };
 static constexpr uint8_t SENSOR_COUNT = 0;
@@ -19,7 +19,7 @@ static const IPAddress STATIC_IP(192, 168, 2, 199);
 // Declaration order of NON-decorative sensors = required press order.
 // Decorative buttons (decorative=true) publish events on every press but
 // never affect the SEQUENCE solve logic — used for sound feedback only.
-static const SensorDef SENSORS[] = {
+static constexpr SensorDef SENSORS[] = {
   //  id                pin  presentWhen              actionEvent        needsArming  decorative
   { "old_fashioned",    13,  PresentWhen::LOW_LEVEL,  "button_pressed",  true,        false },
   { "cosmopolitan",     14,  PresentWhen::LOW_LEVEL,  "button_pressed",  true,        false },
@@ -37,9 +37,12 @@ static constexpr SolveMode SOLVE_MODE = SolveMode::SEQUENCE;
 
 // Servo output (replaces maglock)
 #define HAS_SERVO
-static constexpr uint8_t SERVO_PIN = 25;
-static constexpr int SERVO_ANGLE_CLOSED = 0;    // Reset position
-static constexpr int SERVO_ANGLE_OPEN   = 180;  // Solved position (reveal)
+static const ServoDef SERVOS[] = {
+  //  id          pin  minUs  maxUs  closedAngle  openAngle
+  { "trapdoor",   25,  500,   2500,  0,           180 },  // DS3225: 500µs (0°) to 2500µs (180°)
+};
+static constexpr uint8_t SERVO_COUNT = sizeof(SERVOS) / sizeof(SERVOS[0]);
+#define SERVO_BOOT_SWEEP_MS 1000  // Startup test: open then back to closed
 
 // Manual reset: GM holds first button (Old Fashioned) for 3 seconds to reset prop
 #define HAS_MANUAL_RESET
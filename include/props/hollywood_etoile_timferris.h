@@ -18,7 +18,7 @@ static const IPAddress STATIC_IP(192, 168, 2, 204);
 // INPUT_PULLUP: pin reads HIGH when no magnet, LOW when magnet present
 // NOTE: magnet3 moved from GPIO17 (not broken out / PSRAM on this board) to GPIO4,
 //       a normal pull-up-capable pin (no external resistor needed).
-static const SensorDef SENSORS[] = {
+static constexpr SensorDef SENSORS[] = {
   //  id          pin  presentWhen              actionEvent        needsArming
   { "magnet1",    13,  PresentWhen::LOW_LEVEL,  "magnet_present",  true },
   { "magnet2",    14,  PresentWhen::LOW_LEVEL,  "magnet_present",  true },
@@ -19,7 +19,7 @@ static const char* DEVICE_NAME = "Gadgets Pinpad";
 static const IPAddress STATIC_IP(192, 168, 2, 195);
 
 // No physical sensors — Wiegand is handled by EY_Wiegand module
-static const SensorDef SENSORS[] = {
+static constexpr SensorDef SENSORS[] = {
   { "", 0, PresentWhen::HIGH_LEVEL, "", false },  // Placeholder (SENSOR_COUNT=0 prevents access)
 };
 static constexpr uint8_t SENSOR_COUNT = 0;
@@ -20,7 +20,7 @@ static const IPAddress STATIC_IP(192, 168, 2, 201);
 // reader reports LIVE presence so the dashboard shows which chips are physically
 // placed right now (clears on removal). ALL-solve requires all 4 present
 // SIMULTANEOUSLY.
-static const SensorDef SENSORS[] = {
+static constexpr SensorDef SENSORS[] = {
   //  id         pin  presentWhen              actionEvent       needsArming  decorative  latching
   { "rfid1",     13,  PresentWhen::HIGH_LEVEL, "rfid_present",   true,        false,      false },
   { "rfid2",     14,  PresentWhen::HIGH_LEVEL, "rfid_present",   true,        false,      false },
@@ -21,7 +21,7 @@ static const IPAddress STATIC_IP(192, 168, 2, 200);
 // each sensor reports LIVE presence, letting the dashboard show which chips are
 // physically placed right now (appear on place, clear on removal). ALL-solve then
 // requires all 5 chips present SIMULTANEOUSLY (the intended puzzle mechanic).
-static const SensorDef SENSORS[] = {
+static constexpr SensorDef SENSORS[] = {
   //  id         pin  presentWhen              actionEvent       needsArming  decorative  latching
   { "rfid1",     13,  PresentWhen::HIGH_LEVEL, "rfid_present",   true,        false,      false },
   { "rfid2",     14,  PresentWhen::HIGH_LEVEL, "rfid_present",   true,        false,      false },
@@ -26,7 +26,7 @@ static const IPAddress STATIC_IP(192, 168, 2, 197);
 // 2026-06-26: the earlier 5V flakiness was a bad shared VCC/GND joint (re-wired on
 // the prop side), not a voltage problem; the optos would have INVERTED the logic
 // (the brief LOW_LEVEL setting made the dashboard read every cup backwards).
-static const SensorDef SENSORS[] = {
+static constexpr SensorDef SENSORS[] = {
   //  id         pin  presentWhen               actionEvent       needsArming  decorative  latching
   { "cup1",      13,  PresentWhen::HIGH_LEVEL,  "rfid_present",   true,        false,      false },
   { "cup2",      14,  PresentWhen::HIGH_LEVEL,  "rfid_present",   true,        false,      false },
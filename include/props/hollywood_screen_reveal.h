@@ -21,7 +21,7 @@ static const char* DEVICE_NAME = "Screen Reveal";
 static const IPAddress STATIC_IP(192, 168, 2, 203);
 
 // No physical sensors — IR handled by EY_IR module
-static const SensorDef SENSORS[] = {
+static constexpr SensorDef SENSORS[] = {
   { "", 0, PresentWhen::HIGH_LEVEL, "", false },  // Placeholder (SENSOR_COUNT=0 prevents access)
 };
 static constexpr uint8_t SENSOR_COUNT = 0;
@@ -21,7 +21,7 @@ static const IPAddress STATIC_IP(192, 168, 2, 194);
 // sensor inside the shaker transmits. We define it as a sensor
 // so EY_Sensors knows about it (for status reporting), but
 // solve logic is handled by EY_Shaker instead of EY_Sensors.
-static const SensorDef SENSORS[] = {
+static constexpr SensorDef SENSORS[] = {
   //  id       pin  presentWhen              actionEvent        needsArming
   { "shake",   13,  PresentWhen::HIGH_LEVEL, "shake_detected",  false },
 };
@@ -34,7 +34,7 @@ static constexpr unsigned long SIMON_REPORT_INTERVAL_MS = 1000; // MQTT status r
 static constexpr unsigned long SIMON_VICTORY_BLINK_MS   = 200;  // Per-phase toggle in the win animation (3 blinks, ending solid on)
 
 // No standard sensors — Simon module handles button input
-static const SensorDef SENSORS[] = {};
+static constexpr SensorDef SENSORS[] = {};
 static constexpr uint8_t SENSOR_COUNT = 0;
 static constexpr SolveMode SOLVE_MODE = SolveMode::ALL;
 
@@ -33,7 +33,7 @@ static const IPAddress STATIC_IP(192, 168, 2, 206);
 // strapping pins 2/12/15), so NO external resistors are needed. Adjust to the
 // actual Vehicles devkit if its broken-out pins differ.
 //                                    { LEFT pin, RIGHT pin }
-static const uint8_t VEHICLE_PINS[][2] = {
+static constexpr uint8_t VEHICLE_PINS[][2] = {
   {  4,  5 },   // Vehicle 1
   { 13, 16 },   // Vehicle 2
   { 17, 18 },   // Vehicle 3
@@ -67,7 +67,7 @@ static constexpr unsigned long VEHICLE_DEBOUNCE_MS       = 50;    // Switch debo
 static constexpr unsigned long VEHICLE_REPORT_INTERVAL_MS = 1000; // MQTT status report interval
 
 // No standard sensors — the Vehicles module handles switch input directly.
-static const SensorDef SENSORS[] = {};
+static constexpr SensorDef SENSORS[] = {};
 static constexpr uint8_t SENSOR_COUNT = 0;
 static constexpr SolveMode SOLVE_MODE = SolveMode::ALL;
 
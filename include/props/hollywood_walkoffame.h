@@ -21,13 +21,15 @@ static const IPAddress STATIC_IP(192, 168, 2, 196);
 // reports LIVE presence, letting the dashboard show which stars are physically
 // placed right now (appear on place, clear on removal). ALL-solve then requires all
 // 5 present SIMULTANEOUSLY (the intended puzzle mechanic).
-static const SensorDef SENSORS[] = {
-  //  id         pin  presentWhen              actionEvent       needsArming  decorative  latching   // star
-  { "star1",     13,  PresentWhen::HIGH_LEVEL, "rfid_present",   true,        false,      false },    // Spielberg
-  { "star2",     14,  PresentWhen::HIGH_LEVEL, "rfid_present",   true,        false,      false },    // Simpsons
-  { "star3",     26,  PresentWhen::HIGH_LEVEL, "rfid_present",   true,        false,      false },    // Dion
-  { "star4",     27,  PresentWhen::HIGH_LEVEL, "rfid_present",   true,        false,      false },    // Armstrong
-  { "star5",     32,  PresentWhen::HIGH_LEVEL, "rfid_present",   true,        false,      false },    // Ali
+// The star lines run on long cables and chatter, so they use MAJORITY debounce
+// (oversampled majority vote) instead of the default trailing window.
+static constexpr SensorDef SENSORS[] = {
+  //  id         pin  presentWhen              actionEvent       needsArming  decorative  latching  debounce                      // star
+  { "star1",     13,  PresentWhen::HIGH_LEVEL, "rfid_present",   true,        false,      false,     DebouncePolicy::MAJORITY },  // Spielberg
+  { "star2",     14,  PresentWhen::HIGH_LEVEL, "rfid_present",   true,        false,      false,     DebouncePolicy::MAJORITY },  // Simpsons
+  { "star3",     26,  PresentWhen::HIGH_LEVEL, "rfid_present",   true,        false,      false,     DebouncePolicy::MAJORITY },  // Dion
+  { "star4",     27,  PresentWhen::HIGH_LEVEL, "rfid_present",   true,        false,      false,     DebouncePolicy::MAJORITY },  // Armstrong
+  { "star5",     32,  PresentWhen::HIGH_LEVEL, "rfid_present",   true,        false,      false,     DebouncePolicy::MAJORITY },  // Ali
 };
 static constexpr uint8_t SENSOR_COUNT = sizeof(SENSORS) / sizeof(SENSORS[0]);
 static constexpr SolveMode SOLVE_MODE = SolveMode::ALL;  // all 5 stars required
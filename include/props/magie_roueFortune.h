@@ -15,7 +15,7 @@ static const IPAddress STATIC_IP(192, 168, 2, 193);
 // Sensors
 // WARNING: GPIO 12 is an ESP32 strapping pin. If pulled HIGH at boot, the chip
 // may fail to start (wrong flash voltage). Prefer GPIO 13, 14, 25, 26, 32, 33.
-static const SensorDef SENSORS[] = {
+static constexpr SensorDef SENSORS[] = {
   //  id         pin  presentWhen              actionEvent       needsArming
   { "rfid1",     12,  PresentWhen::HIGH_LEVEL, "rfid_present",   true  },
   { "magnet1",   27,  PresentWhen::LOW_LEVEL,  "magnet_present", false },
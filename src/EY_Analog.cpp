@@ -0,0 +1,187 @@
+#include "EY_Config.h"  // Must be first — brings in PROP_CONFIG which may define HAS_ANALOG
+
+#ifdef HAS_ANALOG
+
+#include "EY_Analog.h"
+#include "EY_Inputs.h"
+
+#include <driver/adc.h>
+
+#ifndef ANALOG_SAMPLE_HZ
+  #define ANALOG_SAMPLE_HZ 20000
+#endif
+#ifndef ANALOG_AVG_SAMPLES
+  #define ANALOG_AVG_SAMPLES 16
+#endif
+
+static_assert(ANALOG_SAMPLE_HZ >= SOC_ADC_SAMPLE_FREQ_THRES_LOW && ANALOG_SAMPLE_HZ <= SOC_ADC_SAMPLE_FREQ_THRES_HIGH,
+              "ANALOG_SAMPLE_HZ outside the ADC's continuous-mode range");
+static_assert(ANALOG_AVG_SAMPLES >= 1 && ANALOG_AVG_SAMPLES <= 256 &&
+              (ANALOG_AVG_SAMPLES & (ANALOG_AVG_SAMPLES - 1)) == 0,
+              "ANALOG_AVG_SAMPLES must be a power of two (1-256)");
+
+static const uint8_t ADC1_CHANNELS = 8;
+static const uint32_t ANALOG_DMA_BYTES = 256;  // DMA frame: 128 conversions
+
+// ADC1 channel of a GPIO, -1 if the pin has none
+static constexpr int8_t adc1Channel(uint8_t gpio) {
+  switch (gpio) {
+    case 36: return 0;
+    case 37: return 1;
+    case 38: return 2;
+    case 39: return 3;
+    case 32: return 4;
+    case 33: return 5;
+    case 34: return 6;
+    case 35: return 7;
+    default: return -1;
+  }
+}
+
+// Per-channel settings, from the first analog sensor on each pin
+struct AnalogConfig {
+  uint8_t channelMask;
+  uint8_t gpio[ADC1_CHANNELS];
+  uint16_t threshold[ADC1_CHANNELS];
+  uint16_t hysteresis[ADC1_CHANNELS];
+};
+
+static constexpr AnalogConfig buildAnalogConfig() {
+  AnalogConfig c = {};
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    if (!EY_IsAnalog(SENSORS[i].presentWhen)) continue;
+    int8_t ch = adc1Channel((uint8_t)SENSORS[i].pin);
+    if (ch < 0 || (c.channelMask & (1 << ch))) continue;
+    c.channelMask |= (uint8_t)(1 << ch);
+    c.gpio[ch] = (uint8_t)SENSORS[i].pin;
+    c.threshold[ch] = SENSORS[i].threshold;
+    c.hysteresis[ch] = SENSORS[i].hysteresis;
+  }
+  return c;
+}
+static constexpr AnalogConfig ANALOG = buildAnalogConfig();
+
+static constexpr bool validAnalogSensors() {
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    if (!EY_IsAnalog(SENSORS[i].presentWhen)) continue;
+    if (adc1Channel((uint8_t)SENSORS[i].pin) < 0) return false;
+    if (SENSORS[i].threshold > 4095 || SENSORS[i].hysteresis > SENSORS[i].threshold) return false;
+  }
+  return true;
+}
+static_assert(validAnalogSensors(), "Analog sensors need an ADC1 pin (GPIO 32-39), threshold <= 4095 and hysteresis <= threshold");
+static_assert(ANALOG.channelMask != 0, "HAS_ANALOG set but no PresentWhen::ABOVE/BELOW sensor in SENSORS[]");
+
+// Moving average per channel
+struct AnalogChannel {
+  uint16_t window[ANALOG_AVG_SAMPLES];
+  uint32_t sum;
+  uint16_t filled;   // Samples in the window so far (< ANALOG_AVG_SAMPLES at start)
+  uint8_t next;
+  volatile uint16_t value;
+};
+
+static AnalogChannel s_channels[ADC1_CHANNELS];
+static uint64_t s_above = 0;  // Published word: bit = GPIO above threshold
+static uint8_t s_rx[ANALOG_DMA_BYTES];
+static bool s_running = false;
+
+static void addSample(uint8_t ch, uint16_t raw) {
+  AnalogChannel& c = s_channels[ch];
+  if (c.filled < ANALOG_AVG_SAMPLES) {
+    c.filled++;
+  } else {
+    c.sum -= c.window[c.next];
+  }
+  c.window[c.next] = raw;
+  c.sum += raw;
+  c.next = (uint8_t)((c.next + 1) % ANALOG_AVG_SAMPLES);
+  c.value = (uint16_t)(c.sum / c.filled);
+}
+
+// Sampler hook: drain whatever the DMA has delivered since the last tick
+static void poll(uint64_t) {
+  bool fresh = false;
+  for (uint8_t reads = 0; reads < 4; reads++) {
+    uint32_t len = 0;
+    esp_err_t err = adc_digi_read_bytes(s_rx, sizeof(s_rx), &len, 0);
+    if ((err != ESP_OK && err != ESP_ERR_INVALID_STATE) || len == 0) break;  // INVALID_STATE = overflowed, data still valid
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= len; i += SOC_ADC_DIGI_RESULT_BYTES) {
+      const adc_digi_output_data_t* d = (const adc_digi_output_data_t*)&s_rx[i];
+      uint8_t ch = d->type1.channel;
+      if (ch < ADC1_CHANNELS && (ANALOG.channelMask & (1 << ch))) addSample(ch, d->type1.data);
+    }
+    fresh = true;
+    if (len < sizeof(s_rx)) break;
+  }
+  if (!fresh) return;
+
+  // Threshold with hysteresis on the filtered value
+  uint64_t above = s_above;
+  for (uint8_t ch = 0; ch < ADC1_CHANNELS; ch++) {
+    if (!(ANALOG.channelMask & (1 << ch)) || s_channels[ch].filled == 0) continue;
+    uint64_t bit = EY_PinBit(ANALOG.gpio[ch]);
+    uint16_t v = s_channels[ch].value;
+    if (v >= ANALOG.threshold[ch]) above |= bit;
+    else if (v < ANALOG.threshold[ch] - ANALOG.hysteresis[ch]) above &= ~bit;
+  }
+  if (above != s_above) {
+    s_above = above;
+    EY_Inputs_PublishBank(EY_BANK_ANALOG, above);
+  }
+}
+
+void EY_Analog_Begin() {
+  adc_digi_init_config_t init = {};
+  init.max_store_buf_size = ANALOG_DMA_BYTES * 4;
+  init.conv_num_each_intr = ANALOG_DMA_BYTES;
+  init.adc1_chan_mask = ANALOG.channelMask;
+  init.adc2_chan_mask = 0;
+
+  adc_digi_pattern_config_t pattern[ADC1_CHANNELS] = {};
+  uint8_t patternCount = 0;
+  for (uint8_t ch = 0; ch < ADC1_CHANNELS; ch++) {
+    if (!(ANALOG.channelMask & (1 << ch))) continue;
+    pattern[patternCount].atten = ADC_ATTEN_DB_11;  // Full 0-3.3V range
+    pattern[patternCount].channel = ch;
+    pattern[patternCount].unit = 0;                  // ADC1
+    pattern[patternCount].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    patternCount++;
+  }
+
+  adc_digi_configuration_t config = {};
+  config.conv_limit_en = true;   // Required on the ESP32 (I2S-driven ADC)
+  config.conv_limit_num = 250;
+  config.pattern_num = patternCount;
+  config.adc_pattern = pattern;
+  config.sample_freq_hz = ANALOG_SAMPLE_HZ;
+  config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+  config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+
+  if (adc_digi_initialize(&init) != ESP_OK ||
+      adc_digi_controller_configure(&config) != ESP_OK ||
+      adc_digi_start() != ESP_OK) {
+    Serial.println("[Analog] ERROR: ADC continuous mode failed to start");
+    return;
+  }
+  s_running = true;
+
+  // Let the first DMA frame arrive so the initial frame has real levels
+  delay(2 * ANALOG_DMA_BYTES / SOC_ADC_DIGI_RESULT_BYTES * 1000 / ANALOG_SAMPLE_HZ + 1);
+  poll(0);
+  EY_Inputs_AddPoller(&poll);
+
+  Serial.print("[Analog] ");
+  Serial.print(patternCount);
+  Serial.print(" channels at ");
+  Serial.print(ANALOG_SAMPLE_HZ);
+  Serial.println(" Hz (DMA)");
+}
+
+uint16_t EY_Analog_GetValue(uint8_t gpio) {
+  int8_t ch = adc1Channel(gpio);
+  if (!s_running || ch < 0) return 0;
+  return s_channels[ch].value;
+}
+
+#endif // HAS_ANALOG
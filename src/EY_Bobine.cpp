@@ -3,19 +3,21 @@
 #ifdef HAS_BOBINE
 
 #include "EY_Bobine.h"
+#include "EY_Outputs.h"
+#include "EY_Loop.h"
 #include <Arduino.h>
 
 enum class BobinePhase : uint8_t { IDLE, ON, GAP, PAUSE };
 
 static BobinePhase   s_phase       = BobinePhase::IDLE;
-static uint32_t      s_phaseStart  = 0;
 static uint8_t       s_seqIdx      = 0;
 static bool          s_running     = false;
+static int8_t        s_timer       = -1;  // Loop timer: end of the current phase
 
 static inline void setPuck(uint8_t puckIdx, bool on) {
   if (puckIdx >= BOBINE_PUCK_COUNT) return;
   bool level = BOBINE_ACTIVE_HIGH ? on : !on;
-  digitalWrite(BOBINE_PUCK_PINS[puckIdx], level ? HIGH : LOW);
+  EY_Outputs_WritePin(BOBINE_PUCK_PINS[puckIdx], level);
 }
 
 static void allOff() {
@@ -24,14 +26,51 @@ static void allOff() {
   }
 }
 
+static void enterPhase(BobinePhase phase, uint32_t ms) {
+  s_phase = phase;
+  EY_Loop_After(s_timer, ms);
+}
+
+// Loop timer callback: the current phase is over
+static void step(void*) {
+  if (!s_running) return;
+
+  switch (s_phase) {
+    case BobinePhase::ON:
+      setPuck(BOBINE_SEQUENCE[s_seqIdx], false);
+      s_seqIdx++;
+      if (s_seqIdx >= BOBINE_SEQUENCE_LENGTH) {
+        enterPhase(BobinePhase::PAUSE, BOBINE_PAUSE_MS);
+      } else {
+        enterPhase(BobinePhase::GAP, BOBINE_GAP_MS);
+      }
+      break;
+
+    case BobinePhase::GAP:
+      setPuck(BOBINE_SEQUENCE[s_seqIdx], true);
+      enterPhase(BobinePhase::ON, BOBINE_ON_MS);
+      break;
+
+    case BobinePhase::PAUSE:
+      s_seqIdx = 0;
+      setPuck(BOBINE_SEQUENCE[s_seqIdx], true);
+      enterPhase(BobinePhase::ON, BOBINE_ON_MS);
+      break;
+
+    case BobinePhase::IDLE:
+    default:
+      break;
+  }
+}
+
 void EY_Bobine_Begin() {
   for (uint8_t i = 0; i < BOBINE_PUCK_COUNT; i++) {
-    pinMode(BOBINE_PUCK_PINS[i], OUTPUT);
+    EY_Outputs_BeginPin(BOBINE_PUCK_PINS[i], !BOBINE_ACTIVE_HIGH);
   }
-  allOff();
   s_phase = BobinePhase::IDLE;
   s_running = false;
   s_seqIdx = 0;
+  s_timer = EY_Loop_TimerCreate(&step, nullptr);
   Serial.print("[Bobine] Initialized with ");
   Serial.print(BOBINE_PUCK_COUNT);
   Serial.print(" pucks, sequence length ");
@@ -42,9 +81,8 @@ void EY_Bobine_Start() {
   if (s_running) return;
   s_running = true;
   s_seqIdx = 0;
-  s_phase = BobinePhase::ON;
-  s_phaseStart = millis();
   setPuck(BOBINE_SEQUENCE[s_seqIdx], true);
+  enterPhase(BobinePhase::ON, BOBINE_ON_MS);
   Serial.println("[Bobine] Sequence started");
 }
 
@@ -52,6 +90,7 @@ void EY_Bobine_Stop() {
   if (!s_running && s_phase == BobinePhase::IDLE) return;
   s_running = false;
   s_phase = BobinePhase::IDLE;
+  EY_Loop_Cancel(s_timer);
   allOff();
   Serial.println("[Bobine] Sequence stopped");
 }
@@ -63,52 +102,11 @@ void EY_Bobine_Reset() {
 void EY_Bobine_RevealAll() {
   s_running = false;
   s_phase = BobinePhase::IDLE;
+  EY_Loop_Cancel(s_timer);
   for (uint8_t i = 0; i < BOBINE_PUCK_COUNT; i++) {
     setPuck(i, true);
   }
   Serial.println("[Bobine] All pucks revealed (solid)");
 }
 
-void EY_Bobine_Tick() {
-  if (!s_running) return;
-
-  uint32_t elapsed = millis() - s_phaseStart;
-
-  switch (s_phase) {
-    case BobinePhase::ON:
-      if (elapsed >= BOBINE_ON_MS) {
-        setPuck(BOBINE_SEQUENCE[s_seqIdx], false);
-        s_seqIdx++;
-        s_phaseStart = millis();
-        if (s_seqIdx >= BOBINE_SEQUENCE_LENGTH) {
-          s_phase = BobinePhase::PAUSE;
-        } else {
-          s_phase = BobinePhase::GAP;
-        }
-      }
-      break;
-
-    case BobinePhase::GAP:
-      if (elapsed >= BOBINE_GAP_MS) {
-        setPuck(BOBINE_SEQUENCE[s_seqIdx], true);
-        s_phase = BobinePhase::ON;
-        s_phaseStart = millis();
-      }
-      break;
-
-    case BobinePhase::PAUSE:
-      if (elapsed >= BOBINE_PAUSE_MS) {
-        s_seqIdx = 0;
-        setPuck(BOBINE_SEQUENCE[s_seqIdx], true);
-        s_phase = BobinePhase::ON;
-        s_phaseStart = millis();
-      }
-      break;
-
-    case BobinePhase::IDLE:
-    default:
-      break;
-  }
-}
-
 #endif  // HAS_BOBINE
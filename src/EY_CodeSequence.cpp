@@ -3,6 +3,7 @@
 #ifdef HAS_CODE_SEQUENCE
 
 #include "EY_CodeSequence.h"
+#include "EY_Outputs.h"
 #include <string.h>
 
 static uint8_t s_currentStep = 0;
@@ -10,13 +11,12 @@ static bool    s_solved      = false;
 
 static void setLed(uint8_t index, bool on) {
   if (index >= CODE_SEQUENCE_COUNT) return;
-  digitalWrite(CODE_SEQUENCE_LED_PINS[index], on ? HIGH : LOW);
+  EY_Outputs_WritePin(CODE_SEQUENCE_LED_PINS[index], on);
 }
 
 void EY_CodeSequence_Begin() {
   for (uint8_t i = 0; i < CODE_SEQUENCE_COUNT; i++) {
-    pinMode(CODE_SEQUENCE_LED_PINS[i], OUTPUT);
-    digitalWrite(CODE_SEQUENCE_LED_PINS[i], LOW);
+    EY_Outputs_BeginPin(CODE_SEQUENCE_LED_PINS[i], false);
   }
   s_currentStep = 0;
   s_solved = false;
@@ -0,0 +1,138 @@
+#include "EY_Config.h"  // Must be first — brings in PROP_CONFIG which may define HAS_DMX
+
+#ifdef HAS_DMX
+
+#include "EY_DMX.h"
+#include "EY_Timer.h"
+
+#include <driver/uart.h>
+#include <esp_timer.h>
+
+#ifndef DMX_UART
+  #define DMX_UART 2
+#endif
+#ifndef DMX_REFRESH_HZ
+  #define DMX_REFRESH_HZ 44
+#endif
+#ifndef DMX_ON_LEVEL
+  #define DMX_ON_LEVEL 255
+#endif
+
+static constexpr uart_port_t PORT = (uart_port_t)DMX_UART;
+static constexpr uint32_t FRAME_US = EY_DMX_FrameUs(DMX_CHANNELS);
+static constexpr uint32_t PERIOD_US = 1000000UL / DMX_REFRESH_HZ;
+static constexpr int      TX_BUFFER = 1024;  // Driver ring buffer: one whole frame
+
+static constexpr uint8_t  PIN_CHANNELS = (DMX_CHANNELS < 64) ? DMX_CHANNELS : 64;
+
+static_assert(DMX_UART >= 1 && DMX_UART <= 2, "DMX_UART must be 1 or 2 (UART0 is Serial)");
+static_assert(DMX_CHANNELS >= 24 && DMX_CHANNELS <= 512, "DMX_CHANNELS must be 24-512");
+static_assert(DMX_ON_LEVEL >= 0 && DMX_ON_LEVEL <= 255, "DMX_ON_LEVEL must be 0-255");
+static_assert(DMX_REFRESH_HZ >= 1, "DMX_REFRESH_HZ must be >= 1 (break-to-break and MAB must stay under 1 s)");
+static_assert(FRAME_US <= PERIOD_US, "DMX_REFRESH_HZ too high: a frame of DMX_CHANNELS slots does not fit");
+static_assert(1 + DMX_CHANNELS < TX_BUFFER, "A DMX frame must fit the UART TX buffer");
+
+// Levels written by the modules (index 0 = channel 1)
+static uint8_t s_levels[DMX_CHANNELS];
+static portMUX_TYPE s_dmxMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Frame handed to the UART driver: start code, then the levels
+static uint8_t  s_frame[1 + DMX_CHANNELS];
+static uint64_t s_nextUs = 0;
+static int8_t   s_timer = -1;
+
+// Timer callback: send the next frame once the previous one (and its
+// trailing break) is out
+static void sendFrame(void*) {
+  uint64_t nowUs = (uint64_t)esp_timer_get_time();
+  bool busy = uart_wait_tx_done(PORT, 0) != ESP_OK;
+  uint64_t atUs;
+  bool send = EY_DMX_NextFrame(s_nextUs, PERIOD_US, nowUs, busy, atUs);
+  EY_Timer_At(s_timer, atUs);
+  if (!send) return;
+
+  portENTER_CRITICAL(&s_dmxMux);
+  memcpy(s_frame + 1, s_levels, DMX_CHANNELS);
+  portEXIT_CRITICAL(&s_dmxMux);
+  uart_write_bytes_with_break(PORT, s_frame, sizeof(s_frame), EY_DMX_BREAK_BITS);
+}
+
+// ---- Public API ----
+
+void EY_DMX_Begin() {
+#ifdef DMX_ENABLE_PIN
+  pinMode(DMX_ENABLE_PIN, OUTPUT);
+  digitalWrite(DMX_ENABLE_PIN, HIGH);  // Transmit only
+#endif
+
+  uart_config_t config = {};
+  config.baud_rate = EY_DMX_BAUD;
+  config.data_bits = UART_DATA_8_BITS;
+  config.parity = UART_PARITY_DISABLE;
+  config.stop_bits = UART_STOP_BITS_2;
+  config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+  config.source_clk = UART_SCLK_APB;
+  // RX buffer unused, but the driver needs one larger than the FIFO
+  if (uart_param_config(PORT, &config) != ESP_OK ||
+      uart_set_pin(PORT, DMX_TX_PIN, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK ||
+      uart_driver_install(PORT, 256, TX_BUFFER, 0, nullptr, 0) != ESP_OK ||
+      uart_set_tx_idle_num(PORT, EY_DMX_MAB_BITS) != ESP_OK) {
+    Serial.println("[DMX] ERROR: UART init failed — no DMX output");
+    return;
+  }
+
+  s_frame[0] = 0;  // Start code: dimmer levels
+  s_timer = EY_Timer_Create(&sendFrame, nullptr);
+  s_nextUs = (uint64_t)esp_timer_get_time();
+  EY_Timer_At(s_timer, 1);
+
+  Serial.print("[DMX] ");
+  Serial.print(DMX_CHANNELS);
+  Serial.print(" channels at ");
+  Serial.print(DMX_REFRESH_HZ);
+  Serial.print(" Hz on GPIO ");
+  Serial.println(DMX_TX_PIN);
+}
+
+void EY_DMX_Set(uint16_t channel, uint8_t level) {
+  EY_DMX_Fill(channel, 1, level);
+}
+
+void EY_DMX_Fill(uint16_t first, uint16_t count, uint8_t level) {
+  if (first < 1 || first > DMX_CHANNELS) return;
+  if (count > DMX_CHANNELS - first + 1) count = DMX_CHANNELS - first + 1;
+  portENTER_CRITICAL(&s_dmxMux);
+  memset(s_levels + first - 1, level, count);
+  portEXIT_CRITICAL(&s_dmxMux);
+}
+
+void EY_DMX_SetRange(uint16_t first, const uint8_t* levels, uint16_t count) {
+  if (first < 1 || first > DMX_CHANNELS) return;
+  if (count > DMX_CHANNELS - first + 1) count = DMX_CHANNELS - first + 1;
+  portENTER_CRITICAL(&s_dmxMux);
+  memcpy(s_levels + first - 1, levels, count);
+  portEXIT_CRITICAL(&s_dmxMux);
+}
+
+uint8_t EY_DMX_Get(uint16_t channel) {
+  if (channel < 1 || channel > DMX_CHANNELS) return 0;
+  portENTER_CRITICAL(&s_dmxMux);
+  uint8_t level = s_levels[channel - 1];
+  portEXIT_CRITICAL(&s_dmxMux);
+  return level;
+}
+
+void EY_DMX_Blackout() {
+  EY_DMX_Fill(1, DMX_CHANNELS, 0);
+}
+
+void EY_DMX_Write(uint64_t set, uint64_t clear) {
+  portENTER_CRITICAL(&s_dmxMux);
+  for (uint64_t m = (set | clear) & ((PIN_CHANNELS < 64) ? ((1ULL << PIN_CHANNELS) - 1) : ~0ULL); m; m &= m - 1) {
+    uint8_t index = __builtin_ctzll(m);
+    s_levels[index] = ((set >> index) & 1) ? DMX_ON_LEVEL : 0;
+  }
+  portEXIT_CRITICAL(&s_dmxMux);
+}
+
+#endif // HAS_DMX
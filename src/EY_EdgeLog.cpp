@@ -0,0 +1,172 @@
+#include "EY_EdgeLog.h"
+#include "EY_Config.h"
+#include "EY_Mqtt.h"
+
+#include <ArduinoJson.h>
+#include <esp_timer.h>
+
+// One raw edge. Time is µs since session start (wraps after ~71 min, but
+// the dump only uses differences between consecutive entries).
+struct EdgeEntry {
+  uint32_t timeUs;
+  uint8_t sensor;
+  bool level;
+};
+
+struct EdgeStats {
+  uint32_t rawEdges;
+  uint32_t accepted;
+  uint32_t lastEdgeUs;       // Previous raw edge (pulse width reference)
+  uint32_t burstStartUs;     // First raw edge away from the debounced level
+  bool inBurst;
+  uint16_t widthHist[EY_EDGE_HIST_BUCKETS];
+  uint32_t latMinUs;
+  uint32_t latMaxUs;
+  uint32_t latSumUs;
+  uint32_t latCount;
+};
+
+static const uint32_t HIST_LIMITS_US[EY_EDGE_HIST_BUCKETS - 1] = {
+  1000, 2000, 5000, 10000, 20000, 50000, 100000,
+};
+
+static EdgeEntry s_ring[EDGE_LOG_SIZE];
+static uint16_t s_head = 0;        // Next write
+static uint16_t s_count = 0;       // Valid entries (<= EDGE_LOG_SIZE)
+static uint32_t s_dropped = 0;     // Entries overwritten this session
+static uint64_t s_sessionStartUs = 0;
+static EdgeStats s_stats[SENSOR_COUNT];
+
+static uint32_t sessionUs(uint64_t timeUs) {
+  return (uint32_t)(timeUs - s_sessionStartUs);
+}
+
+static uint8_t histBucket(uint32_t widthUs) {
+  uint8_t b = 0;
+  while (b < EY_EDGE_HIST_BUCKETS - 1 && widthUs >= HIST_LIMITS_US[b]) b++;
+  return b;
+}
+
+void EY_EdgeLog_Reset() {
+  s_head = 0;
+  s_count = 0;
+  s_dropped = 0;
+  s_sessionStartUs = (uint64_t)esp_timer_get_time();
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    s_stats[i] = {};
+    s_stats[i].latMinUs = UINT32_MAX;
+  }
+}
+
+void EY_EdgeLog_RawEdge(uint8_t sensor, bool level, bool debounced, uint64_t timeUs) {
+  if (sensor >= SENSOR_COUNT) return;
+  uint32_t t = sessionUs(timeUs);
+
+  EdgeEntry& e = s_ring[s_head];
+  e.timeUs = t;
+  e.sensor = sensor;
+  e.level = level;
+  s_head = (uint16_t)((s_head + 1) % EDGE_LOG_SIZE);
+  if (s_count < EDGE_LOG_SIZE) s_count++;
+  else s_dropped++;
+
+  EdgeStats& st = s_stats[sensor];
+  if (st.rawEdges > 0) {
+    uint16_t& bucket = st.widthHist[histBucket(t - st.lastEdgeUs)];
+    if (bucket < UINT16_MAX) bucket++;
+  }
+  st.rawEdges++;
+  st.lastEdgeUs = t;
+
+  // Latency runs from the first edge away from the debounced level; an
+  // edge back to it (a glitch that settled) cancels the measurement.
+  if (level == debounced) {
+    st.inBurst = false;
+  } else if (!st.inBurst) {
+    st.inBurst = true;
+    st.burstStartUs = t;
+  }
+}
+
+void EY_EdgeLog_Accepted(uint8_t sensor, uint64_t timeUs) {
+  if (sensor >= SENSOR_COUNT) return;
+  EdgeStats& st = s_stats[sensor];
+  st.accepted++;
+  if (!st.inBurst) return;
+
+  uint32_t lat = sessionUs(timeUs) - st.burstStartUs;
+  st.inBurst = false;
+  if (lat < st.latMinUs) st.latMinUs = lat;
+  if (lat > st.latMaxUs) st.latMaxUs = lat;
+  st.latSumUs += lat;
+  st.latCount++;
+}
+
+static void publishDoc(const JsonDocument& doc) {
+  char out[EDGE_LOG_CHUNK_BYTES + 128];
+  size_t len = serializeJson(doc, out, sizeof(out));
+  EY_PublishDiag(out, len);
+}
+
+void EY_EdgeLog_Dump() {
+  Serial.print("[EdgeLog] Dump: ");
+  Serial.print(s_count);
+  Serial.print(" edges (");
+  Serial.print(s_dropped);
+  Serial.println(" dropped)");
+
+  // ---- Per-sensor statistics ----
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    const EdgeStats& st = s_stats[i];
+    StaticJsonDocument<384> doc;
+    doc[EY_MQTT::F_PROP_ID] = DEVICE_ID;
+    doc[EY_MQTT::F_TYPE] = "edge_stats";
+    doc["sensorId"] = SENSORS[i].id;
+    doc["edges"] = st.rawEdges;
+    doc["accepted"] = st.accepted;
+    doc["bounces"] = (st.rawEdges > st.accepted) ? (st.rawEdges - st.accepted) : 0;
+    JsonArray hist = doc.createNestedArray("hist");
+    for (uint8_t b = 0; b < EY_EDGE_HIST_BUCKETS; b++) hist.add(st.widthHist[b]);
+    JsonArray lat = doc.createNestedArray("latUs");
+    if (st.latCount > 0) {
+      lat.add(st.latMinUs);
+      lat.add(st.latMaxUs);
+      lat.add(st.latSumUs / st.latCount);
+    }
+    publishDoc(doc);
+  }
+
+  // ---- Edge ring, oldest first, in compact chunks ----
+  uint16_t start = (uint16_t)((s_head + EDGE_LOG_SIZE - s_count) % EDGE_LOG_SIZE);
+  uint16_t n = 0;
+  uint16_t part = 0;
+  do {
+    char chunk[EDGE_LOG_CHUNK_BYTES];
+    size_t used = 0;
+    uint32_t t0 = (n < s_count) ? s_ring[(start + n) % EDGE_LOG_SIZE].timeUs : 0;
+    uint32_t prevUs = t0;
+
+    while (n < s_count) {
+      const EdgeEntry& e = s_ring[(start + n) % EDGE_LOG_SIZE];
+      char entry[24];
+      int len = snprintf(entry, sizeof(entry), "%s%u%c%lu", used ? ";" : "",
+                         e.sensor, e.level ? '+' : '-', (unsigned long)(e.timeUs - prevUs));
+      if (used + len >= sizeof(chunk)) break;  // chunk full
+      memcpy(chunk + used, entry, len);
+      used += len;
+      prevUs = e.timeUs;
+      n++;
+    }
+    chunk[used] = '\0';
+
+    StaticJsonDocument<192> doc;
+    doc[EY_MQTT::F_PROP_ID] = DEVICE_ID;
+    doc[EY_MQTT::F_TYPE] = "edge_log";
+    doc["part"] = part++;
+    doc["last"] = (n >= s_count);
+    doc["t0"] = t0;
+    doc["dropped"] = s_dropped;
+    doc["e"] = (const char*)chunk;
+    publishDoc(doc);
+  } while (n < s_count);
+}
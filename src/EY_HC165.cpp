@@ -0,0 +1,79 @@
+#include "EY_Config.h"  // Must be first — brings in PROP_CONFIG which may define HAS_HC165
+
+#ifdef HAS_HC165
+
+#include "EY_HC165.h"
+#include "EY_Inputs.h"
+
+#include <driver/spi_master.h>
+#include <esp_attr.h>
+#include <soc/soc.h>
+#include <soc/gpio_reg.h>
+
+#ifndef HC165_SPI_HZ
+  #define HC165_SPI_HZ 1000000
+#endif
+
+static_assert(HC165_CHIP_COUNT >= 1 && HC165_CHIP_COUNT <= 16, "74HC165 chain supports 1-16 chips (two input banks)");
+static_assert(HC165_LOAD_PIN < 32, "HC165_LOAD_PIN must be an output-capable GPIO 0-31 (pulsed via GPIO_OUT_W1TC/W1TS)");
+
+static spi_device_handle_t s_spi = nullptr;
+DMA_ATTR WORD_ALIGNED_ATTR static uint8_t s_rx[(HC165_CHIP_COUNT + 3) & ~3];
+
+// Sampler hook: latch the parallel inputs, then shift the chain in
+static void poll(uint64_t) {
+  // SH/LD low loads A-H into every chip; the pulse is far longer than the
+  // 20 ns minimum at any CPU clock.
+  REG_WRITE(GPIO_OUT_W1TC_REG, 1UL << HC165_LOAD_PIN);
+  REG_WRITE(GPIO_OUT_W1TS_REG, 1UL << HC165_LOAD_PIN);
+
+  spi_transaction_t t = {};
+  t.length = HC165_CHIP_COUNT * 8;
+  t.rxlength = HC165_CHIP_COUNT * 8;
+  t.rx_buffer = s_rx;
+  if (spi_device_polling_transmit(s_spi, &t) != ESP_OK) return;
+
+  // Chip 0 (nearest the ESP32) shifts out first, H (input 7) first —
+  // MSB-first SPI puts H in bit 7, so byte k is chip k with bit b = input b.
+  uint64_t words[2] = {0, 0};
+  for (uint8_t k = 0; k < HC165_CHIP_COUNT; k++) {
+    words[k / 8] |= (uint64_t)s_rx[k] << ((k % 8) * 8);
+  }
+  EY_Inputs_PublishBank(EY_BANK_HC165, words[0]);
+  if (HC165_CHIP_COUNT > 8) EY_Inputs_PublishBank(EY_BANK_HC165 + 1, words[1]);
+}
+
+void EY_HC165_Begin() {
+  pinMode(HC165_LOAD_PIN, OUTPUT);
+  digitalWrite(HC165_LOAD_PIN, HIGH);  // HIGH = shift, LOW = load
+
+  spi_bus_config_t bus = {};
+  bus.mosi_io_num = -1;
+  bus.miso_io_num = HC165_DATA_PIN;
+  bus.sclk_io_num = HC165_CLK_PIN;
+  bus.quadwp_io_num = -1;
+  bus.quadhd_io_num = -1;
+  bus.max_transfer_sz = sizeof(s_rx);
+
+  spi_device_interface_config_t dev = {};
+  dev.mode = 0;                  // QH is valid on the rising edge of CLK
+  dev.clock_speed_hz = HC165_SPI_HZ;
+  dev.spics_io_num = -1;         // LOAD is driven by hand, not as CS
+  dev.queue_size = 1;
+
+  if (spi_bus_initialize(SPI2_HOST, &bus, SPI_DMA_CH_AUTO) != ESP_OK ||
+      spi_bus_add_device(SPI2_HOST, &dev, &s_spi) != ESP_OK) {
+    Serial.println("[HC165] ERROR: SPI init failed — chain not read");
+    s_spi = nullptr;
+    return;
+  }
+
+  poll(0);  // First frame before the sampler starts
+  EY_Inputs_AddPoller(&poll);
+
+  Serial.print("[HC165] ");
+  Serial.print(HC165_CHIP_COUNT);
+  Serial.println(" chips on SPI2");
+}
+
+#endif // HAS_HC165
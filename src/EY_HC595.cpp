@@ -0,0 +1,113 @@
+#include "EY_Config.h"  // Must be first — brings in PROP_CONFIG which may define HAS_HC595
+
+#ifdef HAS_HC595
+
+#include "EY_HC595.h"
+#include "EY_Timer.h"
+
+#include <driver/spi_master.h>
+#include <esp_attr.h>
+#include <soc/soc.h>
+#include <soc/gpio_reg.h>
+
+#ifndef HC595_SPI_HZ
+  #define HC595_SPI_HZ 4000000
+#endif
+
+#ifndef HC595_SPI_HOST
+  #if defined(HAS_HC165) && defined(HAS_RFID)
+    #error "HAS_HC595: no free SPI host (HC165 uses SPI2, RFID uses SPI3)"
+  #elif defined(HAS_HC165)
+    #define HC595_SPI_HOST SPI3_HOST
+  #else
+    #define HC595_SPI_HOST SPI2_HOST
+  #endif
+#endif
+
+static_assert(HC595_CHIP_COUNT >= 1 && HC595_CHIP_COUNT <= 8, "74HC595 chain supports 1-8 chips (one output bank)");
+static_assert(HC595_LATCH_PIN < 32, "HC595_LATCH_PIN must be an output-capable GPIO 0-31 (pulsed via GPIO_OUT_W1TS/W1TC)");
+
+static spi_device_handle_t s_spi = nullptr;
+DMA_ATTR WORD_ALIGNED_ATTR static uint8_t s_tx[(HC595_CHIP_COUNT + 3) & ~3];
+
+static uint64_t s_shadow = 0;    // Bit chip * 8 + output
+static bool s_latched = false;   // A frame has reached the outputs
+static portMUX_TYPE s_shadowMux = portMUX_INITIALIZER_UNLOCKED;
+static int8_t s_timer = -1;
+
+// Timer callback: shift the whole chain out, then latch it
+static void refresh(void*) {
+  portENTER_CRITICAL(&s_shadowMux);
+  uint64_t bits = s_shadow;
+  portEXIT_CRITICAL(&s_shadowMux);
+
+  // The first byte shifted ends up in the last chip: send chip N-1 first.
+  // MSB-first SPI puts bit 7 on QH, so bit b of a byte drives output b.
+  for (uint8_t k = 0; k < HC595_CHIP_COUNT; k++) {
+    s_tx[k] = (uint8_t)(bits >> ((HC595_CHIP_COUNT - 1 - k) * 8));
+  }
+
+  spi_transaction_t t = {};
+  t.length = HC595_CHIP_COUNT * 8;
+  t.tx_buffer = s_tx;
+  if (spi_device_polling_transmit(s_spi, &t) != ESP_OK) return;
+
+  // RCLK rising edge copies the shift registers to the outputs
+  REG_WRITE(GPIO_OUT_W1TS_REG, 1UL << HC595_LATCH_PIN);
+  REG_WRITE(GPIO_OUT_W1TC_REG, 1UL << HC595_LATCH_PIN);
+
+#ifdef HC595_OE_PIN
+  if (!s_latched) digitalWrite(HC595_OE_PIN, LOW);  // Outputs on, now that they hold a real frame
+#endif
+  s_latched = true;
+}
+
+void EY_HC595_Begin() {
+#ifdef HC595_OE_PIN
+  pinMode(HC595_OE_PIN, OUTPUT);
+  digitalWrite(HC595_OE_PIN, HIGH);  // Outputs off until the first frame
+#endif
+  pinMode(HC595_LATCH_PIN, OUTPUT);
+  digitalWrite(HC595_LATCH_PIN, LOW);
+
+  spi_bus_config_t bus = {};
+  bus.mosi_io_num = HC595_DATA_PIN;
+  bus.miso_io_num = -1;
+  bus.sclk_io_num = HC595_CLK_PIN;
+  bus.quadwp_io_num = -1;
+  bus.quadhd_io_num = -1;
+  bus.max_transfer_sz = sizeof(s_tx);
+
+  spi_device_interface_config_t dev = {};
+  dev.mode = 0;                  // SER is sampled on the rising edge of SRCLK
+  dev.clock_speed_hz = HC595_SPI_HZ;
+  dev.spics_io_num = -1;         // RCLK is pulsed by hand after the transfer
+  dev.queue_size = 1;
+
+  if (spi_bus_initialize(HC595_SPI_HOST, &bus, SPI_DMA_CH_AUTO) != ESP_OK ||
+      spi_bus_add_device(HC595_SPI_HOST, &dev, &s_spi) != ESP_OK) {
+    Serial.println("[HC595] ERROR: SPI init failed — chain not driven");
+    s_spi = nullptr;
+    return;
+  }
+  s_timer = EY_Timer_Create(&refresh, nullptr);
+
+  Serial.print("[HC595] ");
+  Serial.print(HC595_CHIP_COUNT);
+  Serial.println(" chips");
+}
+
+bool EY_HC595_Write(uint64_t set, uint64_t clear) {
+  portENTER_CRITICAL(&s_shadowMux);
+  uint64_t before = s_shadow;
+  s_shadow = (s_shadow | set) & ~clear;
+  bool changed = (s_shadow != before) || !s_latched;
+  portEXIT_CRITICAL(&s_shadowMux);
+  return changed && s_spi;
+}
+
+void EY_HC595_Refresh() {
+  EY_Timer_At(s_timer, 1);  // Already due: runs next in the timer task
+}
+
+#endif // HAS_HC595
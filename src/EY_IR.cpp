@@ -4,6 +4,7 @@
 
 #include "EY_IR.h"
 #include "EY_Mqtt.h"
+#include "EY_Loop.h"
 #include <IRremoteESP8266.h>
 #include <IRrecv.h>
 #include <IRutils.h>
@@ -21,8 +22,7 @@ static unsigned long s_lastCodeTime = 0;
 // Onboard LED diagnostic blink — fires on every accepted IR press so we can
 // see at-the-prop whether decoding works, independent of MQTT publish.
 static constexpr unsigned long IR_LED_BLINK_MS = 80;
-static unsigned long s_ledOffAt = 0;
-static bool s_ledOn = false;
+static int8_t s_ledTimer = -1;  // Loop timer: end of the blink
 
 static void irSetLed(bool on) {
   if (LED_ACTIVE_LOW) {
@@ -32,6 +32,10 @@ static void irSetLed(bool on) {
   }
 }
 
+static void ledOff(void*) {
+  irSetLed(false);
+}
+
 // Look up a captured NEC code in IR_KEY_MAP (defined in prop header).
 // Returns mapped char ('0'..'9' or 'C'), or 0 if not found.
 static char mapCodeToKey(uint64_t code) {
@@ -54,18 +58,13 @@ void EY_IR_Begin(uint8_t pin) {
 
   s_lastCode = 0;
   s_lastCodeTime = 0;
+  if (s_ledTimer < 0) s_ledTimer = EY_Loop_TimerCreate(&ledOff, nullptr);
 
   Serial.print("[IR] Ready on GPIO");
   Serial.println(pin);
 }
 
 void EY_IR_Tick() {
-  // Turn the diagnostic blink off once its window expires
-  if (s_ledOn && millis() >= s_ledOffAt) {
-    irSetLed(false);
-    s_ledOn = false;
-  }
-
   if (!s_recv) return;
   if (!s_recv->decode(&s_results)) return;
 
@@ -87,8 +86,8 @@ void EY_IR_Tick() {
   // of whether the code maps to a known key. Lets us see at-the-prop
   // whether the IR receiver is decoding at all, without relying on MQTT.
   irSetLed(true);
-  s_ledOn = true;
-  s_ledOffAt = now + IR_LED_BLINK_MS;
+  EY_Loop_Cancel(s_ledTimer);  // A new press restarts the blink
+  EY_Loop_After(s_ledTimer, IR_LED_BLINK_MS);
 
   char key = mapCodeToKey(code);
   if (key == 0) {
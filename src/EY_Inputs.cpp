@@ -0,0 +1,221 @@
+#include "EY_Config.h"  // First: the backend headers' poller counts follow its HAS_* guards
+#include "EY_Inputs.h"
+#include "EY_Loop.h"
+#include "EY_MCP23017.h"
+#include "EY_HC165.h"
+#include "EY_Matrix.h"
+#include "EY_Analog.h"
+#include "EY_Touch.h"
+#include "EY_Wheel.h"
+#include "EY_Nodes.h"
+
+#include <esp_timer.h>
+#include <soc/soc.h>
+#include <soc/gpio_reg.h>
+
+static_assert((INPUT_RING_SIZE & (INPUT_RING_SIZE - 1)) == 0, "INPUT_RING_SIZE must be a power of two");
+
+// Pollers of the enabled backends, as each backend header declares them
+static constexpr uint8_t POLLER_BACKENDS = EY_MCP23017_POLLERS + EY_HC165_POLLERS + EY_MATRIX_POLLERS +
+                                           EY_ANALOG_POLLERS + EY_TOUCH_POLLERS + EY_WHEEL_POLLERS +
+                                           EY_NODES_POLLERS;
+static constexpr uint8_t MAX_POLLERS = (POLLER_BACKENDS > 0) ? POLLER_BACKENDS : 1;
+
+static uint64_t s_snapshot = 0;
+static EY_InputFrame s_snapshotFrame = {};
+
+// Latest word of each backend bank (bank 0 unused: GPIO is read directly)
+static EY_InputFrame s_latest = {};
+static portMUX_TYPE s_latestMux = portMUX_INITIALIZER_UNLOCKED;
+
+static EY_InputPoller s_pollers[MAX_POLLERS];
+static uint8_t s_pollerCount = 0;
+
+// Sampler ring. Single writer (esp_timer task), any number of readers each
+// with its own cursor. s_head is the sequence number of the next write.
+static EY_InputSample s_ring[INPUT_RING_SIZE];
+static volatile uint32_t s_head = 0;
+static EY_InputFrame s_lastFrame = {};  // Last frame captured by the sampler
+static esp_timer_handle_t s_timer = nullptr;
+static uint32_t s_scanMaxUs = 0;  // Longest capture since the last report (s_latestMux)
+static volatile uint32_t s_passes = 0;  // Sampler ticks completed
+
+uint64_t EY_Inputs_Read() {
+  // GPIO_IN_REG holds GPIO 0-31; GPIO_IN1_REG bits 0-7 hold GPIO 32-39.
+  uint32_t lo = REG_READ(GPIO_IN_REG);
+  uint32_t hi = REG_READ(GPIO_IN1_REG) & GPIO_IN1_DATA;
+  return ((uint64_t)hi << 32) | lo;
+}
+
+// GPIO registers + latest backend banks, without running pollers
+static void mergeFrame(uint64_t gpio, EY_InputFrame& out) {
+  portENTER_CRITICAL(&s_latestMux);
+  out = s_latest;
+  portEXIT_CRITICAL(&s_latestMux);
+  out.bank[EY_BANK_GPIO] = gpio;
+}
+
+// Full capture: let backends poll their hardware, then merge
+static void captureFrame(EY_InputFrame& out) {
+  uint64_t gpio = EY_Inputs_Read();
+  for (uint8_t i = 0; i < s_pollerCount; i++) s_pollers[i](gpio);
+  mergeFrame(gpio, out);
+}
+
+void EY_Inputs_AddPoller(EY_InputPoller poller) {
+  if (!poller) return;
+  if (s_pollerCount >= MAX_POLLERS) {
+    // A backend header without its poller count: its bank would never update
+    Serial.println("[Inputs] ERROR: poller table full — input backend not polled");
+    return;
+  }
+  s_pollers[s_pollerCount++] = poller;
+}
+
+void EY_Inputs_PublishBank(uint8_t bank, uint64_t bits) {
+  if (bank == EY_BANK_GPIO || bank >= EY_INPUT_BANKS) return;
+  portENTER_CRITICAL(&s_latestMux);
+  s_latest.bank[bank] = bits;
+  portEXIT_CRITICAL(&s_latestMux);
+}
+
+// Append a changed frame to the ring and wake loop() to handle it
+static void storeFrame(const EY_InputFrame& frame) {
+  uint32_t head = s_head;
+  EY_InputSample& slot = s_ring[head & (INPUT_RING_SIZE - 1)];
+  slot.timeUs = (uint64_t)esp_timer_get_time();
+  slot.frame = frame;
+  __sync_synchronize();  // publish the entry before the new head
+
+  portENTER_CRITICAL(&s_latestMux);
+  s_lastFrame = frame;
+  s_head = head + 1;
+  portEXIT_CRITICAL(&s_latestMux);
+  EY_Loop_Wake();
+}
+
+// Timer callback: store the frame only if something changed
+static void samplerTick(void*) {
+  uint64_t startUs = (uint64_t)esp_timer_get_time();
+  EY_InputFrame frame;
+  captureFrame(frame);
+  uint32_t scanUs = (uint32_t)((uint64_t)esp_timer_get_time() - startUs);
+  portENTER_CRITICAL(&s_latestMux);
+  if (scanUs > s_scanMaxUs) s_scanMaxUs = scanUs;
+  portEXIT_CRITICAL(&s_latestMux);
+
+  if (frame != s_lastFrame) storeFrame(frame);
+  s_passes = s_passes + 1;
+}
+
+void EY_Inputs_Begin() {
+  captureFrame(s_lastFrame);
+  s_snapshotFrame = s_lastFrame;
+  s_snapshot = s_lastFrame.bank[EY_BANK_GPIO];
+
+  esp_timer_create_args_t args = {};
+  args.callback = &samplerTick;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name = "ey_inputs";
+  args.skip_unhandled_events = true;  // a late sample is replaced, not queued
+
+  if (esp_timer_create(&args, &s_timer) != ESP_OK ||
+      esp_timer_start_periodic(s_timer, 1000000ULL / INPUT_SAMPLE_HZ) != ESP_OK) {
+    Serial.println("[Inputs] ERROR: sampler timer failed to start — polling from loop()");
+    s_timer = nullptr;
+    return;
+  }
+  Serial.print("[Inputs] Sampling at ");
+  Serial.print(INPUT_SAMPLE_HZ);
+  Serial.println(" Hz");
+}
+
+void EY_Inputs_Sync() {
+  if (!s_timer) return;  // Consumers capture live frames
+  // The first pass may have polled before the call; the second did not.
+  // Bounded, in case the sampler is held off.
+  uint32_t start = s_passes;
+  for (uint8_t ms = 0; ms < 10 && (uint32_t)(s_passes - start) < 2; ms++) delay(1);
+}
+
+uint32_t EY_Inputs_TakeScanMaxUs() {
+  portENTER_CRITICAL(&s_latestMux);
+  uint32_t us = s_scanMaxUs;
+  s_scanMaxUs = 0;
+  portEXIT_CRITICAL(&s_latestMux);
+  return us;
+}
+
+void EY_Inputs_Sample() {
+  s_snapshot = EY_Inputs_Read();
+  mergeFrame(s_snapshot, s_snapshotFrame);
+}
+
+uint64_t EY_Inputs_Snapshot() {
+  return s_snapshot;
+}
+
+const EY_InputFrame& EY_Inputs_SnapshotFrame() {
+  return s_snapshotFrame;
+}
+
+void EY_Inputs_CursorBegin(EY_InputCursor& cursor) {
+  if (s_timer) {
+    // Start from the sampler's last frame; later changes are in the ring
+    portENTER_CRITICAL(&s_latestMux);
+    cursor.seq = s_head;
+    cursor.frame = s_lastFrame;
+    portEXIT_CRITICAL(&s_latestMux);
+  } else {
+    cursor.seq = s_head;
+    captureFrame(cursor.frame);
+  }
+  cursor.lastUs = (uint64_t)esp_timer_get_time();
+  cursor.overruns = 0;
+}
+
+bool EY_Inputs_Next(EY_InputCursor& cursor, EY_InputSample& out) {
+  // Sampler not running: fall back to polling at the consumer's pace
+  if (!s_timer) {
+    EY_InputFrame frame;
+    captureFrame(frame);
+    if (frame == cursor.frame) return false;
+    out.timeUs = (uint64_t)esp_timer_get_time();
+    out.frame = frame;
+    if (out.timeUs < cursor.lastUs) out.timeUs = cursor.lastUs;
+    cursor.lastUs = out.timeUs;
+    cursor.frame = frame;
+    return true;
+  }
+
+  for (;;) {
+    uint32_t head = s_head;
+    __sync_synchronize();
+    if (cursor.seq == head) return false;
+
+    // Fell behind: skip to the oldest entry that is safe to read. The slot
+    // of sequence head - INPUT_RING_SIZE is the one the sampler writes
+    // next, so only INPUT_RING_SIZE - 1 entries are readable.
+    if (head - cursor.seq >= INPUT_RING_SIZE) {
+      cursor.overruns += head - INPUT_RING_SIZE + 1 - cursor.seq;
+      cursor.seq = head - INPUT_RING_SIZE + 1;
+    }
+
+    out = s_ring[cursor.seq & (INPUT_RING_SIZE - 1)];
+    __sync_synchronize();
+    // Slot rewritten (or being rewritten) while copying — retry
+    if (s_head - cursor.seq >= INPUT_RING_SIZE) continue;
+
+    cursor.seq++;
+    if (out.timeUs < cursor.lastUs) out.timeUs = cursor.lastUs;
+    cursor.lastUs = out.timeUs;
+    cursor.frame = out.frame;
+    return true;
+  }
+}
+
+uint64_t EY_Inputs_CursorNowUs(EY_InputCursor& cursor) {
+  uint64_t nowUs = (uint64_t)esp_timer_get_time();
+  if (nowUs > cursor.lastUs) cursor.lastUs = nowUs;
+  return cursor.lastUs;
+}
@@ -0,0 +1,91 @@
+#include "EY_Loop.h"
+#include "EY_Config.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+struct LoopSlot {
+  EY_TimerCallback callback;
+  void* arg;
+  uint32_t atMs;
+  bool pending;
+};
+
+// Loop task only: no locking needed
+static LoopSlot s_slots[EY_LOOP_TIMER_SLOTS];
+static uint8_t s_slotCount = 0;
+static uint32_t s_wakeAtMs = 0;
+static bool s_wakePending = false;
+
+static TaskHandle_t s_loopTask = nullptr;
+
+// `a` is before `b`, across millis() wrap-around
+static inline bool before(uint32_t a, uint32_t b) {
+  return (int32_t)(a - b) < 0;
+}
+
+void EY_Loop_Begin() {
+  s_loopTask = xTaskGetCurrentTaskHandle();
+}
+
+int8_t EY_Loop_TimerCreate(EY_TimerCallback callback, void* arg) {
+  if (!callback || s_slotCount >= EY_LOOP_TIMER_SLOTS) {
+    Serial.println("[Loop] ERROR: no loop timer slot left");
+    return -1;
+  }
+  s_slots[s_slotCount] = { callback, arg, 0, false };
+  return (int8_t)s_slotCount++;
+}
+
+void EY_Loop_At(int8_t timer, uint32_t atMs) {
+  if (timer < 0 || timer >= (int8_t)s_slotCount) return;
+  LoopSlot& slot = s_slots[timer];
+  if (!slot.pending || before(atMs, slot.atMs)) slot.atMs = atMs;
+  slot.pending = true;
+}
+
+void EY_Loop_After(int8_t timer, uint32_t ms) {
+  EY_Loop_At(timer, millis() + ms);
+}
+
+void EY_Loop_Cancel(int8_t timer) {
+  if (timer < 0 || timer >= (int8_t)s_slotCount) return;
+  s_slots[timer].pending = false;
+}
+
+void EY_Loop_WakeAt(uint32_t atMs) {
+  if (!s_wakePending || before(atMs, s_wakeAtMs)) s_wakeAtMs = atMs;
+  s_wakePending = true;
+}
+
+void EY_Loop_Wake() {
+  if (s_loopTask) xTaskNotifyGive(s_loopTask);
+}
+
+void EY_Loop_Wait() {
+  // Earliest deadline, capped at the network poll interval
+  uint32_t nowMs = millis();
+  uint32_t sleepMs = LOOP_POLL_MS;
+  for (uint8_t i = 0; i < s_slotCount; i++) {
+    if (!s_slots[i].pending) continue;
+    uint32_t dueMs = before(nowMs, s_slots[i].atMs) ? s_slots[i].atMs - nowMs : 0;
+    if (dueMs < sleepMs) sleepMs = dueMs;
+  }
+  if (s_wakePending) {
+    uint32_t dueMs = before(nowMs, s_wakeAtMs) ? s_wakeAtMs - nowMs : 0;
+    if (dueMs < sleepMs) sleepMs = dueMs;
+  }
+
+  // A wake-up given during the last pass returns at once
+  if (sleepMs > 0 && s_loopTask) ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(sleepMs));
+
+  nowMs = millis();
+  if (s_wakePending && !before(nowMs, s_wakeAtMs)) s_wakePending = false;
+  for (uint8_t i = 0; i < s_slotCount; i++) {
+    LoopSlot& slot = s_slots[i];
+    if (slot.pending && !before(nowMs, slot.atMs)) {
+      slot.pending = false;
+      slot.callback(slot.arg);
+    }
+  }
+}
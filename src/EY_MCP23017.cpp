@@ -0,0 +1,145 @@
+#include "EY_Config.h"  // Must be first — brings in PROP_CONFIG which may define HAS_MCP23017
+
+#ifdef HAS_MCP23017
+
+#include "EY_MCP23017.h"
+#include "EY_Inputs.h"
+
+#include <Wire.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static_assert(MCP23017_COUNT >= 1 && MCP23017_COUNT <= 8, "MCP23017 supports 1-8 chips (addresses 0x20-0x27)");
+
+// Registers (IOCON.BANK = 0, A/B pairs interleaved)
+static constexpr uint8_t REG_GPINTENA = 0x04;
+static constexpr uint8_t REG_INTCONA  = 0x08;
+static constexpr uint8_t REG_IOCON    = 0x0A;
+static constexpr uint8_t REG_GPPUA    = 0x0C;
+static constexpr uint8_t REG_GPIOA    = 0x12;
+
+// IOCON: MIRROR (INTA covers both ports) | ODR (open-drain INT, shareable)
+static constexpr uint8_t IOCON_MIRROR_ODR = 0x44;
+
+static constexpr unsigned long MCP23017_I2C_HZ    = 400000;
+static constexpr unsigned long MCP23017_RESYNC_MS = 100;  // Full read even without INT
+
+static constexpr uint64_t buildIntPinMask() {
+  uint64_t mask = 0;
+  for (uint8_t i = 0; i < MCP23017_COUNT; i++) mask |= EY_PinBit(MCP23017_CHIPS[i].intPin);
+  return mask;
+}
+static constexpr uint64_t INT_PIN_MASK = buildIntPinMask();
+
+// Bank words: chips 0-3 in EY_BANK_MCP23017, 4-7 in the next bank
+static uint64_t s_words[2] = {0, 0};
+static unsigned long s_lastResyncMs = 0;
+static volatile uint32_t s_resyncUs = 0;
+static TaskHandle_t s_task = nullptr;
+
+static bool writePair(uint8_t address, uint8_t regA, uint8_t valueA, uint8_t valueB) {
+  Wire.beginTransmission(address);
+  Wire.write(regA);
+  Wire.write(valueA);
+  Wire.write(valueB);  // Sequential mode: regA + 1 = port B
+  return Wire.endTransmission() == 0;
+}
+
+// One burst read of GPIOA + GPIOB (also clears the chip's interrupt)
+static bool readPorts(uint8_t address, uint16_t& ports) {
+  Wire.beginTransmission(address);
+  Wire.write(REG_GPIOA);
+  if (Wire.endTransmission(false) != 0) return false;
+  if (Wire.requestFrom(address, (uint8_t)2) != 2) return false;
+  uint8_t a = Wire.read();
+  uint8_t b = Wire.read();
+  ports = (uint16_t)(a | (b << 8));
+  return true;
+}
+
+static void storeChip(uint8_t chip, uint16_t ports) {
+  uint64_t& word = s_words[chip / 4];
+  uint8_t shift = (chip % 4) * 16;
+  word = (word & ~(0xFFFFULL << shift)) | ((uint64_t)ports << shift);
+}
+
+static void publish() {
+  EY_Inputs_PublishBank(EY_BANK_MCP23017, s_words[0]);
+  if (MCP23017_COUNT > 4) EY_Inputs_PublishBank(EY_BANK_MCP23017 + 1, s_words[1]);
+}
+
+// Read the chips asserting INT (active LOW), or every chip on a resync
+static void readChips(bool resync) {
+  uint64_t startUs = (uint64_t)esp_timer_get_time();
+  uint64_t gpio = EY_Inputs_Read();
+  bool changed = false;
+  for (uint8_t i = 0; i < MCP23017_COUNT; i++) {
+    if (!resync && EY_Inputs_PinHigh(gpio, MCP23017_CHIPS[i].intPin)) continue;
+    uint16_t ports;
+    if (readPorts(MCP23017_CHIPS[i].address, ports)) {
+      storeChip(i, ports);
+      changed = true;
+    }
+  }
+  if (changed) publish();
+  if (resync) s_resyncUs = (uint32_t)((uint64_t)esp_timer_get_time() - startUs);
+}
+
+// Read task: the I2C reads block (up to the bus timeout on a stuck bus),
+// so they stay out of the sampler. Woken by the sampler when an INT line
+// is LOW, and on its own every MCP23017_RESYNC_MS.
+static void mcpTask(void*) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(MCP23017_RESYNC_MS));
+    unsigned long now = millis();
+    bool resync = (now - s_lastResyncMs >= MCP23017_RESYNC_MS);
+    if (resync) s_lastResyncMs = now;
+    readChips(resync);
+  }
+}
+
+// Sampler hook: only checks the INT lines. A line stays LOW until its chip
+// is read, so repeated wake-ups coalesce into one pass.
+static void poll(uint64_t gpio) {
+  if ((~gpio & INT_PIN_MASK) != 0 && s_task) xTaskNotifyGive(s_task);
+}
+
+void EY_MCP23017_Begin() {
+  Wire.begin(MCP23017_SDA_PIN, MCP23017_SCL_PIN, MCP23017_I2C_HZ);
+
+  for (uint8_t i = 0; i < MCP23017_COUNT; i++) {
+    const Mcp23017Def& chip = MCP23017_CHIPS[i];
+    // Input-only pins (34-39) have no internal pull-up — need external 10kΩ
+    pinMode(chip.intPin, chip.intPin < 34 ? INPUT_PULLUP : INPUT);
+
+    // Power-on default is all inputs (IODIR = 0xFF); add pull-ups and
+    // interrupt-on-change against the previous value.
+    bool ok = writePair(chip.address, REG_IOCON, IOCON_MIRROR_ODR, IOCON_MIRROR_ODR) &&
+              writePair(chip.address, REG_GPPUA, 0xFF, 0xFF) &&
+              writePair(chip.address, REG_INTCONA, 0x00, 0x00) &&
+              writePair(chip.address, REG_GPINTENA, 0xFF, 0xFF);
+
+    uint16_t ports = 0xFFFF;  // pulled-up idle level if the chip is missing
+    if (ok) ok = readPorts(chip.address, ports);
+    storeChip(i, ports);
+
+    Serial.print("[MCP23017] Chip ");
+    Serial.print(i);
+    Serial.print(" @0x");
+    Serial.print(chip.address, HEX);
+    Serial.println(ok ? " ready" : " NOT RESPONDING");
+  }
+  publish();
+  s_lastResyncMs = millis();
+
+  // Core 0 below the esp_timer task; Wire serialises it with other bus users
+  xTaskCreatePinnedToCore(mcpTask, "ey_mcp23017", 3072, nullptr, 3, &s_task, 0);
+  EY_Inputs_AddPoller(&poll);
+}
+
+uint32_t EY_MCP23017_GetResyncUs() {
+  return s_resyncUs;
+}
+
+#endif // HAS_MCP23017
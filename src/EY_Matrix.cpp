@@ -0,0 +1,152 @@
+#include "EY_Config.h"  // Must be first — brings in PROP_CONFIG which may define HAS_MATRIX
+
+#ifdef HAS_MATRIX
+
+#include "EY_Matrix.h"
+#include "EY_Inputs.h"
+
+#include <soc/soc.h>
+#include <soc/gpio_reg.h>
+
+#ifndef MATRIX_SETTLE_US
+  #define MATRIX_SETTLE_US 3
+#endif
+
+static_assert(MATRIX_ROWS >= 1 && MATRIX_ROWS <= 8, "Matrix supports 1-8 rows");
+static_assert(MATRIX_COLS >= 1 && MATRIX_COLS <= 8, "Matrix supports 1-8 columns");
+
+static constexpr bool validRowPins() {
+  for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+    if (MATRIX_ROW_PINS[r] > 33) return false;
+  }
+  return true;
+}
+static_assert(validRowPins(), "MATRIX_ROW_PINS must be output-capable GPIOs 0-33");
+
+static constexpr uint32_t buildRowMask(bool high) {
+  uint32_t mask = 0;
+  for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+    uint8_t pin = MATRIX_ROW_PINS[r];
+    if (high ? pin >= 32 : pin < 32) mask |= 1UL << (pin % 32);
+  }
+  return mask;
+}
+static constexpr uint32_t ROWS_OUT  = buildRowMask(false);  // GPIO_OUT_* bits
+static constexpr uint32_t ROWS_OUT1 = buildRowMask(true);   // GPIO_OUT1_* bits
+
+static constexpr uint64_t buildColMask() {
+  uint64_t mask = 0;
+  for (uint8_t c = 0; c < MATRIX_COLS; c++) mask |= EY_PinBit(MATRIX_COL_PINS[c]);
+  return mask;
+}
+static_assert(buildColMask() != 0 && __builtin_popcountll(buildColMask()) == MATRIX_COLS,
+              "MATRIX_COL_PINS must be distinct GPIOs 0-39");
+
+static uint64_t s_keys = 0;          // Published word: bit row*8+col = key down
+static uint32_t s_ghosts = 0;
+
+static void driveRows(uint32_t out, uint32_t out1, bool low) {
+  if (out)  REG_WRITE(low ? GPIO_OUT_W1TC_REG : GPIO_OUT_W1TS_REG, out);
+  if (out1) REG_WRITE(low ? GPIO_OUT1_W1TC_REG : GPIO_OUT1_W1TS_REG, out1);
+}
+
+// Columns pulled LOW by a pressed key, as bits 0..MATRIX_COLS-1
+static uint8_t readCols() {
+  uint64_t gpio = EY_Inputs_Read();
+  uint8_t cols = 0;
+  for (uint8_t c = 0; c < MATRIX_COLS; c++) {
+    if (!EY_Inputs_PinHigh(gpio, MATRIX_COL_PINS[c])) cols |= (uint8_t)(1 << c);
+  }
+  return cols;
+}
+
+#ifndef MATRIX_HAS_DIODES
+// Without diodes, three keys on the corners of a rectangle make the fourth
+// corner read as pressed. Any two rows sharing two or more columns form such
+// a rectangle: those keys can't be told apart, so they keep their last level.
+static uint64_t ghostMask(const uint8_t rows[MATRIX_ROWS]) {
+  uint64_t ambiguous = 0;
+  for (uint8_t i = 0; i < MATRIX_ROWS; i++) {
+    for (uint8_t j = i + 1; j < MATRIX_ROWS; j++) {
+      uint8_t shared = rows[i] & rows[j];
+      if (__builtin_popcount(shared) < 2) continue;
+      ambiguous |= (uint64_t)shared << (i * 8);
+      ambiguous |= (uint64_t)shared << (j * 8);
+    }
+  }
+  return ambiguous;
+}
+#endif
+
+// Sampler hook
+static void poll(uint64_t) {
+  // "Any key" check: all rows LOW, one read. Idle grid = one register read.
+  driveRows(ROWS_OUT, ROWS_OUT1, true);
+  delayMicroseconds(MATRIX_SETTLE_US);
+  uint8_t any = readCols();
+  driveRows(ROWS_OUT, ROWS_OUT1, false);
+  if (any == 0) {
+    if (s_keys != 0) {
+      s_keys = 0;
+      EY_Inputs_PublishBank(EY_BANK_MATRIX, 0);
+    }
+    return;
+  }
+
+  uint8_t rows[MATRIX_ROWS];
+  uint64_t keys = 0;
+  for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+    uint8_t pin = MATRIX_ROW_PINS[r];
+    uint32_t bit = 1UL << (pin % 32);
+    driveRows(pin < 32 ? bit : 0, pin < 32 ? 0 : bit, true);
+    delayMicroseconds(MATRIX_SETTLE_US);
+    rows[r] = readCols();
+    driveRows(pin < 32 ? bit : 0, pin < 32 ? 0 : bit, false);
+    keys |= (uint64_t)rows[r] << (r * 8);
+  }
+
+#ifndef MATRIX_HAS_DIODES
+  uint64_t ambiguous = ghostMask(rows);
+  if (ambiguous) {
+    keys = (keys & ~ambiguous) | (s_keys & ambiguous);
+    s_ghosts++;
+  }
+#endif
+
+  if (keys != s_keys) {
+    s_keys = keys;
+    EY_Inputs_PublishBank(EY_BANK_MATRIX, keys);
+  }
+}
+
+void EY_Matrix_Begin() {
+  for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+    // Open-drain: an idle row floats HIGH through the column pull-ups, so
+    // two pressed keys in one column never short two driven rows.
+    pinMode(MATRIX_ROW_PINS[r], OUTPUT_OPEN_DRAIN);
+    digitalWrite(MATRIX_ROW_PINS[r], HIGH);
+  }
+  for (uint8_t c = 0; c < MATRIX_COLS; c++) {
+    // Input-only pins (34-39) have no internal pull-up — need external 10kΩ
+    pinMode(MATRIX_COL_PINS[c], MATRIX_COL_PINS[c] < 34 ? INPUT_PULLUP : INPUT);
+  }
+
+  poll(0);  // First frame before the sampler starts
+  EY_Inputs_AddPoller(&poll);
+
+  Serial.print("[Matrix] ");
+  Serial.print(MATRIX_ROWS);
+  Serial.print("x");
+  Serial.print(MATRIX_COLS);
+#ifdef MATRIX_HAS_DIODES
+  Serial.println(" keys (diodes, no ghost detection)");
+#else
+  Serial.println(" keys");
+#endif
+}
+
+uint32_t EY_Matrix_GhostCount() {
+  return s_ghosts;
+}
+
+#endif // HAS_MATRIX
@@ -2,6 +2,9 @@
 #include "EY_Config.h"
 #include "EY_Sensors.h"
 #include "EY_Outputs.h"
+#include "EY_EdgeLog.h"
+#include "EY_Rhythm.h"
+#include "EY_Inputs.h"
 
 #ifdef HAS_SHAKER
 #include "EY_Shaker.h"
@@ -19,6 +22,34 @@
 #include "EY_Bobine.h"
 #endif
 
+#ifdef HAS_ANALOG
+#include "EY_Analog.h"
+#endif
+
+#ifdef HAS_MCP23017
+#include "EY_MCP23017.h"
+#endif
+
+#ifdef HAS_WHEEL
+#include "EY_Wheel.h"
+#endif
+
+#ifdef HAS_RFID
+#include "EY_RFID.h"
+#endif
+
+#ifdef HAS_NODES
+#include "EY_Nodes.h"
+#endif
+
+#ifdef HAS_SERVO
+#include "EY_Servo.h"
+#endif
+
+#ifdef HAS_STEPPER
+#include "EY_Stepper.h"
+#endif
+
 #include <WiFi.h>
 #include <PubSubClient.h>
 #include <ArduinoJson.h>
@@ -45,33 +76,103 @@ static unsigned long getTimestamp() {
   return millis();                                    // Fallback
 }
 
+// Virtual propId of a puzzle group (the board's DEVICE_ID unless the prop
+// declares PUZZLE_GROUPS[])
+static const char* groupPropId(uint8_t group) {
+  return PUZZLE_GROUPS[group].propId ? PUZZLE_GROUPS[group].propId : DEVICE_ID;
+}
+
+static const char* groupName(uint8_t group) {
+  return PUZZLE_GROUPS[group].name ? PUZZLE_GROUPS[group].name : DEVICE_NAME;
+}
+
 // Topic helpers following contract: ey/<site>/<room>/prop/<propId>/...
-static String buildTopicBase() {
-  return String("ey/") + SITE_ID + "/" + ROOM_ID + "/prop/" + DEVICE_ID;
+static String buildTopicBase(const char* propId = DEVICE_ID) {
+  return String("ey/") + SITE_ID + "/" + ROOM_ID + "/prop/" + propId;
+}
+
+static String buildStatusTopic(uint8_t group) {
+  return buildTopicBase(groupPropId(group)) + "/status";
 }
 
-static String buildStatusTopic() {
-  return buildTopicBase() + "/status";
+static String buildEventTopic(uint8_t group) {
+  return buildTopicBase(groupPropId(group)) + "/event";
 }
 
-static String buildEventTopic() {
-  return buildTopicBase() + "/event";
+static String buildDiagTopic() {
+  return buildTopicBase() + "/diag";
 }
 
-static String buildCmdTopic() {
-  return buildTopicBase() + "/cmd";
+static String buildCmdTopic(const char* propId = DEVICE_ID) {
+  return buildTopicBase(propId) + "/cmd";
 }
 
-static String buildLwtTopic() {
-  return buildTopicBase() + "/lwt";
+static String buildLwtTopic(const char* propId = DEVICE_ID) {
+  return buildTopicBase(propId) + "/lwt";
 }
 
 static String buildBroadcastCmdTopic() {
   return String("ey/") + SITE_ID + "/" + ROOM_ID + "/all/cmd";
 }
 
+// Puzzle group a command topic addresses: a group's own cmd topic, or
+// EY_ALL_GROUPS for the board's and the room broadcast topic
+static uint8_t commandGroup(const char* topic) {
+  for (uint8_t g = 0; g < PUZZLE_GROUP_COUNT; g++) {
+    if (strcmp(groupPropId(g), DEVICE_ID) == 0) continue;
+    if (buildCmdTopic(groupPropId(g)) == topic) return g;
+  }
+  return EY_ALL_GROUPS;
+}
+
+// set_output modes "move" / "home" / "stop": servo `id` to `angle` over
+// `ms`, or stepper `id` to `position` at `speed`. Returns false if `mode`
+// is not a motion mode.
+static bool moveMotor(uint8_t group, const char* id, const char* mode, JsonObject params) {
+  bool move = strcmp(mode, "move") == 0;
+  bool home = strcmp(mode, "home") == 0;
+  bool stop = strcmp(mode, "stop") == 0;
+  if (!move && !home && !stop) return false;
+#ifdef HAS_SERVO
+  int8_t servo = EY_Servo_Find(group, id);
+  if (servo >= 0) {
+    float angle = params["angle"] | -1.0f;
+    if (!move) {
+      Serial.println("CMD: set_output — servos only take mode move");
+    } else if (angle < 0 || angle > 180) {
+      Serial.println("CMD: set_output — move needs an angle (0-180)");
+    } else {
+      const char* profile = params["profile"] | "ease";
+      ServoProfile shape = ServoProfile::EASE;
+      if (strcmp(profile, "linear") == 0) shape = ServoProfile::LINEAR;
+      else if (strcmp(profile, "trapezoid") == 0) shape = ServoProfile::TRAPEZOID;
+      EY_Servo_Move(servo, angle, params["ms"] | 0, shape);
+    }
+    return true;
+  }
+#endif
+#ifdef HAS_STEPPER
+  int8_t stepper = EY_Stepper_Find(group, id);
+  if (stepper >= 0) {
+    if (home) {
+      EY_Stepper_Home(stepper);
+    } else if (stop) {
+      EY_Stepper_Stop(stepper);
+    } else if (!params["position"].is<int32_t>()) {
+      Serial.println("CMD: set_output — move needs a position (steps from home)");
+    } else {
+      EY_Stepper_MoveTo(stepper, params["position"].as<int32_t>(), params["speed"] | 0);
+    }
+    return true;
+  }
+#endif
+  (void)group; (void)id; (void)move; (void)home; (void)stop; (void)params;
+  Serial.println("CMD: set_output — unknown servo / stepper");
+  return true;
+}
+
 static void mqttCallback(char* topic, byte* payload, unsigned int length) {
-  (void)topic;
+  uint8_t group = commandGroup(topic);
 
   // Copy payload to a null-terminated buffer
   char buf[256];
@@ -88,12 +189,26 @@ static void mqttCallback(char* topic, byte* payload, unsigned int length) {
   //   Contract v1 (preferred):
   //     - {"type":"cmd","command":"reset",...}
   //     - {"type":"cmd","command":"force_solved",...}
+  //     - {"type":"cmd","command":"set_output","params":{"outputId":"smoke","mode":"pulse","ms":800}}
+  //         mode: "on" | "off" | "pulse" (ms) | "pattern" (onMs, offMs, count; 0 = until stopped)
+  //     - {"type":"cmd","command":"set_output","params":{"outputId":"trapdoor","mode":"move","angle":90,"ms":1500}}
+  //         servo move (HAS_SERVO); optional "profile": "linear" | "trapezoid" | "ease" (default)
+  //     - {"type":"cmd","command":"set_output","params":{"outputId":"reveal","mode":"move","position":3200,"speed":800}}
+  //         stepper move in steps from home (HAS_STEPPER); optional "speed" steps/s (default maxSpeed);
+  //         also mode "home" (seek the home switch) and "stop" (decelerate to a stop)
+  //     - {"type":"cmd","command":"set_output","sensorId":"star1"}  (legacy: force-trigger a sensor)
 
   bool isReset = false;
   bool isForceSolved = false;
   bool isArm = false;
   bool isOpen = false;
+  bool isDumpEdges = false;
   const char* triggerSensorId = nullptr;
+  const char* outputId = nullptr;
+  const char* outputMode = "on";
+  uint32_t outputMs = 0, outputOffMs = 0;
+  uint16_t outputCount = 0;
+  JsonObject outputParams;
   const char* cmdSource = EY_MQTT::SRC_GM;
 #ifdef HAS_BOBINE
   bool isBobineStart = false;
@@ -124,11 +239,25 @@ static void mqttCallback(char* topic, byte* payload, unsigned int length) {
         } else if (strcmp(command, "arm") == 0) {
           isArm = true;
         } else if (strcmp(command, "set_output") == 0) {
-          triggerSensorId = doc["sensorId"];
+          JsonObject params = doc["params"];
+          outputId = params["outputId"];
+          if (outputId) {
+            outputMode = params["mode"] | "on";
+            outputMs = params["ms"] | 0;
+            if (outputMs == 0) outputMs = params["onMs"] | 0;
+            outputOffMs = params["offMs"] | 0;
+            outputCount = params["count"] | 0;
+            outputParams = params;  // Motion modes read their own params
+          } else {
+            triggerSensorId = doc["sensorId"];
+          }
         } else if (strcmp(command, "open") == 0) {
           // Release this prop's output(s) — e.g. the gadgets trapdoor maglock —
           // WITHOUT marking the prop solved (decoupled from the puzzle).
           isOpen = true;
+        } else if (strcmp(command, "dump_edges") == 0) {
+          // Diagnostics: sensor edge flight recorder (EY_EdgeLog.h)
+          isDumpEdges = true;
         }
 #ifdef HAS_BOBINE
         else if (strcmp(command, "start_sequence") == 0) {
@@ -153,23 +282,28 @@ static void mqttCallback(char* topic, byte* payload, unsigned int length) {
   // Execute actions
   if (isReset && s_onReset) {
     Serial.println("[DEBUG] Reset triggered by MQTT command");
-    s_onReset();
+    s_onReset(group);
   }
 
   if (isForceSolved && s_onSetSolved) {
     Serial.print("CMD: force_solved from ");
     Serial.println(cmdSource);
-    s_onSetSolved(true, cmdSource);
+    s_onSetSolved(group, true, cmdSource);
   }
 
   if (isArm && s_onArm) {
     Serial.println("CMD: arm");
-    s_onArm();
+    s_onArm(group);
   }
 
   if (isOpen) {
     Serial.println("CMD: open (release maglock, no solve)");
-    EY_Outputs_Release();
+    EY_Outputs_Release(group);
+  }
+
+  if (isDumpEdges) {
+    Serial.println("CMD: dump_edges");
+    EY_EdgeLog_Dump();
   }
 
   if (triggerSensorId) {
@@ -177,7 +311,33 @@ static void mqttCallback(char* topic, byte* payload, unsigned int length) {
     Serial.print(triggerSensorId);
     Serial.print(" from ");
     Serial.println(cmdSource);
-    EY_Sensors_ForceTrigger(triggerSensorId);
+    EY_Sensors_ForceTrigger(group, triggerSensorId);
+  }
+
+  if (outputId) {
+    Serial.print("CMD: set_output outputId=");
+    Serial.print(outputId);
+    Serial.print(" mode=");
+    Serial.print(outputMode);
+    Serial.print(" from ");
+    Serial.println(cmdSource);
+
+    int8_t index = EY_Outputs_Find(group, outputId);
+    if (moveMotor(group, outputId, outputMode, outputParams)) {
+      // Servo / stepper
+    } else if (index < 0) {
+      Serial.println("CMD: set_output — unknown outputId");
+    } else if (strcmp(outputMode, "on") == 0) {
+      EY_Outputs_Set(index, true);
+    } else if (strcmp(outputMode, "off") == 0) {
+      EY_Outputs_Set(index, false);
+    } else if (strcmp(outputMode, "pulse") == 0) {
+      EY_Outputs_Pulse(index, outputMs);
+    } else if (strcmp(outputMode, "pattern") == 0) {
+      EY_Outputs_Pattern(index, outputMs, outputOffMs, outputCount);
+    } else {
+      Serial.println("CMD: set_output — unknown mode");
+    }
   }
 
 #ifdef HAS_BOBINE
@@ -223,6 +383,16 @@ static void wifiTick() {
   WiFi.begin(WIFI_SSID, WIFI_PASS);
 }
 
+static void publishOnline(const char* propId) {
+  StaticJsonDocument<128> onlineDoc;
+  onlineDoc[EY_MQTT::F_PROP_ID] = propId;
+  onlineDoc[EY_MQTT::F_ONLINE] = true;
+
+  char onlinePayload[128];
+  unsigned int len = serializeJson(onlineDoc, onlinePayload, sizeof(onlinePayload));
+  s_mqtt.publish(buildLwtTopic(propId).c_str(), (const uint8_t*)onlinePayload, len, true);  // retained
+}
+
 static void mqttTick() {
   if (WiFi.status() != WL_CONNECTED) return;
   if (s_mqtt.connected()) return;
@@ -266,13 +436,18 @@ static void mqttTick() {
     s_mqtt.subscribe(tAll.c_str());
 
     // Publish online=true on /lwt topic (retained)
-    StaticJsonDocument<128> onlineDoc;
-    onlineDoc[EY_MQTT::F_PROP_ID] = DEVICE_ID;
-    onlineDoc[EY_MQTT::F_ONLINE] = true;
-
-    char onlinePayload[128];
-    unsigned int len = serializeJson(onlineDoc, onlinePayload, sizeof(onlinePayload));
-    s_mqtt.publish(lwtTopic.c_str(), (const uint8_t*)onlinePayload, len, true);  // retained
+    publishOnline(DEVICE_ID);
+
+    // Puzzle groups: one cmd topic per virtual propId, but no /lwt of
+    // their own. The connection has a single will, on DEVICE_ID's /lwt,
+    // and a retained online:true that no will covers would never clear:
+    // a group's presence is its board's /lwt. Clear any retained flag an
+    // older build left on the group topics (empty retained payload).
+    for (uint8_t g = 0; g < PUZZLE_GROUP_COUNT; g++) {
+      if (strcmp(groupPropId(g), DEVICE_ID) == 0) continue;
+      s_mqtt.subscribe(buildCmdTopic(groupPropId(g)).c_str());
+      s_mqtt.publish(buildLwtTopic(groupPropId(g)).c_str(), (const uint8_t*)"", 0, true);
+    }
 
   } else {
     Serial.print("MQTT FAIL rc=");
@@ -330,7 +505,7 @@ void EY_PublishEventOk(const char* sensorName) {
 void EY_PublishSolved(bool solved) {
   // Legacy helper kept for backward compatibility.
   // Map to the new status contract using conservative defaults.
-  EY_PublishStatus(solved, EY_MQTT::SRC_DEVICE, false);
+  EY_PublishStatus(0, solved, EY_MQTT::SRC_DEVICE, false);
 }
 
 // ============================================================
@@ -338,17 +513,21 @@ void EY_PublishSolved(bool solved) {
 // ============================================================
 
 void EY_PublishEvent(const char* action, const char* source) {
+  EY_PublishGroupEvent(0, action, source);
+}
+
+void EY_PublishGroupEvent(uint8_t group, const char* action, const char* source) {
   if (!s_mqtt.connected()) return;
-  if (!action) return;
+  if (!action || group >= PUZZLE_GROUP_COUNT) return;
 
   StaticJsonDocument<256> doc;
   doc[EY_MQTT::F_TYPE] = EY_MQTT::TYPE_EVENT;
-  doc[EY_MQTT::F_PROP_ID] = DEVICE_ID;
+  doc[EY_MQTT::F_PROP_ID] = groupPropId(group);
   doc[EY_MQTT::F_ACTION] = action;
   doc[EY_MQTT::F_SOURCE] = source ? source : EY_MQTT::SRC_DEVICE;
   doc[EY_MQTT::F_TIMESTAMP] = getTimestamp();
 
-  String topic = buildEventTopic();
+  String topic = buildEventTopic(group);
   publishJson(topic, doc);
 
   Serial.print("Event: ");
@@ -364,7 +543,7 @@ void EY_PublishEventWithData(const char* action, const char* source, const char*
 
   StaticJsonDocument<256> doc;
   doc[EY_MQTT::F_TYPE] = EY_MQTT::TYPE_EVENT;
-  doc[EY_MQTT::F_PROP_ID] = DEVICE_ID;
+  doc[EY_MQTT::F_PROP_ID] = groupPropId(0);
   doc[EY_MQTT::F_ACTION] = action;
   doc[EY_MQTT::F_SOURCE] = source ? source : EY_MQTT::SRC_DEVICE;
   doc[EY_MQTT::F_TIMESTAMP] = getTimestamp();
@@ -373,7 +552,7 @@ void EY_PublishEventWithData(const char* action, const char* source, const char*
     doc[dataKey] = dataValue;
   }
 
-  String topic = buildEventTopic();
+  String topic = buildEventTopic(0);
   publishJson(topic, doc);
 
   Serial.print("Event: ");
@@ -390,14 +569,15 @@ void EY_PublishEventWithData(const char* action, const char* source, const char*
   Serial.println(")");
 }
 
-void EY_PublishStatus(bool solved, const char* lastChangeSource, bool overrideActive) {
+void EY_PublishStatus(uint8_t group, bool solved, const char* lastChangeSource, bool overrideActive) {
   if (!s_mqtt.connected()) return;
+  if (group >= PUZZLE_GROUP_COUNT) return;
 
   // Larger buffer to accommodate sensor + output details
   StaticJsonDocument<1024> doc;
   doc[EY_MQTT::F_TYPE] = EY_MQTT::TYPE_STATUS;
-  doc[EY_MQTT::F_PROP_ID] = DEVICE_ID;
-  doc["name"] = DEVICE_NAME;
+  doc[EY_MQTT::F_PROP_ID] = groupPropId(group);
+  doc["name"] = groupName(group);
   doc[EY_MQTT::F_ONLINE] = true;
   doc[EY_MQTT::F_SOLVED] = solved;
   doc[EY_MQTT::F_LAST_CHANGE_SOURCE] = lastChangeSource ? lastChangeSource : EY_MQTT::SRC_DEVICE;
@@ -409,64 +589,112 @@ void EY_PublishStatus(bool solved, const char* lastChangeSource, bool overrideAc
   JsonArray sensors = details.createNestedArray("sensors");
 
   uint8_t sensorCount = EY_Sensors_GetCount();
-  uint8_t seqIndex = EY_Sensors_GetSequenceIndex();  // 0 unless SOLVE_MODE == SEQUENCE
-  bool sequenceMode = (SOLVE_MODE == SolveMode::SEQUENCE);
+  SensorMask groupMask = EY_Sensors_GetGroupMask(group);
+  uint8_t seqIndex = EY_Sensors_GetSequenceIndex(group);  // 0 unless the group solves in SEQUENCE
+  SensorMask seqDone = EY_Sensors_GetSequenceDone(group);
+  bool sequenceMode = (PUZZLE_GROUPS[group].solveMode == SolveMode::SEQUENCE);
+
+  const SensorState& state = EY_Sensors_GetState();
 
   for (uint8_t i = 0; i < sensorCount; i++) {
-    const SensorState* state = EY_Sensors_GetState(i);
+    SensorMask bit = EY_SensorBit(i);
+    if (!(groupMask & bit)) continue;
     JsonObject sensor = sensors.createNestedObject();
     sensor["sensorId"] = SENSORS[i].id;
     // Decoratives always reflect current physical state (momentary feedback).
     // SEQUENCE non-decoratives: "triggered" = step completed (latched until reset).
-    // ANY/ALL non-decoratives:  "triggered" = currently present, or latched state
+    // Other non-decoratives:    "triggered" = currently present, or latched state
     //   for latching sensors (momentary-pulse readers that don't hold the line).
     bool triggered;
-    if (SENSORS[i].decorative) {
-      triggered = state ? state->present : false;
+    if (state.decorative & bit) {
+      triggered = (state.present & bit) != 0;
     } else if (sequenceMode) {
-      triggered = (i < seqIndex);
+      triggered = (seqDone & bit) != 0;
     } else if (SENSORS[i].latching) {
-      triggered = state ? state->latched : false;
+      triggered = (state.latched & bit) != 0;
     } else {
-      triggered = state ? state->present : false;
+      triggered = (state.present & bit) != 0;
     }
     sensor["triggered"] = triggered;
+#if defined(HAS_ANALOG) && defined(ANALOG_REPORT_RAW)
+    if (EY_IsAnalog(SENSORS[i].presentWhen)) sensor["raw"] = EY_Analog_GetValue((uint8_t)SENSORS[i].pin);
+#endif
   }
 
   if (sequenceMode) {
     details["sequenceProgress"] = seqIndex;
   }
 
+  if (PUZZLE_GROUPS[group].solveMode == SolveMode::RHYTHM) {
+    details["rhythmProgress"] = EY_Rhythm_GetProgress(group);
+    details["rhythmQuality"] = EY_Rhythm_GetQuality(group);
+  }
+
+  // Player solve: accepted input change -> outputs released (register write)
+  uint64_t solvedAtUs = EY_Sensors_GetSolvedAtUs(group);
+  uint64_t releasedAtUs = EY_Outputs_GetReleasedAtUs(group);
+  if (solved && solvedAtUs && releasedAtUs >= solvedAtUs) {
+    details["releaseLatencyUs"] = (uint32_t)(releasedAtUs - solvedAtUs);
+  }
+
+#ifdef HAS_PUZZLE_GROUPS
+  // Board serving this group, whose /lwt is the group's presence
+  details["board"] = DEVICE_ID;
+#endif
+
+  // Board-level modules report with the first group
+  if (group == 0) {
+    details["inputScanUs"] = EY_Inputs_TakeScanMaxUs();
+
+#ifdef HAS_MCP23017
+    details["mcpResyncUs"] = EY_MCP23017_GetResyncUs();
+#endif
+
 #ifdef HAS_SHAKER
-  // Add shake progress (0-100) for GM visibility
-  details["shakeProgress"] = EY_Shaker_GetProgress();
+    // Add shake progress (0-100) for GM visibility
+    details["shakeProgress"] = EY_Shaker_GetProgress();
 #endif
 
 #ifdef HAS_SIMON
-  details["simonProgress"] = EY_Simon_GetProgress();
-  details["simonLocked"] = EY_Simon_GetLockedCount();
+    details["simonProgress"] = EY_Simon_GetProgress();
+    details["simonLocked"] = EY_Simon_GetLockedCount();
+#endif
+
+#ifdef HAS_WHEEL
+    details["wheelSegment"] = EY_Wheel_GetSegment();
+    details["wheelRpm"] = EY_Wheel_GetRpm();
+#endif
+
+#ifdef HAS_RFID
+    details["rfidRoundMs"] = EY_RFID_GetRoundUs() / 1000.0f;
+    details["rfidRoundMaxMs"] = EY_RFID_TakeRoundMaxUs() / 1000.0f;
+#endif
+
+#ifdef HAS_NODES
+    details["nodesOnline"] = EY_Nodes_GetOnlineCount();
 #endif
 
 #ifdef HAS_VEHICLES
-  details["vehiclesProgress"] = EY_Vehicles_GetProgress();
-  details["vehiclesCorrect"] = EY_Vehicles_GetCorrectCount();
+    details["vehiclesProgress"] = EY_Vehicles_GetProgress();
+    details["vehiclesCorrect"] = EY_Vehicles_GetCorrectCount();
 #endif
+  }
 
   // Add output-level details
   uint8_t outputCount = EY_Outputs_GetCount();
-  if (outputCount > 0) {
-    JsonArray outputs = details.createNestedArray("outputs");
-    for (uint8_t i = 0; i < outputCount; i++) {
-      JsonObject output = outputs.createNestedObject();
-      output["outputId"] = OUTPUTS[i].id;
-      OutputPinState oState = EY_Outputs_GetState(i);
-      output["state"] = (oState == OutputPinState::ARMED) ? "armed"
-                       : (oState == OutputPinState::RELEASED) ? "released"
-                       : "inactive";
-    }
+  JsonArray outputs;
+  for (uint8_t i = 0; i < outputCount; i++) {
+    if (OUTPUTS[i].group != group) continue;
+    if (outputs.isNull()) outputs = details.createNestedArray("outputs");
+    JsonObject output = outputs.createNestedObject();
+    output["outputId"] = OUTPUTS[i].id;
+    OutputPinState oState = EY_Outputs_GetState(i);
+    output["state"] = (oState == OutputPinState::ARMED) ? "armed"
+                     : (oState == OutputPinState::RELEASED) ? "released"
+                     : "inactive";
   }
 
-  String topic = buildStatusTopic();
+  String topic = buildStatusTopic(group);
 
   // Status messages are RETAINED per contract
   char out[768];
@@ -477,13 +705,25 @@ void EY_PublishStatus(bool solved, const char* lastChangeSource, bool overrideAc
     Serial.print("MQTT publish failed on ");
     Serial.println(topic);
   } else {
-    Serial.print("Status: solved=");
+    Serial.print("Status ");
+    Serial.print(groupPropId(group));
+    Serial.print(": solved=");
     Serial.print(solved ? "true" : "false");
     Serial.print(", source=");
     Serial.print(lastChangeSource ? lastChangeSource : "device");
     Serial.print(", override=");
     Serial.print(overrideActive ? "true" : "false");
     Serial.print(", sensors=");
-    Serial.println(sensorCount);
+    Serial.println(__builtin_popcountll(groupMask));
+  }
+}
+
+void EY_PublishDiag(const char* payload, size_t len) {
+  if (!s_mqtt.connected() || !payload) return;
+
+  String topic = buildDiagTopic();
+  if (!s_mqtt.publish(topic.c_str(), (const uint8_t*)payload, len, false)) {
+    Serial.print("MQTT publish failed on ");
+    Serial.println(topic);
   }
 }
@@ -0,0 +1,259 @@
+#include "EY_Config.h"  // Must be first — brings in PROP_CONFIG which may define HAS_NODES
+
+#ifdef HAS_NODES
+
+#if defined(HAS_SHAKER)
+  #error "HAS_NODES and HAS_SHAKER both need the ESP-NOW receive callback"
+#endif
+
+#include "EY_Nodes.h"
+#include "EY_Inputs.h"
+#include "EY_Mqtt.h"
+
+#include <esp_now.h>
+#include <WiFi.h>
+#include <ArduinoJson.h>
+
+#ifndef NODE_TIMEOUT_MS
+  #define NODE_TIMEOUT_MS 5000
+#endif
+#ifndef NODE_STATS_MS
+  #define NODE_STATS_MS 60000
+#endif
+
+static_assert(NODE_COUNT >= 1 && NODE_COUNT <= 8, "NODE_COUNT must be 1-8 (8 channels each, one input bank)");
+
+static constexpr uint8_t NODE_MAGIC      = 0xE5;
+static constexpr uint8_t NODE_VERSION    = 1;
+static constexpr uint8_t NODE_MAX_BATCH  = 16;   // Change records per packet
+static constexpr uint8_t NODE_RX_RING    = 16;   // Packets buffered between WiFi task and sampler
+static constexpr uint8_t NODE_PENDING    = 16;   // Changes queued per node, applied one per sample
+
+typedef struct __attribute__((packed)) {
+  uint16_t changeSeq;
+  uint8_t states;
+} NodeChange;
+
+typedef struct __attribute__((packed)) {
+  uint8_t magic;
+  uint8_t version;
+  uint8_t node;
+  uint8_t count;
+  uint16_t seq;
+  uint16_t battMv;
+  uint8_t states;
+  uint8_t reserved;
+  NodeChange changes[NODE_MAX_BATCH];
+} NodePacket;
+
+static constexpr size_t NODE_HEADER_BYTES = sizeof(NodePacket) - sizeof(NodeChange) * NODE_MAX_BATCH;
+
+struct NodeStats {
+  uint32_t rx;          // Packets accepted
+  uint32_t lost;        // Gaps in packet seq
+  uint32_t dup;         // Change records already applied
+  uint32_t recovered;   // Changes applied from a later packet than their own
+  uint16_t battMv;
+  uint32_t lastSeenMs;
+  bool seen;
+  bool online;
+};
+
+struct NodeState {
+  uint16_t lastSeq;
+  uint16_t lastChangeSeq;
+  uint8_t states;                 // Level currently published
+  uint8_t pending[NODE_PENDING];  // Accepted changes not yet published
+  uint8_t pendingHead;
+  uint8_t pendingCount;
+};
+
+// ---- WiFi task -> sampler ring (single producer, single consumer) ----
+struct RxSlot {
+  uint8_t len;
+  uint8_t data[sizeof(NodePacket)];
+};
+static RxSlot s_ring[NODE_RX_RING];
+static uint32_t s_ringHead = 0;  // Written by the WiFi task only
+static uint32_t s_ringTail = 0;  // Written by the sampler only
+static volatile uint32_t s_ringOverflows = 0;
+
+// ---- Sampler state ----
+static NodeState s_nodes[NODE_COUNT];
+static NodeStats s_stats[NODE_COUNT];
+static uint64_t s_bits = 0;  // Published word: bit node*8 + channel
+
+// ---- loop() state ----
+static bool s_espNowReady = false;
+static unsigned long s_lastStatsMs = 0;
+
+// WiFi task: copy and hand over, nothing else
+static void onEspNowRecv(const uint8_t*, const uint8_t* data, int len) {
+  if (len < (int)NODE_HEADER_BYTES || len > (int)sizeof(NodePacket) || data[0] != NODE_MAGIC) return;
+  uint32_t head = s_ringHead;
+  uint32_t tail = __atomic_load_n(&s_ringTail, __ATOMIC_ACQUIRE);
+  if (head - tail >= NODE_RX_RING) {
+    s_ringOverflows++;
+    return;
+  }
+  RxSlot& slot = s_ring[head % NODE_RX_RING];
+  slot.len = (uint8_t)len;
+  memcpy(slot.data, data, len);
+  __atomic_store_n(&s_ringHead, head + 1, __ATOMIC_RELEASE);
+}
+
+// Wrap-safe "a is after b" for 16-bit sequence numbers
+static bool seqAfter(uint16_t a, uint16_t b) {
+  return (int16_t)(a - b) > 0;
+}
+
+static void queueState(NodeState& n, uint8_t states) {
+  if (n.pendingCount == NODE_PENDING) {  // Full: drop the oldest, keep the newest
+    n.pendingHead = (uint8_t)((n.pendingHead + 1) % NODE_PENDING);
+    n.pendingCount--;
+  }
+  n.pending[(n.pendingHead + n.pendingCount) % NODE_PENDING] = states;
+  n.pendingCount++;
+}
+
+static void handlePacket(const NodePacket& pkt, uint8_t len, unsigned long now) {
+  if (pkt.version != NODE_VERSION || pkt.node >= NODE_COUNT) return;
+  if (pkt.count > NODE_MAX_BATCH || len != NODE_HEADER_BYTES + pkt.count * sizeof(NodeChange)) return;
+
+  NodeState& n = s_nodes[pkt.node];
+  NodeStats& st = s_stats[pkt.node];
+
+  // First contact, or back after a timeout (the node may have rebooted and
+  // restarted its sequence numbers): take its current level, skip history.
+  bool first = !st.seen || !st.online;
+  if (!first) {
+    if (!seqAfter(pkt.seq, n.lastSeq)) return;  // Duplicate or reordered packet
+    st.lost += (uint16_t)(pkt.seq - n.lastSeq - 1);
+  }
+  n.lastSeq = pkt.seq;
+  st.seen = true;
+  st.online = true;
+  st.rx++;
+  st.battMv = pkt.battMv;
+  st.lastSeenMs = now;
+
+  if (first) {
+    if (pkt.count > 0) n.lastChangeSeq = pkt.changes[pkt.count - 1].changeSeq;
+    n.pendingCount = 0;
+    queueState(n, pkt.states);
+    return;
+  }
+
+  bool applied = false;
+  for (uint8_t i = 0; i < pkt.count; i++) {
+    const NodeChange& c = pkt.changes[i];
+    if (!seqAfter(c.changeSeq, n.lastChangeSeq)) {
+      st.dup++;
+      continue;
+    }
+    if (i + 1 < pkt.count) st.recovered++;  // Its own packet was lost
+    n.lastChangeSeq = c.changeSeq;
+    queueState(n, c.states);
+    applied = true;
+  }
+  // Changes fell out of the batch window: converge on the reported level
+  if (!applied && n.pendingCount == 0 && pkt.states != n.states) queueState(n, pkt.states);
+}
+
+// Sampler hook: drain the ring, then publish at most one change per node
+static void poll(uint64_t) {
+  unsigned long now = millis();
+  uint32_t tail = s_ringTail;
+  uint32_t head = __atomic_load_n(&s_ringHead, __ATOMIC_ACQUIRE);
+  while (tail != head) {
+    const RxSlot& slot = s_ring[tail % NODE_RX_RING];
+    NodePacket pkt = {};
+    memcpy(&pkt, slot.data, slot.len);
+    handlePacket(pkt, slot.len, now);
+    tail++;
+  }
+  __atomic_store_n(&s_ringTail, tail, __ATOMIC_RELEASE);
+
+  uint64_t bits = 0;
+  for (uint8_t i = 0; i < NODE_COUNT; i++) {
+    NodeState& n = s_nodes[i];
+    NodeStats& st = s_stats[i];
+    if (st.online && now - st.lastSeenMs >= NODE_TIMEOUT_MS) {
+      st.online = false;
+      n.pendingCount = 0;
+      n.states = 0;
+    }
+    if (n.pendingCount > 0) {
+      n.states = n.pending[n.pendingHead];
+      n.pendingHead = (uint8_t)((n.pendingHead + 1) % NODE_PENDING);
+      n.pendingCount--;
+    }
+    bits |= (uint64_t)n.states << (i * 8);
+  }
+  if (bits != s_bits) {
+    s_bits = bits;
+    EY_Inputs_PublishBank(EY_BANK_NODES, bits);
+  }
+}
+
+static void publishStats() {
+  unsigned long now = millis();
+  for (uint8_t i = 0; i < NODE_COUNT; i++) {
+    const NodeStats& st = s_stats[i];
+    StaticJsonDocument<256> doc;
+    doc[EY_MQTT::F_PROP_ID] = DEVICE_ID;
+    doc[EY_MQTT::F_TYPE] = "node_stats";
+    doc["node"] = i;
+    doc["online"] = st.online;
+    doc["rx"] = st.rx;
+    doc["lost"] = st.lost;
+    doc["dup"] = st.dup;
+    doc["recovered"] = st.recovered;
+    doc["battMv"] = st.battMv;
+    if (st.seen) doc["lastSeenMs"] = now - st.lastSeenMs;
+    char out[256];
+    size_t len = serializeJson(doc, out, sizeof(out));
+    EY_PublishDiag(out, len);
+  }
+  if (s_ringOverflows) {
+    Serial.print("[Nodes] Receive ring overflows: ");
+    Serial.println(s_ringOverflows);
+  }
+}
+
+void EY_Nodes_Begin() {
+  EY_Inputs_AddPoller(&poll);
+  Serial.print("[Nodes] ");
+  Serial.print(NODE_COUNT);
+  Serial.println(" ESP-NOW nodes (waiting for WiFi)");
+}
+
+void EY_Nodes_Tick() {
+  // Deferred ESP-NOW init — WiFi must be connected first (channel locked)
+  if (!s_espNowReady && WiFi.status() == WL_CONNECTED) {
+    if (esp_now_init() == ESP_OK) {
+      esp_now_register_recv_cb(onEspNowRecv);
+      s_espNowReady = true;
+      s_lastStatsMs = millis();
+      Serial.print("[Nodes] ESP-NOW receiver ready on WiFi channel ");
+      Serial.println(WiFi.channel());
+    } else {
+      Serial.println("[Nodes] ESP-NOW init failed!");
+    }
+  }
+
+  if (s_espNowReady && millis() - s_lastStatsMs >= NODE_STATS_MS) {
+    s_lastStatsMs = millis();
+    publishStats();
+  }
+}
+
+uint8_t EY_Nodes_GetOnlineCount() {
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < NODE_COUNT; i++) {
+    if (s_stats[i].online) count++;
+  }
+  return count;
+}
+
+#endif // HAS_NODES
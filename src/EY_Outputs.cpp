@@ -1,62 +1,280 @@
 #include "EY_Outputs.h"
 #include "EY_Config.h"
+#include "EY_Timer.h"
+
+#ifdef HAS_HC595
+#include "EY_HC595.h"
+#endif
+
+#ifdef HAS_PCA9685
+#include "EY_PCA9685.h"
+#endif
+
+#ifdef HAS_PIXELS
+#include "EY_Pixels.h"
+#endif
+
+#ifdef HAS_DMX
+#include "EY_DMX.h"
+#endif
 
 #include <Arduino.h>
+#include <esp_timer.h>
+#include <soc/soc.h>
+#include <soc/gpio_reg.h>
 
 // Runtime state array (handle zero-output case for props without outputs)
 static OutputPinState s_states[OUTPUT_COUNT > 0 ? OUTPUT_COUNT : 1];
 
-// Write a pin respecting activeLow polarity
-static void writePin(uint8_t index, bool activate) {
-  bool level = activate;
-  if (OUTPUTS[index].activeLow) level = !level;
-  digitalWrite(OUTPUTS[index].pin, level ? HIGH : LOW);
+// Pins of a set of outputs per bank (bit n = bit n of the virtual pin),
+// split by the level that activates them
+struct OutputMasks {
+  uint64_t high[EY_OUTPUT_BANKS];  // Driven HIGH when active (activeLow = false)
+  uint64_t low[EY_OUTPUT_BANKS];   // Driven LOW when active (activeLow = true)
+};
+
+// Index PUZZLE_GROUP_COUNT = every output (EY_ALL_GROUPS). Built once in
+// EY_Outputs_Begin (OUTPUTS[] is not constexpr in the prop configs).
+static OutputMasks s_masks[PUZZLE_GROUP_COUNT + 1];
+
+// Pin of each output, as a one-output set
+static OutputMasks s_pinMasks[OUTPUT_COUNT > 0 ? OUTPUT_COUNT : 1];
+
+// Pulse / pattern of one output, stepped by the shared timer service
+struct TimedOutput {
+  uint64_t nextUs;      // Next edge (esp_timer µs), 0 = no timed action
+  uint32_t onMs, offMs;
+  uint16_t cyclesLeft;  // On/off cycles still to run, 0 = until stopped
+  bool active;
+};
+
+static TimedOutput s_timed[OUTPUT_COUNT > 0 ? OUTPUT_COUNT : 1];
+static portMUX_TYPE s_timedMux = portMUX_INITIALIZER_UNLOCKED;
+static int8_t s_timer = -1;
+
+// esp_timer µs when each group's outputs were released (0 = not released
+// since the last arm/reset)
+static uint64_t s_releasedAtUs[PUZZLE_GROUP_COUNT];
+
+static bool inGroup(uint8_t index, uint8_t group) {
+  return group == EY_ALL_GROUPS || OUTPUTS[index].group == group;
 }
 
-void EY_Outputs_Begin() {
-  for (uint8_t i = 0; i < OUTPUT_COUNT; i++) {
-    pinMode(OUTPUTS[i].pin, OUTPUT);
-    s_states[i] = OutputPinState::INACTIVE;
-    writePin(i, false);  // Fail-safe: deactivated on boot
-    Serial.print("[Outputs] Pin ");
-    Serial.print(OUTPUTS[i].pin);
-    Serial.print(" (");
-    Serial.print(OUTPUTS[i].id);
-    Serial.println(") → INACTIVE");
+static const OutputMasks& masksFor(uint8_t group) {
+  return s_masks[(group < PUZZLE_GROUP_COUNT) ? group : PUZZLE_GROUP_COUNT];
+}
+
+static bool hasPins(const OutputMasks& m) {
+  uint64_t any = 0;
+  for (uint8_t b = 0; b < EY_OUTPUT_BANKS; b++) any |= m.high[b] | m.low[b];
+  return any != 0;
+}
+
+// Pin exists on an enabled bank
+static bool validPin(uint16_t pin) {
+  uint8_t bit = pin & 0xFF;
+  switch (EY_PinBank(pin)) {
+    case EY_OUT_BANK_GPIO:    return bit <= 33;
+#ifdef HAS_HC595
+    case EY_OUT_BANK_HC595:   return bit < HC595_CHIP_COUNT * 8;
+#endif
+#ifdef HAS_PCA9685
+    case EY_OUT_BANK_PCA9685: return bit < PCA9685_COUNT * 16;
+#endif
+#ifdef HAS_PIXELS
+    case EY_OUT_BANK_PIXELS:  return bit < PIXELS_COUNT && bit < 64;
+#endif
+#ifdef HAS_DMX
+    case EY_OUT_BANK_DMX:     return bit < DMX_CHANNELS && bit < 64;
+#endif
+    default:                  return false;
   }
 }
 
-void EY_Outputs_Arm() {
+static void addPin(OutputMasks& m, uint16_t pin, bool activeLow) {
+  uint64_t& word = activeLow ? m.low[EY_PinBank(pin)] : m.high[EY_PinBank(pin)];
+  word |= EY_PinBit(pin);
+}
+
+// Drive every output of a set at once: at most one W1TS and one W1TC write
+// per GPIO register, so all maglocks of a group switch together. Expander
+// banks only update their shadow (safe inside a critical section); returns
+// the banks to refresh with refreshBanks().
+static uint8_t writeMasks(const OutputMasks& m, bool activate) {
+  const uint64_t* set = activate ? m.high : m.low;
+  const uint64_t* clr = activate ? m.low : m.high;
+
+  // GPIO 0-31 on GPIO_OUT_W1TS/W1TC, GPIO 32-33 on GPIO_OUT1_W1TS/W1TC
+  uint32_t setLo = (uint32_t)set[EY_OUT_BANK_GPIO], setHi = (uint32_t)(set[EY_OUT_BANK_GPIO] >> 32);
+  uint32_t clrLo = (uint32_t)clr[EY_OUT_BANK_GPIO], clrHi = (uint32_t)(clr[EY_OUT_BANK_GPIO] >> 32);
+  if (setLo) REG_WRITE(GPIO_OUT_W1TS_REG, setLo);
+  if (clrLo) REG_WRITE(GPIO_OUT_W1TC_REG, clrLo);
+  if (setHi) REG_WRITE(GPIO_OUT1_W1TS_REG, setHi);
+  if (clrHi) REG_WRITE(GPIO_OUT1_W1TC_REG, clrHi);
+
+  uint8_t banks = 0;
+#ifdef HAS_HC595
+  if (EY_HC595_Write(set[EY_OUT_BANK_HC595], clr[EY_OUT_BANK_HC595])) banks |= 1 << EY_OUT_BANK_HC595;
+#endif
+#ifdef HAS_PCA9685
+  if (EY_PCA9685_Write(set[EY_OUT_BANK_PCA9685], clr[EY_OUT_BANK_PCA9685])) banks |= 1 << EY_OUT_BANK_PCA9685;
+#endif
+#ifdef HAS_PIXELS
+  if (EY_Pixels_Write(set[EY_OUT_BANK_PIXELS], clr[EY_OUT_BANK_PIXELS])) banks |= 1 << EY_OUT_BANK_PIXELS;
+#endif
+#ifdef HAS_DMX
+  EY_DMX_Write(set[EY_OUT_BANK_DMX], clr[EY_OUT_BANK_DMX]);  // Goes out with the next frame
+#endif
+  return banks;
+}
+
+// Send expander changes: one bus transaction per backend
+static void refreshBanks(uint8_t banks) {
+#ifdef HAS_HC595
+  if (banks & (1 << EY_OUT_BANK_HC595)) EY_HC595_Refresh();
+#endif
+#ifdef HAS_PCA9685
+  if (banks & (1 << EY_OUT_BANK_PCA9685)) EY_PCA9685_Refresh();
+#endif
+#ifdef HAS_PIXELS
+  if (banks & (1 << EY_OUT_BANK_PIXELS)) EY_Pixels_Refresh();
+#endif
+  (void)banks;
+}
+
+// Apply a state to one group (or all), then log — UART output never
+// delays the pins. Stops the group's pulses and patterns.
+static void applyState(uint8_t group, OutputPinState state, const char* label) {
+  portENTER_CRITICAL(&s_timedMux);
+  uint8_t banks = writeMasks(masksFor(group), state == OutputPinState::ARMED);
   for (uint8_t i = 0; i < OUTPUT_COUNT; i++) {
-    s_states[i] = OutputPinState::ARMED;
-    writePin(i, true);  // Activate (lock maglock)
+    if (inGroup(i, group)) s_timed[i].nextUs = 0;
+  }
+  portEXIT_CRITICAL(&s_timedMux);
+  refreshBanks(banks);
+  uint64_t nowUs = (uint64_t)esp_timer_get_time();
+
+  for (uint8_t g = 0; g < PUZZLE_GROUP_COUNT; g++) {
+    if ((group != EY_ALL_GROUPS && g != group) || !hasPins(s_masks[g])) continue;
+    if (state != OutputPinState::RELEASED) s_releasedAtUs[g] = 0;
+    else if (s_releasedAtUs[g] == 0) s_releasedAtUs[g] = nowUs;
+  }
+
+  for (uint8_t i = 0; i < OUTPUT_COUNT; i++) {
+    if (inGroup(i, group)) s_states[i] = state;
+  }
+  for (uint8_t i = 0; i < OUTPUT_COUNT; i++) {
+    if (!inGroup(i, group)) continue;
     Serial.print("[Outputs] ");
     Serial.print(OUTPUTS[i].id);
-    Serial.println(" → ARMED");
+    Serial.println(label);
   }
 }
 
-void EY_Outputs_Release() {
+// Drive one output (call with s_timedMux held). Returns the banks to refresh.
+static uint8_t driveOutput(uint8_t index, bool active) {
+  s_states[index] = active ? OutputPinState::ARMED : OutputPinState::RELEASED;
+  return writeMasks(s_pinMasks[index], active);
+}
+
+// Shared timer callback: step every pulse/pattern that is due, then ask
+// for the next edge. Runs in the esp_timer task.
+static void stepTimedOutputs(void*) {
+  uint64_t nowUs = (uint64_t)esp_timer_get_time();
+  uint64_t nextUs = 0;
+  uint8_t banks = 0;
+
+  portENTER_CRITICAL(&s_timedMux);
   for (uint8_t i = 0; i < OUTPUT_COUNT; i++) {
-    s_states[i] = OutputPinState::RELEASED;
-    writePin(i, false);  // Deactivate (unlock maglock)
-    Serial.print("[Outputs] ");
-    Serial.print(OUTPUTS[i].id);
-    Serial.println(" → RELEASED");
+    TimedOutput& t = s_timed[i];
+    if (t.nextUs && t.nextUs <= nowUs) {
+      if (t.active) {
+        bool done = (t.cyclesLeft > 0 && --t.cyclesLeft == 0);
+        t.active = false;
+        t.nextUs = done ? 0 : t.nextUs + t.offMs * 1000ULL;
+      } else {
+        t.active = true;
+        t.nextUs += t.onMs * 1000ULL;
+      }
+      banks |= driveOutput(i, t.active);
+    }
+    if (t.nextUs && (nextUs == 0 || t.nextUs < nextUs)) nextUs = t.nextUs;
   }
+  portEXIT_CRITICAL(&s_timedMux);
+
+  refreshBanks(banks);
+  if (nextUs) EY_Timer_At(s_timer, nextUs);
 }
 
-void EY_Outputs_Reset() {
-  // Reset re-arms outputs (re-lock maglocks for next session)
+// Start a pulse/pattern on one output: active now, edges from the timer
+static void startTimed(uint8_t index, uint32_t onMs, uint32_t offMs, uint16_t cycles) {
+  uint64_t nowUs = (uint64_t)esp_timer_get_time();
+  TimedOutput t = { nowUs + onMs * 1000ULL, onMs, offMs, cycles, true };
+
+  portENTER_CRITICAL(&s_timedMux);
+  s_timed[index] = t;
+  uint8_t banks = driveOutput(index, true);
+  portEXIT_CRITICAL(&s_timedMux);
+  refreshBanks(banks);
+
+  EY_Timer_At(s_timer, t.nextUs);
+}
+
+void EY_Outputs_BeginPin(uint16_t pin, bool high) {
+  if (!validPin(pin)) return;
+  EY_Outputs_WritePin(pin, high);
+  if (EY_PinBank(pin) == EY_OUT_BANK_GPIO) pinMode(pin, OUTPUT);
+}
+
+void EY_Outputs_WritePin(uint16_t pin, bool high) {
+  if (!validPin(pin)) return;
+  OutputMasks m = {};
+  addPin(m, pin, false);
+  refreshBanks(writeMasks(m, high));
+}
+
+void EY_Outputs_Begin() {
   for (uint8_t i = 0; i < OUTPUT_COUNT; i++) {
-    s_states[i] = OutputPinState::ARMED;
-    writePin(i, true);  // Re-activate (re-lock maglock)
-    Serial.print("[Outputs] ");
+    if (!validPin(OUTPUTS[i].pin)) {
+      Serial.print("[Outputs] ERROR: ");
+      Serial.print(OUTPUTS[i].id);
+      Serial.println(" is not on an output GPIO (0-33) or an enabled expander — ignored");
+      continue;
+    }
+    addPin(s_pinMasks[i], OUTPUTS[i].pin, OUTPUTS[i].activeLow);
+    if (OUTPUTS[i].group < PUZZLE_GROUP_COUNT) addPin(s_masks[OUTPUTS[i].group], OUTPUTS[i].pin, OUTPUTS[i].activeLow);
+    addPin(s_masks[PUZZLE_GROUP_COUNT], OUTPUTS[i].pin, OUTPUTS[i].activeLow);
+  }
+  if (OUTPUT_COUNT > 0) s_timer = EY_Timer_Create(stepTimedOutputs, nullptr);
+
+  // Fail-safe: deactivated on boot. Levels are latched before the pins
+  // become outputs so they never glitch active.
+  refreshBanks(writeMasks(s_masks[PUZZLE_GROUP_COUNT], false));
+  for (uint8_t i = 0; i < OUTPUT_COUNT; i++) {
+    if (!validPin(OUTPUTS[i].pin)) continue;
+    if (EY_PinBank(OUTPUTS[i].pin) == EY_OUT_BANK_GPIO) pinMode(OUTPUTS[i].pin, OUTPUT);
+    s_states[i] = OutputPinState::INACTIVE;
+    Serial.print("[Outputs] Pin ");
+    Serial.print(OUTPUTS[i].pin);
+    Serial.print(" (");
     Serial.print(OUTPUTS[i].id);
-    Serial.println(" → ARMED (reset)");
+    Serial.println(") → INACTIVE");
   }
 }
 
+void EY_Outputs_Arm(uint8_t group) {
+  applyState(group, OutputPinState::ARMED, " → ARMED");  // Activate (lock maglocks)
+}
+
+void EY_Outputs_Release(uint8_t group) {
+  applyState(group, OutputPinState::RELEASED, " → RELEASED");  // Deactivate (unlock maglocks)
+}
+
+void EY_Outputs_Reset(uint8_t group) {
+  // Reset re-arms outputs (re-lock maglocks for next session)
+  applyState(group, OutputPinState::ARMED, " → ARMED (reset)");
+}
+
 OutputPinState EY_Outputs_GetState(uint8_t index) {
   if (index >= OUTPUT_COUNT) return OutputPinState::INACTIVE;
   return s_states[index];
@@ -65,3 +283,53 @@ OutputPinState EY_Outputs_GetState(uint8_t index) {
 uint8_t EY_Outputs_GetCount() {
   return OUTPUT_COUNT;
 }
+
+int8_t EY_Outputs_Find(uint8_t group, const char* outputId) {
+  if (!outputId) return -1;
+  for (uint8_t i = 0; i < OUTPUT_COUNT; i++) {
+    if (inGroup(i, group) && strcmp(OUTPUTS[i].id, outputId) == 0) return (int8_t)i;
+  }
+  return -1;
+}
+
+void EY_Outputs_Set(uint8_t index, bool active) {
+  if (index >= OUTPUT_COUNT) return;
+  portENTER_CRITICAL(&s_timedMux);
+  s_timed[index].nextUs = 0;
+  uint8_t banks = driveOutput(index, active);
+  portEXIT_CRITICAL(&s_timedMux);
+  refreshBanks(banks);
+
+  Serial.print("[Outputs] ");
+  Serial.print(OUTPUTS[index].id);
+  Serial.println(active ? " → ON" : " → OFF");
+}
+
+void EY_Outputs_Pulse(uint8_t index, uint32_t ms) {
+  if (index >= OUTPUT_COUNT || ms == 0) return;
+  startTimed(index, ms, 0, 1);
+
+  Serial.print("[Outputs] ");
+  Serial.print(OUTPUTS[index].id);
+  Serial.print(" → PULSE ");
+  Serial.print(ms);
+  Serial.println(" ms");
+}
+
+void EY_Outputs_Pattern(uint8_t index, uint32_t onMs, uint32_t offMs, uint16_t count) {
+  if (index >= OUTPUT_COUNT || onMs == 0 || offMs == 0) return;
+  startTimed(index, onMs, offMs, count);
+
+  Serial.print("[Outputs] ");
+  Serial.print(OUTPUTS[index].id);
+  Serial.print(" → PATTERN ");
+  Serial.print(onMs);
+  Serial.print("/");
+  Serial.print(offMs);
+  Serial.print(" ms x");
+  Serial.println(count);
+}
+
+uint64_t EY_Outputs_GetReleasedAtUs(uint8_t group) {
+  return (group < PUZZLE_GROUP_COUNT) ? s_releasedAtUs[group] : 0;
+}
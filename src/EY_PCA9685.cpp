@@ -0,0 +1,154 @@
+#include "EY_Config.h"  // Must be first — brings in PROP_CONFIG which may define HAS_PCA9685
+
+#ifdef HAS_PCA9685
+
+#include "EY_PCA9685.h"
+
+#include <Wire.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static_assert(PCA9685_COUNT >= 1 && PCA9685_COUNT <= 4, "PCA9685 outputs support 1-4 chips (one output bank)");
+static_assert(PCA9685_PWM_HZ >= 24 && PCA9685_PWM_HZ <= 1526, "PCA9685_PWM_HZ must be 24-1526 Hz");
+#ifdef HAS_MCP23017
+static_assert(PCA9685_SDA_PIN == MCP23017_SDA_PIN && PCA9685_SCL_PIN == MCP23017_SCL_PIN,
+              "PCA9685 chips share the MCP23017 I2C bus: use the same SDA/SCL pins");
+#endif
+
+// ---- Registers ----
+static constexpr uint8_t REG_MODE1     = 0x00;
+static constexpr uint8_t REG_MODE2     = 0x01;
+static constexpr uint8_t REG_LED0      = 0x06;  // LEDn_ON_L at 0x06 + 4n
+static constexpr uint8_t REG_PRESCALE  = 0xFE;
+static constexpr uint8_t MODE1_AI      = 0x20;  // Register auto-increment
+static constexpr uint8_t MODE1_SLEEP   = 0x10;
+static constexpr uint8_t MODE2_OUTDRV  = 0x04;  // Totem-pole outputs
+static constexpr uint8_t LED_FULL      = 0x10;  // Bit 4 of ON_H / OFF_H
+
+static constexpr unsigned long PCA9685_I2C_HZ = 400000;
+static constexpr uint8_t CHANNELS = PCA9685_COUNT * 16;
+
+// Shadow: 0 = off .. EY_PCA9685_FULL_ON, and the channels not sent yet
+static uint16_t s_duty[CHANNELS];
+static uint16_t s_dirty[PCA9685_COUNT];
+static portMUX_TYPE s_shadowMux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t s_task = nullptr;
+
+static bool writeReg(uint8_t address, uint8_t reg, uint8_t value) {
+  Wire.beginTransmission(address);
+  Wire.write(reg);
+  Wire.write(value);
+  return Wire.endTransmission() == 0;
+}
+
+// Store a channel's duty; true if it changed (call with s_shadowMux held)
+static bool storeDuty(uint8_t channel, uint16_t duty) {
+  if (s_duty[channel] == duty) return false;
+  s_duty[channel] = duty;
+  s_dirty[channel / 16] |= 1 << (channel % 16);
+  return true;
+}
+
+// One auto-increment write per chip, covering its changed channels (first
+// to last)
+static void sendChanges() {
+  for (uint8_t chip = 0; chip < PCA9685_COUNT; chip++) {
+    uint16_t duty[16];
+    portENTER_CRITICAL(&s_shadowMux);
+    uint16_t dirty = s_dirty[chip];
+    s_dirty[chip] = 0;
+    for (uint8_t c = 0; c < 16; c++) duty[c] = s_duty[chip * 16 + c];
+    portEXIT_CRITICAL(&s_shadowMux);
+    if (!dirty) continue;
+
+    uint8_t first = __builtin_ctz(dirty);
+    uint8_t last = 31 - __builtin_clz(dirty);
+    Wire.beginTransmission(PCA9685_ADDRS[chip]);
+    Wire.write(REG_LED0 + 4 * first);
+    for (uint8_t c = first; c <= last; c++) {
+      uint16_t d = duty[c];
+      Wire.write(0);                                              // ON_L
+      Wire.write(d >= EY_PCA9685_FULL_ON ? LED_FULL : 0);         // ON_H
+      Wire.write(d >= EY_PCA9685_FULL_ON ? 0 : (uint8_t)d);       // OFF_L
+      Wire.write(d == 0 ? LED_FULL : (uint8_t)((d >> 8) & 0x0F)); // OFF_H
+    }
+    if (Wire.endTransmission() != 0) {
+      // Keep the channels pending; the next change retries them
+      portENTER_CRITICAL(&s_shadowMux);
+      s_dirty[chip] |= dirty;
+      portEXIT_CRITICAL(&s_shadowMux);
+    }
+  }
+}
+
+// Refresh task: the I2C transfers block (and wait out the bus timeout on a
+// stuck bus), so they stay out of the shared timer task and its 1 kHz
+// input sampler. Notifications given while a transfer runs coalesce into
+// one more pass.
+static void pcaTask(void*) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    sendChanges();
+  }
+}
+
+void EY_PCA9685_Begin() {
+  Wire.begin(PCA9685_SDA_PIN, PCA9685_SCL_PIN, PCA9685_I2C_HZ);
+
+  // prescale = round(25 MHz / (4096 * f)) - 1
+  uint8_t prescale = (uint8_t)((25000000UL + 2048UL * PCA9685_PWM_HZ) / (4096UL * PCA9685_PWM_HZ) - 1);
+#ifdef PCA9685_OPEN_DRAIN
+  uint8_t mode2 = 0;
+#else
+  uint8_t mode2 = MODE2_OUTDRV;
+#endif
+
+  for (uint8_t i = 0; i < PCA9685_COUNT; i++) {
+    uint8_t address = PCA9685_ADDRS[i];
+    // The prescaler can only be written while asleep
+    bool ok = writeReg(address, REG_MODE1, MODE1_SLEEP | MODE1_AI) &&
+              writeReg(address, REG_PRESCALE, prescale) &&
+              writeReg(address, REG_MODE2, mode2) &&
+              writeReg(address, REG_MODE1, MODE1_AI);
+
+    // Every channel off, sent by the first refresh
+    s_dirty[i] = 0xFFFF;
+
+    Serial.print("[PCA9685] Chip ");
+    Serial.print(i);
+    Serial.print(" @0x");
+    Serial.print(address, HEX);
+    Serial.println(ok ? " ready" : " NOT RESPONDING");
+  }
+  // Core 0 below the esp_timer task; Wire serialises it with other bus users
+  xTaskCreatePinnedToCore(pcaTask, "ey_pca9685", 3072, nullptr, 3, &s_task, 0);
+  EY_PCA9685_Refresh();
+}
+
+bool EY_PCA9685_Write(uint64_t set, uint64_t clear) {
+  bool changed = false;
+  portENTER_CRITICAL(&s_shadowMux);
+  for (uint64_t m = (set | clear) & ((CHANNELS < 64) ? ((1ULL << CHANNELS) - 1) : ~0ULL); m; m &= m - 1) {
+    uint8_t channel = __builtin_ctzll(m);
+    bool on = (set >> channel) & 1;
+    changed |= storeDuty(channel, on ? EY_PCA9685_FULL_ON : 0);
+  }
+  for (uint8_t chip = 0; chip < PCA9685_COUNT; chip++) changed |= (s_dirty[chip] != 0);
+  portEXIT_CRITICAL(&s_shadowMux);
+  return changed;
+}
+
+void EY_PCA9685_SetDuty(uint8_t channel, uint16_t duty) {
+  if (channel >= CHANNELS) return;
+  if (duty > EY_PCA9685_FULL_ON) duty = EY_PCA9685_FULL_ON;
+  portENTER_CRITICAL(&s_shadowMux);
+  bool changed = storeDuty(channel, duty);
+  portEXIT_CRITICAL(&s_shadowMux);
+  if (changed) EY_PCA9685_Refresh();
+}
+
+void EY_PCA9685_Refresh() {
+  if (s_task) xTaskNotifyGive(s_task);
+}
+
+#endif // HAS_PCA9685
@@ -4,6 +4,7 @@
 
 #include "EY_PIR.h"
 #include "EY_Mqtt.h"
+#include "EY_Inputs.h"
 
 static uint8_t       s_pin = 0;
 static bool          s_lastState = false;
@@ -24,7 +25,7 @@ void EY_PIR_Begin(uint8_t pin) {
 }
 
 void EY_PIR_Tick() {
-  bool now = (digitalRead(s_pin) == HIGH);
+  bool now = EY_Inputs_PinHigh(EY_Inputs_Snapshot(), s_pin);
   unsigned long t = millis();
 
   if (now && !s_lastState) {
@@ -0,0 +1,314 @@
+#include "EY_Config.h"  // Must be first — brings in PROP_CONFIG which may define HAS_PIXELS
+
+#ifdef HAS_PIXELS
+
+#include "EY_Pixels.h"
+#include "EY_Timer.h"
+
+#include <driver/rmt.h>
+#include <esp_timer.h>
+
+#ifndef PIXELS_ON_COLOR
+  #define PIXELS_ON_COLOR EY_RGB(255, 255, 255)
+#endif
+#ifndef PIXELS_BRIGHTNESS
+  #define PIXELS_BRIGHTNESS 255
+#endif
+
+static_assert(PIXELS_COUNT >= 1 && PIXELS_COUNT <= 512, "PIXELS_COUNT must be 1-512");
+static_assert(PIXELS_BRIGHTNESS >= 0 && PIXELS_BRIGHTNESS <= 255, "PIXELS_BRIGHTNESS must be 0-255");
+static_assert(PIXELS_RMT_CHANNEL + PIXELS_RMT_MEM_BLOCKS <= 8,
+              "PIXELS_RMT_MEM_BLOCKS take RMT RAM from PIXELS_RMT_CHANNEL upwards (8 blocks in total)");
+
+// ---- WS2812 timing, RMT clock 80 MHz / 2 = 25 ns per tick ----
+static constexpr rmt_channel_t RMT_CHANNEL = (rmt_channel_t)PIXELS_RMT_CHANNEL;
+static constexpr uint8_t  RMT_CLK_DIV = 2;
+static constexpr uint16_t T0H = 16;   // 0.40 µs
+static constexpr uint16_t T0L = 34;   // 0.85 µs
+static constexpr uint16_t T1H = 32;   // 0.80 µs
+static constexpr uint16_t T1L = 18;   // 0.45 µs
+static constexpr uint32_t LATCH_US = 300;  // Low time that latches a frame (WS2812B: > 280 µs)
+
+static constexpr uint8_t  PIN_PIXELS   = (PIXELS_COUNT < 64) ? PIXELS_COUNT : 64;
+static constexpr uint32_t EFFECT_STEP_US = 20000;  // 50 Hz
+static constexpr uint16_t FADE_CHUNK = 64;         // Pixels stepped per lock
+
+struct PixelFade {
+  uint32_t from;
+  uint32_t to;
+  uint32_t startMs;
+  uint32_t ms;       // 0 = no effect running
+};
+
+// A running effect copied out of the lock, and its color at this step
+struct FadeStep {
+  PixelFade fade;
+  uint32_t color;
+  uint16_t index;
+  bool done;
+};
+
+// Back buffer: what modules draw, and what has not been sent yet
+static uint32_t  s_back[PIXELS_COUNT];
+static uint32_t  s_onColor[PIN_PIXELS];
+static PixelFade s_fades[PIXELS_COUNT];
+static FadeStep  s_steps[FADE_CHUNK];  // Timer task only
+static uint16_t  s_fadeCount = 0;
+static uint16_t  s_dirtyLo = PIXELS_COUNT;  // Empty when s_dirtyLo > s_dirtyHi
+static uint16_t  s_dirtyHi = 0;
+static portMUX_TYPE s_pixelMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Front buffer: the encoded frame, owned by the RMT while it transmits.
+// Pixels outside the dirty region keep their items from earlier frames.
+static rmt_item32_t s_items[PIXELS_COUNT * 24];
+static uint32_t     s_snapshot[PIXELS_COUNT];
+static uint64_t     s_readyAtUs = 0;  // Previous frame sent and latched
+static bool         s_ok = false;
+static int8_t       s_timer = -1;
+
+// ---- Back buffer (call with s_pixelMux held, except stepFades) ----
+
+static void markDirty(uint16_t index) {
+  if (index < s_dirtyLo) s_dirtyLo = index;
+  if (index > s_dirtyHi) s_dirtyHi = index;
+}
+
+static bool store(uint16_t index, uint32_t color) {
+  if (s_back[index] == color) return false;
+  s_back[index] = color;
+  markDirty(index);
+  return true;
+}
+
+static void stopFade(uint16_t index) {
+  if (s_fades[index].ms) {
+    s_fades[index].ms = 0;
+    s_fadeCount--;
+  }
+}
+
+static void startFade(uint16_t index, uint32_t from, uint32_t to, uint32_t ms, uint32_t nowMs) {
+  if (!s_fades[index].ms) s_fadeCount++;
+  s_fades[index] = { from, to, nowMs, ms };
+  store(index, from);
+}
+
+static uint32_t blend(uint32_t from, uint32_t to, uint32_t t, uint32_t ms) {
+  uint32_t out = 0;
+  for (uint8_t shift = 0; shift <= 16; shift += 8) {
+    int32_t a = (from >> shift) & 0xFF;
+    int32_t b = (to >> shift) & 0xFF;
+    out |= (uint32_t)(a + (int64_t)(b - a) * t / ms) << shift;
+  }
+  return out;
+}
+
+static bool sameFade(const PixelFade& a, const PixelFade& b) {
+  return a.ms == b.ms && a.startMs == b.startMs && a.from == b.from && a.to == b.to;
+}
+
+// Advance every running effect; true while some are still running.
+// FADE_CHUNK pixels at a time: their effects are copied under the lock,
+// blended outside it, and stored unless a Set/Fade/Pulse replaced them
+// in between.
+static bool stepFades(uint32_t nowMs) {
+  for (uint16_t first = 0; first < PIXELS_COUNT; first += FADE_CHUNK) {
+    uint16_t last = (PIXELS_COUNT - first > FADE_CHUNK) ? first + FADE_CHUNK : PIXELS_COUNT;
+    uint8_t n = 0;
+    portENTER_CRITICAL(&s_pixelMux);
+    bool running = s_fadeCount > 0;
+    if (running) {
+      for (uint16_t i = first; i < last; i++) {
+        if (s_fades[i].ms) s_steps[n++] = { s_fades[i], 0, i, false };
+      }
+    }
+    portEXIT_CRITICAL(&s_pixelMux);
+    if (!running) return false;
+
+    for (uint8_t k = 0; k < n; k++) {
+      FadeStep& step = s_steps[k];
+      uint32_t t = nowMs - step.fade.startMs;
+      step.done = t >= step.fade.ms;
+      step.color = step.done ? step.fade.to : blend(step.fade.from, step.fade.to, t, step.fade.ms);
+    }
+
+    portENTER_CRITICAL(&s_pixelMux);
+    for (uint8_t k = 0; k < n; k++) {
+      const FadeStep& step = s_steps[k];
+      if (!sameFade(s_fades[step.index], step.fade)) continue;
+      store(step.index, step.color);
+      if (step.done) stopFade(step.index);
+    }
+    portEXIT_CRITICAL(&s_pixelMux);
+  }
+
+  portENTER_CRITICAL(&s_pixelMux);
+  bool running = s_fadeCount > 0;
+  portEXIT_CRITICAL(&s_pixelMux);
+  return running;
+}
+
+// ---- Front buffer ----
+
+static void encode(rmt_item32_t* items, uint32_t color) {
+  uint32_t r = ((color >> 16) & 0xFF) * (PIXELS_BRIGHTNESS + 1) >> 8;
+  uint32_t g = ((color >> 8) & 0xFF) * (PIXELS_BRIGHTNESS + 1) >> 8;
+  uint32_t b = (color & 0xFF) * (PIXELS_BRIGHTNESS + 1) >> 8;
+  uint32_t grb = (g << 16) | (r << 8) | b;  // WS2812 wire order, MSB first
+  for (int8_t bit = 23; bit >= 0; bit--) {
+    bool one = (grb >> bit) & 1;
+    items->duration0 = one ? T1H : T0H;
+    items->level0 = 1;
+    items->duration1 = one ? T1L : T0L;
+    items->level1 = 0;
+    items++;
+  }
+}
+
+// Encode the dirty region and start the transfer, or come back when the
+// strip is free
+static void send(uint64_t nowUs) {
+  portENTER_CRITICAL(&s_pixelMux);
+  bool dirty = s_dirtyLo <= s_dirtyHi;
+  portEXIT_CRITICAL(&s_pixelMux);
+  if (!dirty || !s_ok) return;
+
+  if (nowUs < s_readyAtUs || rmt_wait_tx_done(RMT_CHANNEL, 0) != ESP_OK) {
+    EY_Timer_At(s_timer, (s_readyAtUs > nowUs) ? s_readyAtUs : nowUs + LATCH_US);
+    return;
+  }
+
+  portENTER_CRITICAL(&s_pixelMux);
+  uint16_t lo = s_dirtyLo;
+  uint16_t hi = s_dirtyHi;
+  memcpy(&s_snapshot[lo], &s_back[lo], (hi - lo + 1) * sizeof(uint32_t));
+  s_dirtyLo = PIXELS_COUNT;
+  s_dirtyHi = 0;
+  portEXIT_CRITICAL(&s_pixelMux);
+
+  for (uint16_t i = lo; i <= hi; i++) encode(&s_items[i * 24], s_snapshot[i]);
+
+  // Pixels past `hi` are not clocked out and keep their latched colors
+  uint32_t itemCount = (uint32_t)(hi + 1) * 24;
+  rmt_write_items(RMT_CHANNEL, s_items, itemCount, false);
+  s_readyAtUs = nowUs + (itemCount * 5 + 3) / 4 + LATCH_US;  // 1.25 µs per bit
+}
+
+// Timer callback: step the effects, then send what changed
+static void refresh(void*) {
+  uint64_t nowUs = (uint64_t)esp_timer_get_time();
+  bool running = stepFades((uint32_t)(nowUs / 1000));
+  if (running) EY_Timer_At(s_timer, nowUs + EFFECT_STEP_US);
+  send(nowUs);
+}
+
+// ---- Public API ----
+
+void EY_Pixels_Begin() {
+  rmt_config_t config = RMT_DEFAULT_CONFIG_TX((gpio_num_t)PIXELS_PIN, RMT_CHANNEL);
+  config.clk_div = RMT_CLK_DIV;
+  config.mem_block_num = PIXELS_RMT_MEM_BLOCKS;
+  if (rmt_config(&config) != ESP_OK || rmt_driver_install(RMT_CHANNEL, 0, 0) != ESP_OK) {
+    Serial.println("[Pixels] ERROR: RMT init failed — strip not driven");
+    return;
+  }
+  s_ok = true;
+  s_timer = EY_Timer_Create(&refresh, nullptr);
+
+  // Whole strip black on the first refresh
+  portENTER_CRITICAL(&s_pixelMux);
+  for (uint16_t i = 0; i < PIN_PIXELS; i++) s_onColor[i] = PIXELS_ON_COLOR;
+  s_dirtyLo = 0;
+  s_dirtyHi = PIXELS_COUNT - 1;
+  portEXIT_CRITICAL(&s_pixelMux);
+  EY_Pixels_Refresh();
+
+  Serial.print("[Pixels] ");
+  Serial.print(PIXELS_COUNT);
+  Serial.print(" LEDs on GPIO ");
+  Serial.println(PIXELS_PIN);
+}
+
+void EY_Pixels_Set(uint16_t index, uint32_t color) {
+  EY_Pixels_Fill(index, 1, color);
+}
+
+void EY_Pixels_Fill(uint16_t first, uint16_t count, uint32_t color) {
+  bool changed = false;
+  portENTER_CRITICAL(&s_pixelMux);
+  for (uint16_t i = first; i < PIXELS_COUNT && i - first < count; i++) {
+    stopFade(i);
+    changed |= store(i, color);
+  }
+  portEXIT_CRITICAL(&s_pixelMux);
+  if (changed) EY_Pixels_Refresh();
+}
+
+uint32_t EY_Pixels_Get(uint16_t index) {
+  if (index >= PIXELS_COUNT) return 0;
+  portENTER_CRITICAL(&s_pixelMux);
+  uint32_t color = s_back[index];
+  portEXIT_CRITICAL(&s_pixelMux);
+  return color;
+}
+
+void EY_Pixels_SetOnColor(uint16_t first, uint16_t count, uint32_t color) {
+  portENTER_CRITICAL(&s_pixelMux);
+  for (uint16_t i = first; i < PIN_PIXELS && i - first < count; i++) {
+    // A pixel pin that is on shows its new color right away
+    if (s_back[i] && s_back[i] == s_onColor[i] && !s_fades[i].ms) store(i, color);
+    s_onColor[i] = color;
+  }
+  portEXIT_CRITICAL(&s_pixelMux);
+  EY_Pixels_Refresh();
+}
+
+void EY_Pixels_Fade(uint16_t first, uint16_t count, uint32_t color, uint32_t ms) {
+  if (ms == 0) {
+    EY_Pixels_Fill(first, count, color);
+    return;
+  }
+  uint32_t nowMs = millis();
+  portENTER_CRITICAL(&s_pixelMux);
+  for (uint16_t i = first; i < PIXELS_COUNT && i - first < count; i++) {
+    startFade(i, s_back[i], color, ms, nowMs);
+  }
+  portEXIT_CRITICAL(&s_pixelMux);
+  EY_Pixels_Refresh();
+}
+
+void EY_Pixels_Pulse(uint16_t first, uint16_t count, uint32_t color, uint32_t ms) {
+  uint32_t nowMs = millis();
+  portENTER_CRITICAL(&s_pixelMux);
+  for (uint16_t i = first; i < PIXELS_COUNT && i - first < count; i++) {
+    // Return to where a running fade was heading, not to a midway color
+    uint32_t back = s_fades[i].ms ? s_fades[i].to : s_back[i];
+    if (ms == 0) {
+      stopFade(i);
+      store(i, back);
+    } else {
+      startFade(i, color, back, ms, nowMs);
+    }
+  }
+  portEXIT_CRITICAL(&s_pixelMux);
+  EY_Pixels_Refresh();
+}
+
+bool EY_Pixels_Write(uint64_t set, uint64_t clear) {
+  bool changed = false;
+  portENTER_CRITICAL(&s_pixelMux);
+  for (uint64_t m = (set | clear) & ((PIN_PIXELS < 64) ? ((1ULL << PIN_PIXELS) - 1) : ~0ULL); m; m &= m - 1) {
+    uint8_t index = __builtin_ctzll(m);
+    stopFade(index);
+    changed |= store(index, ((set >> index) & 1) ? s_onColor[index] : 0);
+  }
+  changed |= s_dirtyLo <= s_dirtyHi;
+  portEXIT_CRITICAL(&s_pixelMux);
+  return changed;
+}
+
+void EY_Pixels_Refresh() {
+  EY_Timer_At(s_timer, 1);  // Already due: runs next in the timer task
+}
+
+#endif // HAS_PIXELS
@@ -0,0 +1,406 @@
+#include "EY_Config.h"  // Must be first — brings in PROP_CONFIG which may define HAS_RFID
+
+#ifdef HAS_RFID
+
+#include "EY_RFID.h"
+#include "EY_Inputs.h"
+#include "EY_Mqtt.h"
+
+#include <driver/spi_master.h>
+#include <esp_attr.h>
+#include <esp_timer.h>
+
+#ifndef RFID_SPI_HZ
+  #define RFID_SPI_HZ 4000000
+#endif
+#ifndef RFID_ROUND_BUDGET_MS
+  #define RFID_ROUND_BUDGET_MS 50  // A tag is seen within this after it lands
+#endif
+
+static_assert(RFID_READER_COUNT >= 1 && RFID_READER_COUNT <= 16, "RFID supports 1-16 readers");
+
+// ---- MFRC522 registers / commands ----
+static constexpr uint8_t REG_COMMAND     = 0x01;
+static constexpr uint8_t REG_COM_IRQ     = 0x04;
+static constexpr uint8_t REG_ERROR       = 0x06;
+static constexpr uint8_t REG_FIFO_DATA   = 0x09;
+static constexpr uint8_t REG_FIFO_LEVEL  = 0x0A;
+static constexpr uint8_t REG_BIT_FRAMING = 0x0D;
+static constexpr uint8_t REG_MODE        = 0x11;
+static constexpr uint8_t REG_TX_CONTROL  = 0x14;
+static constexpr uint8_t REG_TX_ASK      = 0x15;
+static constexpr uint8_t REG_T_MODE      = 0x2A;
+static constexpr uint8_t REG_T_PRESCALER = 0x2B;
+static constexpr uint8_t REG_T_RELOAD_H  = 0x2C;
+static constexpr uint8_t REG_T_RELOAD_L  = 0x2D;
+static constexpr uint8_t REG_VERSION     = 0x37;
+
+static constexpr uint8_t CMD_IDLE       = 0x00;
+static constexpr uint8_t CMD_TRANSCEIVE = 0x0C;
+static constexpr uint8_t CMD_SOFT_RESET = 0x0F;
+
+static constexpr uint8_t IRQ_RX    = 0x20;
+static constexpr uint8_t IRQ_IDLE  = 0x10;
+static constexpr uint8_t IRQ_TIMER = 0x01;
+static constexpr uint8_t ERR_MASK  = 0x1B;  // BufferOvfl | CollErr | ParityErr | ProtocolErr
+
+// ---- ISO 14443A ----
+static constexpr uint8_t PICC_WUPA   = 0x52;  // Wakes IDLE and HALTed tags
+static constexpr uint8_t PICC_SEL_CL1 = 0x93;
+static constexpr uint8_t PICC_SEL_CL2 = 0x95;
+static constexpr uint8_t PICC_HLTA   = 0x50;
+static constexpr uint8_t PICC_CT     = 0x88;  // Cascade tag: UID continues at CL2
+
+// Tag silent for this many rounds = removed. A single miss is common at
+// the edge of the field.
+static constexpr uint8_t RFID_MISS_LIMIT = 2;
+// Software bound on a transceive; the MFRC522 timer (1 ms) normally ends it first
+static constexpr uint32_t RFID_TRANSCEIVE_TIMEOUT_US = 3000;
+static constexpr uint8_t RFID_EVENT_QUEUE = 8;
+// Rounds over RFID_ROUND_BUDGET_MS are logged at most this often
+static constexpr uint32_t RFID_SLOW_LOG_MS = 10000;
+
+struct ReaderState {
+  bool present;       // Any tag in the field
+  bool allowed;       // ...and it is on this reader's allow-list
+  uint8_t misses;
+  RfidUid uid;
+};
+
+struct TagEvent {
+  uint8_t reader;
+  RfidUid uid;
+};
+
+static spi_device_handle_t s_spi = nullptr;
+DMA_ATTR WORD_ALIGNED_ATTR static uint8_t s_tx[32];
+DMA_ATTR WORD_ALIGNED_ATTR static uint8_t s_rx[32];
+
+static ReaderState s_readers[RFID_READER_COUNT];
+static uint64_t s_bits = 0;  // Published word
+static volatile uint32_t s_roundUs = 0;
+
+// ---- Round timing (s_eventMux) ----
+static uint32_t s_roundMaxUs = 0;   // Longest round since the last status report
+static uint32_t s_slowRounds = 0;   // Rounds over budget since the last log...
+static uint32_t s_slowMaxUs = 0;    // ...and the longest of them
+static uint32_t s_slowLogMs = 0;
+
+// ---- Handoff to loop() ----
+static portMUX_TYPE s_eventMux = portMUX_INITIALIZER_UNLOCKED;
+static TagEvent s_events[RFID_EVENT_QUEUE];
+static uint8_t s_eventHead = 0;
+static uint8_t s_eventCount = 0;
+
+// ------------------------------------------------------------
+// SPI register access (one DMA transaction each, manual chip select:
+// the bus only has 3 hardware CS lines)
+// ------------------------------------------------------------
+
+static void transfer(uint8_t reader, size_t len) {
+  spi_transaction_t t = {};
+  t.length = len * 8;
+  t.tx_buffer = s_tx;
+  t.rx_buffer = s_rx;
+  digitalWrite(RFID_READERS[reader].csPin, LOW);
+  spi_device_polling_transmit(s_spi, &t);
+  digitalWrite(RFID_READERS[reader].csPin, HIGH);
+}
+
+static void writeReg(uint8_t reader, uint8_t reg, uint8_t value) {
+  s_tx[0] = (uint8_t)((reg << 1) & 0x7E);
+  s_tx[1] = value;
+  transfer(reader, 2);
+}
+
+static uint8_t readReg(uint8_t reader, uint8_t reg) {
+  s_tx[0] = (uint8_t)(0x80 | ((reg << 1) & 0x7E));
+  s_tx[1] = 0;
+  transfer(reader, 2);
+  return s_rx[1];
+}
+
+static void writeFifo(uint8_t reader, const uint8_t* data, uint8_t len) {
+  s_tx[0] = (uint8_t)((REG_FIFO_DATA << 1) & 0x7E);
+  memcpy(&s_tx[1], data, len);
+  transfer(reader, len + 1);
+}
+
+static void readFifo(uint8_t reader, uint8_t* data, uint8_t len) {
+  uint8_t addr = (uint8_t)(0x80 | ((REG_FIFO_DATA << 1) & 0x7E));
+  memset(s_tx, addr, len);
+  s_tx[len] = 0;
+  transfer(reader, len + 1);
+  memcpy(data, &s_rx[1], len);
+}
+
+// ------------------------------------------------------------
+// ISO 14443A exchange
+// ------------------------------------------------------------
+
+static uint16_t crcA(const uint8_t* data, uint8_t len) {
+  uint16_t crc = 0x6363;
+  for (uint8_t i = 0; i < len; i++) {
+    uint8_t b = (uint8_t)(data[i] ^ (crc & 0xFF));
+    b = (uint8_t)(b ^ (b << 4));
+    crc = (uint16_t)((crc >> 8) ^ ((uint16_t)b << 8) ^ ((uint16_t)b << 3) ^ (b >> 4));
+  }
+  return crc;
+}
+
+static bool transceive(uint8_t reader, const uint8_t* send, uint8_t sendLen,
+                       uint8_t* back, uint8_t backMax, uint8_t& backLen, uint8_t txLastBits = 0) {
+  writeReg(reader, REG_COMMAND, CMD_IDLE);
+  writeReg(reader, REG_COM_IRQ, 0x7F);       // Clear IRQ flags
+  writeReg(reader, REG_FIFO_LEVEL, 0x80);    // Flush FIFO
+  writeFifo(reader, send, sendLen);
+  writeReg(reader, REG_COMMAND, CMD_TRANSCEIVE);
+  writeReg(reader, REG_BIT_FRAMING, (uint8_t)(0x80 | txLastBits));  // StartSend
+
+  uint64_t deadline = (uint64_t)esp_timer_get_time() + RFID_TRANSCEIVE_TIMEOUT_US;
+  for (;;) {
+    uint8_t irq = readReg(reader, REG_COM_IRQ);
+    if (irq & (IRQ_RX | IRQ_IDLE)) break;
+    if (irq & IRQ_TIMER) return false;  // No tag answered
+    if ((uint64_t)esp_timer_get_time() > deadline) return false;
+  }
+  writeReg(reader, REG_BIT_FRAMING, 0);
+
+  if (readReg(reader, REG_ERROR) & ERR_MASK) return false;
+  uint8_t n = readReg(reader, REG_FIFO_LEVEL);
+  if (n > backMax) return false;
+  readFifo(reader, back, n);
+  backLen = n;
+  return true;
+}
+
+// Wake, resolve and select the tag in the field, then halt it
+static bool readUid(uint8_t reader, RfidUid& uid) {
+  uint8_t resp[5];
+  uint8_t n = 0;
+  uint8_t wupa = PICC_WUPA;
+  if (!transceive(reader, &wupa, 1, resp, sizeof(resp), n, 7) || n != 2) return false;
+
+  uid.length = 0;
+  for (uint8_t level = 0; level < 2; level++) {
+    uint8_t sel = level ? PICC_SEL_CL2 : PICC_SEL_CL1;
+    uint8_t anticoll[2] = {sel, 0x20};
+    if (!transceive(reader, anticoll, 2, resp, sizeof(resp), n) || n != 5) return false;
+    if ((resp[0] ^ resp[1] ^ resp[2] ^ resp[3]) != resp[4]) return false;  // BCC
+
+    uint8_t select[9] = {sel, 0x70, resp[0], resp[1], resp[2], resp[3], resp[4], 0, 0};
+    uint16_t crc = crcA(select, 7);
+    select[7] = (uint8_t)(crc & 0xFF);
+    select[8] = (uint8_t)(crc >> 8);
+    uint8_t sak[3];
+    if (!transceive(reader, select, 9, sak, sizeof(sak), n) || n != 3) return false;
+
+    bool more = (sak[0] & 0x04) != 0;  // Cascade bit: UID not complete
+    if (more && level == 0 && resp[0] == PICC_CT) {
+      memcpy(uid.bytes, &resp[1], 3);
+      uid.length = 3;
+      continue;
+    }
+    memcpy(&uid.bytes[uid.length], resp, 4);
+    uid.length += 4;
+    break;
+  }
+  if (uid.length != 4 && uid.length != 7) return false;
+
+  uint8_t hlta[4] = {PICC_HLTA, 0x00, 0, 0};
+  uint16_t crc = crcA(hlta, 2);
+  hlta[2] = (uint8_t)(crc & 0xFF);
+  hlta[3] = (uint8_t)(crc >> 8);
+  transceive(reader, hlta, 4, resp, sizeof(resp), n);  // No answer = halted
+  return true;
+}
+
+static bool sameUid(const RfidUid& a, const RfidUid& b) {
+  return a.length == b.length && memcmp(a.bytes, b.bytes, a.length) == 0;
+}
+
+static bool isAllowed(uint8_t reader, const RfidUid& uid) {
+  const RfidReaderDef& def = RFID_READERS[reader];
+  if (!def.allowed || def.allowedCount == 0) return true;
+  for (uint8_t i = 0; i < def.allowedCount; i++) {
+    if (sameUid(def.allowed[i], uid)) return true;
+  }
+  return false;
+}
+
+static void queueEvent(uint8_t reader, const RfidUid& uid) {
+  portENTER_CRITICAL(&s_eventMux);
+  uint8_t slot = (uint8_t)((s_eventHead + s_eventCount) % RFID_EVENT_QUEUE);
+  if (s_eventCount < RFID_EVENT_QUEUE) s_eventCount++;
+  else s_eventHead = (uint8_t)((s_eventHead + 1) % RFID_EVENT_QUEUE);  // Drop oldest
+  s_events[slot] = {reader, uid};
+  portEXIT_CRITICAL(&s_eventMux);
+}
+
+// ------------------------------------------------------------
+// Polling task
+// ------------------------------------------------------------
+
+static void pollReader(uint8_t reader) {
+  ReaderState& st = s_readers[reader];
+  RfidUid uid;
+  if (readUid(reader, uid)) {
+    st.misses = 0;
+    if (!st.present || !sameUid(uid, st.uid)) {
+      st.present = true;
+      st.uid = uid;
+      st.allowed = isAllowed(reader, uid);
+      queueEvent(reader, uid);
+    }
+  } else if (st.present && ++st.misses >= RFID_MISS_LIMIT) {
+    st.present = false;
+    st.allowed = false;
+  }
+}
+
+static void rfidTask(void*) {
+  for (;;) {
+    uint64_t start = (uint64_t)esp_timer_get_time();
+    uint64_t bits = 0;
+    for (uint8_t r = 0; r < RFID_READER_COUNT; r++) {
+      pollReader(r);
+      if (s_readers[r].allowed) bits |= EY_PinBit(EY_RFID_READER(r));
+      if (s_readers[r].present) bits |= EY_PinBit(EY_RFID_ANY_TAG(r));
+    }
+    if (bits != s_bits) {
+      s_bits = bits;
+      EY_Inputs_PublishBank(EY_BANK_RFID, bits);
+    }
+    uint32_t roundUs = (uint32_t)((uint64_t)esp_timer_get_time() - start);
+    s_roundUs = roundUs;
+    portENTER_CRITICAL(&s_eventMux);
+    if (roundUs > s_roundMaxUs) s_roundMaxUs = roundUs;
+    if (roundUs > RFID_ROUND_BUDGET_MS * 1000UL) {
+      s_slowRounds++;
+      if (roundUs > s_slowMaxUs) s_slowMaxUs = roundUs;
+    }
+    portEXIT_CRITICAL(&s_eventMux);
+    vTaskDelay(1);  // Let lower-priority tasks (idle/watchdog) run
+  }
+}
+
+static void initReader(uint8_t reader) {
+  writeReg(reader, REG_COMMAND, CMD_SOFT_RESET);
+  delay(50);
+  writeReg(reader, REG_T_MODE, 0x80);       // Timer starts after each transmission
+  writeReg(reader, REG_T_PRESCALER, 0xA9);  // 13.56 MHz / 339 = 40 kHz (25 µs)
+  writeReg(reader, REG_T_RELOAD_H, 0);
+  writeReg(reader, REG_T_RELOAD_L, 40);     // 1 ms: no answer = no tag
+  writeReg(reader, REG_TX_ASK, 0x40);       // 100% ASK
+  writeReg(reader, REG_MODE, 0x3D);         // CRC preset 0x6363
+  writeReg(reader, REG_TX_CONTROL, (uint8_t)(readReg(reader, REG_TX_CONTROL) | 0x03));  // Antenna on
+}
+
+void EY_RFID_Begin() {
+  for (uint8_t r = 0; r < RFID_READER_COUNT; r++) {
+    pinMode(RFID_READERS[r].csPin, OUTPUT);
+    digitalWrite(RFID_READERS[r].csPin, HIGH);
+  }
+
+  spi_bus_config_t bus = {};
+  bus.mosi_io_num = RFID_MOSI_PIN;
+  bus.miso_io_num = RFID_MISO_PIN;
+  bus.sclk_io_num = RFID_SCK_PIN;
+  bus.quadwp_io_num = -1;
+  bus.quadhd_io_num = -1;
+  bus.max_transfer_sz = sizeof(s_tx);
+
+  spi_device_interface_config_t dev = {};
+  dev.mode = 0;
+  dev.clock_speed_hz = RFID_SPI_HZ;
+  dev.spics_io_num = -1;
+  dev.queue_size = 1;
+
+  if (spi_bus_initialize(SPI3_HOST, &bus, SPI_DMA_CH_AUTO) != ESP_OK ||
+      spi_bus_add_device(SPI3_HOST, &dev, &s_spi) != ESP_OK) {
+    Serial.println("[RFID] ERROR: SPI init failed — readers not polled");
+    s_spi = nullptr;
+    return;
+  }
+
+  for (uint8_t r = 0; r < RFID_READER_COUNT; r++) {
+    initReader(r);
+    uint8_t version = readReg(r, REG_VERSION);
+    Serial.print("[RFID] ");
+    Serial.print(RFID_READERS[r].id);
+    Serial.print(" (CS ");
+    Serial.print(RFID_READERS[r].csPin);
+    Serial.print("): ");
+    if (version == 0x00 || version == 0xFF) {
+      Serial.println("NOT RESPONDING");
+    } else {
+      Serial.print("MFRC522 v0x");
+      Serial.println(version, HEX);
+    }
+  }
+
+  // Core 0, below the esp_timer task: the sampler is never delayed by a
+  // reader waiting for a tag.
+  xTaskCreatePinnedToCore(rfidTask, "ey_rfid", 3072, nullptr, 1, nullptr, 0);
+}
+
+// Log rounds that went over budget (from loop(): the task must not print)
+static void logSlowRounds() {
+  uint32_t nowMs = millis();
+  if (nowMs - s_slowLogMs < RFID_SLOW_LOG_MS) return;
+  portENTER_CRITICAL(&s_eventMux);
+  uint32_t count = s_slowRounds;
+  uint32_t maxUs = s_slowMaxUs;
+  s_slowRounds = 0;
+  s_slowMaxUs = 0;
+  portEXIT_CRITICAL(&s_eventMux);
+  if (count == 0) return;
+
+  s_slowLogMs = nowMs;
+  Serial.print("[RFID] WARNING: ");
+  Serial.print(count);
+  Serial.print(" polling round(s) over ");
+  Serial.print(RFID_ROUND_BUDGET_MS);
+  Serial.print(" ms (longest ");
+  Serial.print(maxUs / 1000.0f, 1);
+  Serial.print(" ms, ");
+  Serial.print(RFID_READER_COUNT);
+  Serial.println(" readers)");
+}
+
+void EY_RFID_Tick() {
+  logSlowRounds();
+  for (;;) {
+    TagEvent ev;
+    portENTER_CRITICAL(&s_eventMux);
+    bool have = s_eventCount > 0;
+    if (have) {
+      ev = s_events[s_eventHead];
+      s_eventHead = (uint8_t)((s_eventHead + 1) % RFID_EVENT_QUEUE);
+      s_eventCount--;
+    }
+    portEXIT_CRITICAL(&s_eventMux);
+    if (!have) return;
+
+    char value[48];
+    int len = snprintf(value, sizeof(value), "%s:", RFID_READERS[ev.reader].id);
+    for (uint8_t i = 0; i < ev.uid.length && len < (int)sizeof(value) - 2; i++) {
+      len += snprintf(value + len, sizeof(value) - len, "%02X", ev.uid.bytes[i]);
+    }
+    EY_PublishEventWithData("rfid_tag", EY_MQTT::SRC_PLAYER, "uid", value);
+  }
+}
+
+uint32_t EY_RFID_GetRoundUs() {
+  return s_roundUs;
+}
+
+uint32_t EY_RFID_TakeRoundMaxUs() {
+  portENTER_CRITICAL(&s_eventMux);
+  uint32_t us = s_roundMaxUs;
+  s_roundMaxUs = 0;
+  portEXIT_CRITICAL(&s_eventMux);
+  return us;
+}
+
+#endif // HAS_RFID
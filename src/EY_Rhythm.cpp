@@ -0,0 +1,131 @@
+#include "EY_Rhythm.h"
+#include "EY_Config.h"
+
+#include <string.h>
+
+static constexpr EY_RhythmPattern PATTERN = RHYTHM_PATTERN;
+static const uint8_t MAX_PRESSES = EY_RHYTHM_MAX_GAPS + 1;
+
+struct RhythmState {
+  uint64_t pressUs[MAX_PRESSES];  // Presses of the current attempt, oldest first
+  uint8_t count;
+  uint8_t quality;
+  bool solved;
+};
+
+static RhythmState s_rhythm[PUZZLE_GROUP_COUNT];
+
+// Worst gap error (%) of `count` presses against the start of the pattern,
+// at the tempo those presses set. A single gap fits any tempo.
+static uint32_t worstErrorPct(const uint64_t* pressUs, uint8_t count) {
+  if (count < 3) return 0;
+
+  uint64_t measuredUs = pressUs[count - 1] - pressUs[0];
+  uint32_t units = 0;
+  for (uint8_t j = 0; j + 1 < count; j++) units += PATTERN.gaps[j];
+
+  uint32_t worst = 0;
+  for (uint8_t j = 0; j + 1 < count; j++) {
+    uint64_t expectedUs = measuredUs * PATTERN.gaps[j] / units;
+    uint64_t actualUs = pressUs[j + 1] - pressUs[j];
+    uint64_t diffUs = (actualUs > expectedUs) ? actualUs - expectedUs : expectedUs - actualUs;
+    uint32_t error = expectedUs ? (uint32_t)(diffUs * 100 / expectedUs) : 100;
+    if (error > worst) worst = error;
+  }
+  return worst;
+}
+
+void EY_Rhythm_Reset(uint8_t group) {
+  if (group >= PUZZLE_GROUP_COUNT) return;
+  s_rhythm[group] = {};
+  s_rhythm[group].quality = 100;
+}
+
+bool EY_Rhythm_Press(uint8_t group, uint64_t timeUs) {
+  if (group >= PUZZLE_GROUP_COUNT || PATTERN.gapCount == 0) return false;
+  RhythmState& r = s_rhythm[group];
+  if (r.solved) return true;
+
+  if (r.count > 0 && timeUs - r.pressUs[r.count - 1] > RHYTHM_TIMEOUT_MS * 1000ULL) {
+    r.count = 0;  // Long pause: a new attempt
+  }
+  r.pressUs[r.count++] = timeUs;
+
+  // Drop the oldest presses until the rest fits the start of the pattern
+  uint8_t drop = 0;
+  uint32_t worst = worstErrorPct(r.pressUs, r.count);
+  while (worst > RHYTHM_TOLERANCE_PCT) {
+    drop++;
+    worst = worstErrorPct(r.pressUs + drop, (uint8_t)(r.count - drop));
+  }
+  if (drop > 0) {
+    memmove(r.pressUs, r.pressUs + drop, (r.count - drop) * sizeof(r.pressUs[0]));
+    r.count -= drop;
+  }
+  r.quality = (uint8_t)(100 - worst);
+
+  Serial.print("[Rhythm] Press ");
+  Serial.print(r.count);
+  Serial.print("/");
+  Serial.print(PATTERN.gapCount + 1);
+  Serial.print(" (worst gap error ");
+  Serial.print(worst);
+  Serial.println("%)");
+
+  if (r.count == PATTERN.gapCount + 1) {
+    r.solved = true;
+    Serial.println("[Rhythm] Pattern matched");
+  }
+  return r.solved;
+}
+
+bool EY_Rhythm_ForcePress(uint8_t group, uint64_t timeUs) {
+  if (group >= PUZZLE_GROUP_COUNT || PATTERN.gapCount == 0) return false;
+  RhythmState& r = s_rhythm[group];
+  if (r.solved) return true;
+
+  if (r.count > 0) {
+    // The gap the pattern expects here: at the attempt's tempo once it has
+    // one, else the time since the last press (a single gap fits any tempo)
+    uint64_t lastUs = r.pressUs[r.count - 1];
+    uint64_t gapUs;
+    if (r.count >= 2) {
+      uint32_t units = 0;
+      for (uint8_t j = 0; j + 1 < r.count; j++) units += PATTERN.gaps[j];
+      gapUs = (lastUs - r.pressUs[0]) * PATTERN.gaps[r.count - 1] / units;
+    } else {
+      gapUs = timeUs - lastUs;
+      if (gapUs > RHYTHM_TIMEOUT_MS * 1000ULL) gapUs = RHYTHM_TIMEOUT_MS * 1000ULL;
+    }
+    if (gapUs == 0) gapUs = 1000;
+
+    // Shift the attempt so the forced press lands now, on the rhythm:
+    // later real presses carry on from it
+    for (uint8_t j = 0; j < r.count; j++) r.pressUs[j] = timeUs - gapUs - (lastUs - r.pressUs[j]);
+  }
+  r.pressUs[r.count++] = timeUs;
+
+  Serial.print("[Rhythm] Forced press ");
+  Serial.print(r.count);
+  Serial.print("/");
+  Serial.println(PATTERN.gapCount + 1);
+
+  if (r.count == PATTERN.gapCount + 1) {
+    r.solved = true;
+    Serial.println("[Rhythm] Pattern matched (forced)");
+  }
+  return r.solved;
+}
+
+bool EY_Rhythm_IsSolved(uint8_t group) {
+  return group < PUZZLE_GROUP_COUNT && s_rhythm[group].solved;
+}
+
+uint8_t EY_Rhythm_GetProgress(uint8_t group) {
+  if (group >= PUZZLE_GROUP_COUNT || PATTERN.gapCount == 0) return 0;
+  return (uint8_t)(s_rhythm[group].count * 100 / (PATTERN.gapCount + 1));
+}
+
+uint8_t EY_Rhythm_GetQuality(uint8_t group) {
+  return (group < PUZZLE_GROUP_COUNT) ? s_rhythm[group].quality : 0;
+}
@@ -1,240 +1,727 @@
 #include "EY_Sensors.h"
 #include "EY_Config.h"
 #include "EY_Mqtt.h"
+#include "EY_Inputs.h"
+#include "EY_Debounce.h"
+#include "EY_EdgeLog.h"
+#include "EY_Rhythm.h"
+
+#include <esp_timer.h>
 
 // ------------------------------------------------------------
-// Runtime state for each sensor
+// Runtime state — packed, one bit per sensor (bit i = SENSORS[i])
 // ------------------------------------------------------------
-static SensorState s_states[SENSOR_COUNT];
+static SensorState s_state = {};
+
+// SEQUENCE groups: presses of the group's pattern matched so far (state of
+// its automaton). Solved when it reaches the pattern length.
+static uint8_t s_sequenceIndex[PUZZLE_GROUP_COUNT];
+
+// Groups (bit g = PUZZLE_GROUPS[g]) in which EY_Sensors_Tick observed a
+// sensor present-state change this tick (press or release). Used by
+// main.cpp to republish status on demand.
+static uint32_t s_changedGroups = 0;
+static_assert(PUZZLE_GROUP_COUNT >= 1 && PUZZLE_GROUP_COUNT <= 32, "1 to 32 puzzle groups");
+
+// Cached solve condition per group. Only recomputed when sensor state
+// changes (debounced edge, force-trigger, reset) instead of on every tick.
+static bool s_solved[PUZZLE_GROUP_COUNT];
+
+// Sample time (esp_timer µs) of the change that last solved each group
+// (0 = not solved since the last reset)
+static uint64_t s_solvedAtUs[PUZZLE_GROUP_COUNT];
+static SensorsSolvedCallback s_onSolved = nullptr;
+
+// Sample time of each sensor's last accepted (debounced) transition
+static uint64_t s_acceptedUs[SENSOR_COUNT > 0 ? SENSOR_COUNT : 1];
+
+// One bit per sensor, debounced together
+typedef EY_DebounceWord<SENSOR_COUNT> SensorWord;
+static_assert(SENSOR_COUNT <= 64, "Sensor bitmasks hold at most 64 sensors");
+
+static EY_Debouncer<SensorWord> s_debouncer;
+
+// Read position in the input sampler's ring
+static EY_InputCursor s_cursor;
+
+// Raw presence as of the last replayed sample (edge detection for EY_EdgeLog)
+static SensorMask s_raw = 0;
+
+// Sensors to re-evaluate on the next tick even if their level did not
+// flip (set after Begin/Reset, when every sensor starts from scratch).
+static SensorMask s_pending = 0;
+
+// Debounced level of every sensor, whatever its policy (bit i = SENSORS[i])
+static SensorMask s_level = 0;
+
+// Per-sensor state of the other policies (EY_Debounce.h)
+static EY_LeadingDebounce<SENSOR_COUNT> s_leading;
+static EY_AdaptiveDebounce<SENSOR_COUNT> s_adaptive;
+static EY_MajorityDebounce<SENSOR_COUNT> s_majority;
+
+// ------------------------------------------------------------
+// Compile-time sensor masks, built from SENSORS[]
+// ------------------------------------------------------------
+
+enum class SensorFlag : uint8_t {
+  DECORATIVE, LATCHING, NEEDS_ARMING,
+  TRAILING, LEADING, ADAPTIVE, MAJORITY,
+};
+
+static constexpr SensorMask buildSensorMask(SensorFlag flag) {
+  SensorMask mask = 0;
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    bool match = false;
+    switch (flag) {
+      case SensorFlag::DECORATIVE:   match = SENSORS[i].decorative; break;
+      case SensorFlag::LATCHING:     match = SENSORS[i].latching; break;
+      case SensorFlag::NEEDS_ARMING: match = SENSORS[i].needsArming; break;
+      case SensorFlag::TRAILING:     match = SENSORS[i].debounce == DebouncePolicy::TRAILING; break;
+      case SensorFlag::LEADING:      match = SENSORS[i].debounce == DebouncePolicy::LEADING; break;
+      case SensorFlag::ADAPTIVE:     match = SENSORS[i].debounce == DebouncePolicy::ADAPTIVE; break;
+      case SensorFlag::MAJORITY:     match = SENSORS[i].debounce == DebouncePolicy::MAJORITY; break;
+    }
+    if (match) mask |= EY_SensorBit(i);
+  }
+  return mask;
+}
+
+static constexpr SensorMask DECORATIVE_MASK    = buildSensorMask(SensorFlag::DECORATIVE);
+static constexpr SensorMask LATCHING_MASK      = buildSensorMask(SensorFlag::LATCHING);
+static constexpr SensorMask NEEDS_ARMING_MASK  = buildSensorMask(SensorFlag::NEEDS_ARMING);
+
+// One mask per debounce policy
+static constexpr SensorMask TRAILING_MASK      = buildSensorMask(SensorFlag::TRAILING);
+static constexpr SensorMask LEADING_MASK       = buildSensorMask(SensorFlag::LEADING);
+static constexpr SensorMask ADAPTIVE_MASK      = buildSensorMask(SensorFlag::ADAPTIVE);
+static constexpr SensorMask MAJORITY_MASK      = buildSensorMask(SensorFlag::MAJORITY);
+
+static_assert(DEBOUNCE_MAJORITY_SAMPLES >= 1 && DEBOUNCE_MAJORITY_SAMPLES <= 8,
+              "MAJORITY history holds at most 8 samples");
+static_assert(DEBOUNCE_MAJORITY_THRESHOLD * 2 > DEBOUNCE_MAJORITY_SAMPLES &&
+              DEBOUNCE_MAJORITY_THRESHOLD <= DEBOUNCE_MAJORITY_SAMPLES,
+              "MAJORITY threshold must be a strict majority of the samples");
+
+// ------------------------------------------------------------
+// Compile-time puzzle group masks, built from SENSORS[].group
+// ------------------------------------------------------------
+
+struct GroupMasks {
+  SensorMask sensors[PUZZLE_GROUP_COUNT];  // Every sensor of the group
+  SensorMask solve[PUZZLE_GROUP_COUNT];    // Its non-decorative sensors
+};
+
+static constexpr GroupMasks buildGroupMasks() {
+  GroupMasks m = {};
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    uint8_t g = SENSORS[i].group;
+    if (g >= PUZZLE_GROUP_COUNT) continue;
+    m.sensors[g] |= EY_SensorBit(i);
+    if (!SENSORS[i].decorative) m.solve[g] |= EY_SensorBit(i);
+  }
+  return m;
+}
+
+static constexpr GroupMasks GROUP_MASKS = buildGroupMasks();
+
+static constexpr bool validSensorGroups() {
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    if (SENSORS[i].group >= PUZZLE_GROUP_COUNT) return false;
+  }
+  return true;
+}
+static_assert(validSensorGroups(), "SensorDef::group outside PUZZLE_GROUPS[]");
+
+// Non-decorative sensors of a group (= solve target for SEQUENCE/ALL)
+static constexpr uint8_t groupSolveCount(uint8_t g) {
+  return (uint8_t)__builtin_popcountll(GROUP_MASKS.solve[g]);
+}
+
+static constexpr bool validGroupCounts() {
+  for (uint8_t g = 0; g < PUZZLE_GROUP_COUNT; g++) {
+    if (PUZZLE_GROUPS[g].solveMode != SolveMode::COUNT) continue;
+    if (PUZZLE_GROUPS[g].solveCount == 0 || PUZZLE_GROUPS[g].solveCount > groupSolveCount(g)) return false;
+  }
+  return true;
+}
+static_assert(validGroupCounts(),
+              "SolveMode::COUNT needs 0 < SOLVE_COUNT <= number of non-decorative sensors");
 
-// SEQUENCE mode: index of the next sensor expected to be pressed.
-// Solved when it reaches s_solveSensorCount (excludes decoratives).
-static uint8_t s_sequenceIndex = 0;
+// SolveMode::CUSTOM: prop's SOLVE_EXPR, folded to mask terms at compile time.
+// Shared by every CUSTOM group (it names its sensors by id).
+static constexpr EY_SolveExpr CUSTOM_SOLVE_EXPR = SOLVE_EXPR;
 
-// Count of non-decorative sensors (= solve target for SEQUENCE/ALL).
-// Computed once in EY_Sensors_Begin.
-static uint8_t s_solveSensorCount = 0;
+static constexpr bool usesCustomSolve() {
+  for (uint8_t g = 0; g < PUZZLE_GROUP_COUNT; g++) {
+    if (PUZZLE_GROUPS[g].solveMode == SolveMode::CUSTOM) return true;
+  }
+  return false;
+}
+static_assert(!usesCustomSolve() || CUSTOM_SOLVE_EXPR.termCount > 0,
+              "SolveMode::CUSTOM needs a SOLVE_EXPR that can be satisfied");
 
-// True if EY_Sensors_Tick observed any sensor present-state change this tick
-// (press or release). Used by main.cpp to republish status on demand.
-static bool s_anyStateChangeThisTick = false;
+// SolveMode::SEQUENCE: prop's SEQUENCE_PATTERN (if any) drives the group
+// its sensors belong to; other SEQUENCE groups use their non-decorative
+// sensors in declaration order. Each is compiled to a KMP automaton.
+static constexpr EY_SeqPattern CUSTOM_SEQUENCE = SEQUENCE_PATTERN;
+
+static constexpr uint8_t patternGroup() {
+  return CUSTOM_SEQUENCE.length ? SENSORS[CUSTOM_SEQUENCE.sensors[0]].group : EY_SEQ_NONE;
+}
+
+static constexpr bool validSequencePattern() {
+  for (uint8_t j = 0; j < CUSTOM_SEQUENCE.length; j++) {
+    const SensorDef& def = SENSORS[CUSTOM_SEQUENCE.sensors[j]];
+    if (def.decorative || def.group != patternGroup()) return false;
+  }
+  return CUSTOM_SEQUENCE.length == 0 || PUZZLE_GROUPS[patternGroup()].solveMode == SolveMode::SEQUENCE;
+}
+static_assert(validSequencePattern(),
+              "SEQUENCE_PATTERN needs non-decorative sensors of a single SolveMode::SEQUENCE group");
+
+struct SequenceDfas {
+  EY_SeqDfa group[PUZZLE_GROUP_COUNT];
+};
+
+static constexpr SequenceDfas buildSequenceDfas() {
+  SequenceDfas d{};
+  for (uint8_t g = 0; g < PUZZLE_GROUP_COUNT; g++) {
+    if (PUZZLE_GROUPS[g].solveMode != SolveMode::SEQUENCE) continue;
+    d.group[g] = EY_Seq_Compile(g == patternGroup() ? CUSTOM_SEQUENCE : EY_Seq_FromMask(GROUP_MASKS.solve[g]));
+  }
+  return d;
+}
+
+static constexpr SequenceDfas SEQUENCE_DFAS = buildSequenceDfas();
+
+static constexpr bool validSequenceLengths() {
+  for (uint8_t g = 0; g < PUZZLE_GROUP_COUNT; g++) {
+    if (PUZZLE_GROUPS[g].solveMode != SolveMode::SEQUENCE || g == patternGroup()) continue;
+    if (groupSolveCount(g) > EY_SEQ_MAX_LEN) return false;
+  }
+  return true;
+}
+static_assert(validSequenceLengths(), "SolveMode::SEQUENCE supports at most EY_SEQ_MAX_LEN sensors per group");
+
+// SolveMode::RHYTHM: non-decorative sensors of RHYTHM groups are timed at
+// the first raw edge of each press
+static constexpr SensorMask buildRhythmMask() {
+  SensorMask mask = 0;
+  for (uint8_t g = 0; g < PUZZLE_GROUP_COUNT; g++) {
+    if (PUZZLE_GROUPS[g].solveMode == SolveMode::RHYTHM) mask |= GROUP_MASKS.solve[g];
+  }
+  return mask;
+}
+
+static constexpr SensorMask RHYTHM_MASK = buildRhythmMask();
+static constexpr EY_RhythmPattern RHYTHM = RHYTHM_PATTERN;
+static_assert(RHYTHM_MASK == 0 || RHYTHM.gapCount > 0, "SolveMode::RHYTHM needs a RHYTHM_PATTERN");
+
+// RHYTHM sensors whose raw level has left the debounced one, and when
+static SensorMask s_rhythmBurst = 0;
+static uint64_t s_rhythmEdgeUs[SENSOR_COUNT];
+
+// ------------------------------------------------------------
+// Compile-time pin masks, one per input bank, built from SENSORS[]
+// ------------------------------------------------------------
+
+struct SensorPinMasks {
+  uint64_t pins[EY_INPUT_BANKS];       // Every pin read by a sensor
+  uint64_t activeLow[EY_INPUT_BANKS];  // Pins whose "present" level is LOW
+};
+
+static constexpr SensorPinMasks buildSensorPinMasks() {
+  SensorPinMasks m = {};
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    uint16_t pin = EY_Sensors_InputPin(SENSORS[i]);
+    uint8_t bank = EY_PinBank(pin);
+    if (bank >= EY_INPUT_BANKS) continue;
+    m.pins[bank] |= EY_PinBit(pin);
+    if (EY_Sensors_ActiveLow(SENSORS[i])) m.activeLow[bank] |= EY_PinBit(pin);
+  }
+  return m;
+}
+
+// XOR-ing activeLow into a frame turns every pin into "1 = present",
+// whatever its polarity.
+static constexpr SensorPinMasks SENSOR_PINS = buildSensorPinMasks();
+
+static constexpr bool validSensorPins() {
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    uint16_t pin = EY_Sensors_InputPin(SENSORS[i]);
+    if (EY_PinBank(pin) >= EY_INPUT_BANKS || EY_PinBit(pin) == 0) return false;
+  }
+  return true;
+}
+static_assert(validSensorPins(), "SENSORS[] pin outside the input banks (see EY_Inputs.h)");
+
+static constexpr bool hasAnalogSensors() {
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    if (EY_IsAnalog(SENSORS[i].presentWhen)) return true;
+  }
+  return false;
+}
+#ifndef HAS_ANALOG
+static_assert(!hasAnalogSensors(), "PresentWhen::ABOVE/BELOW sensors need #define HAS_ANALOG in the prop config");
+#endif
+
+static constexpr bool hasTouchSensors() {
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    if (SENSORS[i].presentWhen == PresentWhen::TOUCH) return true;
+  }
+  return false;
+}
+#ifndef HAS_TOUCH
+static_assert(!hasTouchSensors(), "PresentWhen::TOUCH sensors need #define HAS_TOUCH in the prop config");
+#endif
 
 // ------------------------------------------------------------
 // Internal helpers
 // ------------------------------------------------------------
 
-static bool readPresent(const SensorDef& def) {
-  int val = digitalRead(def.pin);
-  return (def.presentWhen == PresentWhen::HIGH_LEVEL) ? (val == HIGH) : (val == LOW);
+// Raw presence of every sensor (bit i = SENSORS[i] present) from one frame
+static SensorMask rawSensorBits(const EY_InputFrame& frame) {
+  uint64_t present[EY_INPUT_BANKS];
+  for (uint8_t b = 0; b < EY_INPUT_BANKS; b++) {
+    present[b] = (frame.bank[b] ^ SENSOR_PINS.activeLow[b]) & SENSOR_PINS.pins[b];
+  }
+  SensorMask bits = 0;
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    uint16_t pin = EY_Sensors_InputPin(SENSORS[i]);
+    if (present[EY_PinBank(pin)] & EY_PinBit(pin)) bits |= EY_SensorBit(i);
+  }
+  return bits;
+}
+
+// Index of the lowest set bit (mask must be non-zero)
+static inline uint8_t lowestSensor(SensorMask mask) {
+  return (uint8_t)__builtin_ctzll(mask);
+}
+
+// ------------------------------------------------------------
+// Debounce policies. Each takes the raw presence held at time `now` (a
+// sample time replayed from the input sampler, see EY_Inputs.h) and returns
+// the sensors whose debounced level (s_level) flipped. Work is proportional
+// to the sensors that use the policy and are actually moving.
+// ------------------------------------------------------------
+
+// TRAILING: shared vertical-counter debouncer, sampled every DEBOUNCE_MS/4
+static SensorMask debounceTrailing(SensorMask raw, unsigned long now) {
+  if (TRAILING_MASK == 0) return 0;
+  SensorMask flipped = (SensorMask)s_debouncer.sampleUntil(now, (SensorWord)(raw & TRAILING_MASK));
+  s_level = (s_level & ~TRAILING_MASK) | (SensorMask)s_debouncer.state;
+  return flipped;
+}
+
+// LEADING: act on the first edge, then hold the level for DEBOUNCE_MS
+static SensorMask debounceLeading(SensorMask raw, unsigned long now) {
+  if (LEADING_MASK == 0) return 0;
+  return s_leading.update(raw, s_level, LEADING_MASK, now);
+}
+
+// ADAPTIVE: trailing, with a quiet window learned per sensor
+static SensorMask debounceAdaptive(SensorMask raw, unsigned long now) {
+  if (ADAPTIVE_MASK == 0) return 0;
+  return s_adaptive.update(raw, s_level, ADAPTIVE_MASK, now);
+}
+
+// MAJORITY: DEBOUNCE_MAJORITY_THRESHOLD of DEBOUNCE_MAJORITY_SAMPLES per DEBOUNCE_MS
+static SensorMask debounceMajority(SensorMask raw, unsigned long now) {
+  if (MAJORITY_MASK == 0) return 0;
+  return s_majority.update(raw, s_level, MAJORITY_MASK, now);
+}
+
+// RHYTHM: remember the first raw edge of each press. An edge back to the
+// debounced level ends the burst (a glitch), so bounces cost at most
+// their own width.
+static void trackRhythmEdges(SensorMask edges, SensorMask raw, uint64_t timeUs) {
+  for (SensorMask m = edges & RHYTHM_MASK; m; m &= m - 1) {
+    uint8_t i = lowestSensor(m);
+    SensorMask bit = EY_SensorBit(i);
+    if ((raw & bit) == (s_level & bit)) {
+      s_rhythmBurst &= ~bit;
+    } else if (!(s_rhythmBurst & bit)) {
+      s_rhythmBurst |= bit;
+      s_rhythmEdgeUs[i] = timeUs;
+    }
+  }
+}
+
+// RHYTHM: feed accepted presses to their group as they are replayed, so
+// several presses between two loop() ticks all count
+static void rhythmPresses(SensorMask flipped, uint64_t timeUs) {
+  if (RHYTHM_MASK == 0) return;
+  SensorMask moved = flipped & RHYTHM_MASK;
+  for (SensorMask m = moved & s_level & s_state.armed; m; m &= m - 1) {
+    uint8_t i = lowestSensor(m);
+    uint64_t pressUs = (s_rhythmBurst & EY_SensorBit(i)) ? s_rhythmEdgeUs[i] : timeUs;
+    EY_Rhythm_Press(SENSORS[i].group, pressUs);
+  }
+  s_rhythmBurst &= ~moved;
+}
+
+static SensorMask debounceAll(SensorMask raw, unsigned long now) {
+  return debounceTrailing(raw, now) | debounceLeading(raw, now) |
+         debounceAdaptive(raw, now) | debounceMajority(raw, now);
+}
+
+// Re-seed every policy from a fresh raw read (no edges reported for
+// sensors that are already present).
+static void seedDebounce(SensorMask raw) {
+  s_level = raw;
+  s_debouncer.reset((SensorWord)(raw & TRAILING_MASK));
+
+  s_leading.reset();
+  s_adaptive.reset(raw);
+  s_majority.reset(raw);
+  s_rhythmBurst = 0;
 }
 
 // Effective presence for solve/status purposes. Latching sensors (momentary-pulse
 // readers) report their latched state; everything else reports live presence.
-static bool effectivePresent(uint8_t i) {
-  return SENSORS[i].latching ? s_states[i].latched : s_states[i].present;
+static SensorMask effectivePresent() {
+  return (s_state.present & ~LATCHING_MASK) | (s_state.latched & LATCHING_MASK);
+}
+
+// One automaton step: a correct press advances by one, a wrong press falls
+// back to the longest part of the pattern it still matches. Returns the
+// step before the press (EY_SEQ_NONE if the group was already solved).
+static uint8_t advanceSequence(uint8_t i) {
+  uint8_t g = SENSORS[i].group;
+  const EY_SeqDfa& dfa = SEQUENCE_DFAS.group[g];
+  uint8_t index = s_sequenceIndex[g];
+  if (index >= dfa.length) return EY_SEQ_NONE;  // Already solved
+
+  s_sequenceIndex[g] = dfa.advance(index, i);
+  return index;
 }
 
-static void handleSequencePress(uint8_t i) {
-  if (i == s_sequenceIndex) {
-    s_sequenceIndex++;
-    EY_PublishEvent(SENSORS[i].actionEvent, EY_MQTT::SRC_PLAYER);
+// Event + log of a press applied by advanceSequence()
+static void reportSequencePress(uint8_t i, uint8_t prev) {
+  if (prev == EY_SEQ_NONE) return;
+  uint8_t g = SENSORS[i].group;
+  uint8_t index = s_sequenceIndex[g];
+  if (index == prev + 1) {
+    EY_PublishGroupEvent(g, SENSORS[i].actionEvent, EY_MQTT::SRC_PLAYER);
     Serial.print("[Sequence] OK ");
-    Serial.print(s_sequenceIndex);
+    Serial.print(index);
     Serial.print("/");
-    Serial.println(s_solveSensorCount);
+    Serial.println(SEQUENCE_DFAS.group[g].length);
   } else {
-    Serial.print("[Sequence] Wrong press (expected idx ");
-    Serial.print(s_sequenceIndex);
-    Serial.print(", got ");
-    Serial.print(i);
-    Serial.println(") — sequence reset");
-    s_sequenceIndex = 0;
+    Serial.print("[Sequence] Wrong press at step ");
+    Serial.print(prev);
+    Serial.print(" (");
+    Serial.print(SENSORS[i].id);
+    Serial.print(") — back to step ");
+    Serial.println(index);
   }
 }
 
-static bool evaluateSolveCondition() {
-  switch (SOLVE_MODE) {
+// Mask operations only — cost does not grow with the sensor count.
+static bool evaluateSolveCondition(uint8_t g) {
+  const PuzzleGroupDef& group = PUZZLE_GROUPS[g];
+  SensorMask solveMask = GROUP_MASKS.solve[g];
+  SensorMask solvePresent = effectivePresent() & solveMask;
+
+  switch (group.solveMode) {
     case SolveMode::ANY:
-      for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
-        if (SENSORS[i].decorative) continue;
-        if (effectivePresent(i)) return true;
-      }
-      return false;
+      return solvePresent != 0;
 
     case SolveMode::ALL:
-      for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
-        if (SENSORS[i].decorative) continue;
-        if (!effectivePresent(i)) return false;
-      }
-      return (s_solveSensorCount > 0);
+      return (solveMask != 0) && (solvePresent == solveMask);
+
+    case SolveMode::COUNT:
+      return (group.solveCount > 0) && (__builtin_popcountll(solvePresent) >= group.solveCount);
+
+    case SolveMode::CUSTOM:
+      return CUSTOM_SOLVE_EXPR.eval(effectivePresent());
+
+    case SolveMode::RHYTHM:
+      return EY_Rhythm_IsSolved(g);
 
     case SolveMode::SEQUENCE:
-      return (s_solveSensorCount > 0) && (s_sequenceIndex >= s_solveSensorCount);
+      return (SEQUENCE_DFAS.group[g].length > 0) && (s_sequenceIndex[g] >= SEQUENCE_DFAS.group[g].length);
 
     default:
       return false;
   }
 }
 
+// Re-evaluate the groups a change can affect: `groups`, plus CUSTOM groups
+// (their expressions may reference any sensor). A group that has just
+// solved fires the solved callback right away, before the change that
+// solved it is logged or published.
+static void refreshSolved(uint32_t groups, uint64_t timeUs) {
+  for (uint8_t g = 0; g < PUZZLE_GROUP_COUNT; g++) {
+    if (!(groups & (1UL << g)) && PUZZLE_GROUPS[g].solveMode != SolveMode::CUSTOM) continue;
+    bool solved = evaluateSolveCondition(g);
+    bool solvedNow = solved && !s_solved[g];
+    s_solved[g] = solved;
+    if (solvedNow) {
+      s_solvedAtUs[g] = timeUs;
+      if (s_onSolved) s_onSolved(g);
+    }
+  }
+}
+
+// Clear the session state of one group's sensors. Debounced levels are
+// kept (they follow the hardware); the sensors are re-evaluated next tick.
+static void resetGroupState(uint8_t g) {
+  SensorMask mask = GROUP_MASKS.sensors[g];
+  s_state.armed = (s_state.armed & ~mask) | (~NEEDS_ARMING_MASK & mask);  // Pre-armed if arming not required
+  s_state.present &= ~mask;
+  s_state.latched &= ~mask;
+  s_state.eventSent &= ~mask;
+  s_state.forceLocked &= ~mask;
+  s_pending |= mask;
+  s_sequenceIndex[g] = 0;
+  EY_Rhythm_Reset(g);
+  s_solved[g] = evaluateSolveCondition(g);
+  s_solvedAtUs[g] = 0;
+
+  // Sensors already present count from the reset
+  uint64_t nowUs = (uint64_t)esp_timer_get_time();
+  for (SensorMask m = mask; m; m &= m - 1) s_acceptedUs[lowestSensor(m)] = nowUs;
+}
+
 // ------------------------------------------------------------
 // Public API
 // ------------------------------------------------------------
 
 void EY_Sensors_Begin() {
-  s_solveSensorCount = 0;
+  // Expander, matrix, analog and touch pins are configured by their backend
   for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
-    pinMode(SENSORS[i].pin, INPUT_PULLUP);
-
-    // Initialize state
-    s_states[i].armed = !SENSORS[i].needsArming;  // Pre-armed if arming not required
-    s_states[i].present = false;
-    s_states[i].latched = false;
-    s_states[i].eventSent = false;
-    s_states[i].forceLocked = false;
-    s_states[i].lastRaw = readPresent(SENSORS[i]);
-    s_states[i].lastChangeMs = millis();
-
-    if (!SENSORS[i].decorative) s_solveSensorCount++;
+    uint16_t pin = EY_Sensors_InputPin(SENSORS[i]);
+    if (EY_PinBank(pin) == EY_BANK_GPIO) pinMode(pin, INPUT_PULLUP);
   }
+
+  s_debouncer.begin(DEBOUNCE_MS, 0);
+  s_leading.begin(DEBOUNCE_MS);
+  // Adaptive windows are learned from here on, kept across resets
+  s_adaptive.begin(DEBOUNCE_MS, DEBOUNCE_ADAPTIVE_MIN_MS, DEBOUNCE_ADAPTIVE_MAX_MS, 0);
+  s_majority.begin(DEBOUNCE_MS, DEBOUNCE_MAJORITY_SAMPLES, DEBOUNCE_MAJORITY_THRESHOLD, 0);
+  EY_Sensors_Reset();
 }
 
-bool EY_Sensors_Tick() {
-  bool anyTransition = false;
-  s_anyStateChangeThisTick = false;
+void EY_Sensors_Tick() {
+  s_changedGroups = 0;
+
+  // Replay every input change sampled since the last tick, in order and at
+  // the time it was sampled, through each sensor's debounce policy. Only
+  // sensors whose debounced level flipped — or that are pending after a
+  // reset — need evaluating.
+  SensorMask todo = s_pending;
+  SensorMask armedNow = 0;
+  s_pending = 0;
+  EY_Inputs_Replay(s_cursor, [&todo, &armedNow](const EY_InputFrame& frame, uint64_t timeUs) {
+    SensorMask raw = rawSensorBits(frame);
+    for (SensorMask m = raw ^ s_raw; m; m &= m - 1) {
+      uint8_t i = lowestSensor(m);
+      EY_EdgeLog_RawEdge(i, raw & EY_SensorBit(i), s_level & EY_SensorBit(i), timeUs);
+    }
+    trackRhythmEdges(raw ^ s_raw, raw, timeUs);
+    s_raw = raw;
+
+    SensorMask flipped = debounceAll(raw, EY_Inputs_Millis(timeUs));
+    for (SensorMask m = flipped; m; m &= m - 1) {
+      uint8_t i = lowestSensor(m);
+      s_acceptedUs[i] = timeUs;
+      EY_EdgeLog_Accepted(i, timeUs);
+    }
+    // Arming: a sensor that must be seen "not present" first is armed as
+    // soon as its debounced level is low, so a press right after it in
+    // the same replay counts (and is timed)
+    SensorMask arming = NEEDS_ARMING_MASK & ~s_state.armed & ~s_level;
+    s_state.armed |= arming;
+    armedNow |= arming;
+    rhythmPresses(flipped, timeUs);
+    todo |= flipped | arming;
+  });
+  // Sensors force-triggered by GM are preserved until reset
+  todo &= ~(s_state.present & s_state.forceLocked);
+  if (todo == 0) return;
 
   for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
-    const SensorDef& def = SENSORS[i];
-    SensorState& state = s_states[i];
+    SensorMask bit = EY_SensorBit(i);
+    if (!(todo & bit)) continue;
 
-    // Skip sensors that were force-triggered by GM (preserved until reset)
-    if (state.present && state.forceLocked) continue;
-
-    bool raw = readPresent(def);
-
-    // Debounce: track raw GPIO changes, only accept after stable for DEBOUNCE_MS
-    if (raw != state.lastRaw) {
-      state.lastRaw = raw;
-      state.lastChangeMs = millis();
-    }
-    if (millis() - state.lastChangeMs < DEBOUNCE_MS) continue;
+    const SensorDef& def = SENSORS[i];
+    const SolveMode mode = PUZZLE_GROUPS[def.group].solveMode;
+    bool raw = (s_level & bit) != 0;  // debounced level
 
     // Arming logic: must see "not present" before "present" counts
-    if (def.needsArming && !state.armed) {
-      if (!raw) {
-        state.armed = true;
-        Serial.print("[Sensor] ");
-        Serial.print(def.id);
-        Serial.println(" armed");
+    if (armedNow & bit) {
+      Serial.print("[Sensor] ");
+      Serial.print(def.id);
+      Serial.println(" armed");
+    }
+    if ((NEEDS_ARMING_MASK & ~s_state.armed) & bit) continue;  // Not armed yet, so presence doesn't count
+
+    bool wasPresent = (s_state.present & bit) != 0;
+    if (raw) s_state.present |= bit;
+    else     s_state.present &= ~bit;
+
+    // Apply the change and re-evaluate before any logging: a solving
+    // press releases the group's outputs first
+    bool pressed = raw && !wasPresent;
+    bool decoyReset = false;
+    uint8_t seqPrev = EY_SEQ_NONE;
+    if (pressed) {
+      s_state.latched |= (bit & LATCHING_MASK);  // momentary readers: latch until reset
+      if (mode == SolveMode::SEQUENCE) {
+        if (!def.decorative) {
+          seqPrev = advanceSequence(i);
+        } else if (s_sequenceIndex[def.group] > 0) {
+          // A decorative button is a "decoy" / wrong button → pressing it
+          // resets progress, just like an out-of-order real press
+          s_sequenceIndex[def.group] = 0;
+          decoyReset = true;
+        }
       }
-      // Not armed yet, so presence doesn't count
-      continue;
     }
-
-    bool wasPresent = state.present;
-    state.present = raw;
+    refreshSolved(1UL << def.group, s_acceptedUs[i]);
 
     // Detect transition to present
-    if (state.present && !wasPresent) {
-      anyTransition = true;
-      s_anyStateChangeThisTick = true;
-      if (def.latching) state.latched = true;  // momentary readers: latch until reset
+    if (pressed) {
+      s_changedGroups |= 1UL << def.group;
       Serial.print("[Sensor] ");
       Serial.print(def.id);
       Serial.println(" -> PRESENT");
 
       if (def.decorative) {
         // Decorative: publish on every press (e.g. sound feedback).
-        EY_PublishEvent(def.actionEvent, EY_MQTT::SRC_PLAYER);
-        // In SEQUENCE mode a decorative button is a "decoy" / wrong button →
-        // pressing it resets progress, just like an out-of-order real press,
-        // so the dashboard clears the green steps.
-        if (SOLVE_MODE == SolveMode::SEQUENCE && s_sequenceIndex > 0) {
-          Serial.println("[Sequence] Decoy pressed — sequence reset");
-          s_sequenceIndex = 0;
-        }
-      } else if (SOLVE_MODE == SolveMode::SEQUENCE) {
-        handleSequencePress(i);
-      } else if (!state.eventSent) {
-        // ANY/ALL: publish one-shot event (once per reset)
-        EY_PublishEvent(def.actionEvent, EY_MQTT::SRC_PLAYER);
-        state.eventSent = true;
+        EY_PublishGroupEvent(def.group, def.actionEvent, EY_MQTT::SRC_PLAYER);
+        // The status republish clears the decoyed sequence's green steps
+        if (decoyReset) Serial.println("[Sequence] Decoy pressed — sequence reset");
+      } else if (mode == SolveMode::SEQUENCE) {
+        reportSequencePress(i, seqPrev);
+      } else if (!(s_state.eventSent & bit)) {
+        // ANY/ALL/COUNT/CUSTOM/RHYTHM: publish one-shot event (once per reset)
+        EY_PublishGroupEvent(def.group, def.actionEvent, EY_MQTT::SRC_PLAYER);
+        s_state.eventSent |= bit;
       }
     }
 
     // Detect transition to not present
-    if (!state.present && wasPresent) {
-      s_anyStateChangeThisTick = true;
+    if (!raw && wasPresent) {
+      s_changedGroups |= 1UL << def.group;
       Serial.print("[Sensor] ");
       Serial.print(def.id);
       Serial.println(" -> ABSENT");
     }
   }
-
-  return evaluateSolveCondition();
 }
 
 void EY_Sensors_Reset() {
-  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
-    s_states[i].armed = !SENSORS[i].needsArming;
-    s_states[i].present = false;
-    s_states[i].latched = false;
-    s_states[i].eventSent = false;
-    s_states[i].forceLocked = false;
-    s_states[i].lastRaw = readPresent(SENSORS[i]);
-    s_states[i].lastChangeMs = millis();
-  }
-  s_sequenceIndex = 0;
+  s_state.decorative = DECORATIVE_MASK;
+  EY_Inputs_CursorBegin(s_cursor);
+  s_raw = rawSensorBits(s_cursor.frame);
+  seedDebounce(s_raw);
+  EY_EdgeLog_Reset();
+  for (uint8_t g = 0; g < PUZZLE_GROUP_COUNT; g++) resetGroupState(g);
   Serial.println("[Sensor] All sensors reset");
 }
 
-bool EY_Sensors_IsSolved() {
-  return evaluateSolveCondition();
+void EY_Sensors_Resync() {
+  // Drop the changes sampled since the last tick: start over from the
+  // current levels, which every sensor takes on the next tick
+  EY_Inputs_CursorBegin(s_cursor);
+  s_raw = rawSensorBits(s_cursor.frame);
+  seedDebounce(s_raw);
+
+  uint64_t nowUs = (uint64_t)esp_timer_get_time();
+  for (SensorMask m = s_raw ^ s_state.present; m; m &= m - 1) s_acceptedUs[lowestSensor(m)] = nowUs;
+  for (uint8_t g = 0; g < PUZZLE_GROUP_COUNT; g++) s_pending |= GROUP_MASKS.sensors[g];
+}
+
+void EY_Sensors_ResetGroup(uint8_t group) {
+  if (group >= PUZZLE_GROUP_COUNT) return;
+  resetGroupState(group);
+  Serial.print("[Sensor] Group ");
+  Serial.print(group);
+  Serial.println(" sensors reset");
+}
+
+bool EY_Sensors_IsSolved(uint8_t group) {
+  return group < PUZZLE_GROUP_COUNT && s_solved[group];
+}
+
+uint64_t EY_Sensors_GetSolvedAtUs(uint8_t group) {
+  return (group < PUZZLE_GROUP_COUNT) ? s_solvedAtUs[group] : 0;
+}
+
+void EY_Sensors_OnSolved(SensorsSolvedCallback cb) {
+  s_onSolved = cb;
+}
+
+SensorMask EY_Sensors_GetGroupMask(uint8_t group) {
+  return (group < PUZZLE_GROUP_COUNT) ? GROUP_MASKS.sensors[group] : 0;
+}
+
+const SensorState& EY_Sensors_GetState() {
+  return s_state;
 }
 
-const SensorState* EY_Sensors_GetState(uint8_t index) {
-  if (index >= SENSOR_COUNT) return nullptr;
-  return &s_states[index];
+uint8_t EY_Sensors_GetPresentCount() {
+  return __builtin_popcountll(s_state.present);
 }
 
 uint8_t EY_Sensors_GetCount() {
   return SENSOR_COUNT;
 }
 
-uint8_t EY_Sensors_GetSequenceIndex() {
-  return (SOLVE_MODE == SolveMode::SEQUENCE) ? s_sequenceIndex : 0;
+uint8_t EY_Sensors_GetSequenceIndex(uint8_t group) {
+  if (group >= PUZZLE_GROUP_COUNT || PUZZLE_GROUPS[group].solveMode != SolveMode::SEQUENCE) return 0;
+  return s_sequenceIndex[group];
 }
 
-bool EY_Sensors_StateChangedThisTick() {
-  return s_anyStateChangeThisTick;
+SensorMask EY_Sensors_GetSequenceDone(uint8_t group) {
+  uint8_t done = EY_Sensors_GetSequenceIndex(group);
+  SensorMask mask = 0;
+  for (uint8_t j = 0; j < done; j++) mask |= EY_SensorBit(SEQUENCE_DFAS.group[group].steps[j]);
+  return mask;
 }
 
-bool EY_Sensors_ForceTrigger(const char* sensorId) {
+bool EY_Sensors_StateChangedThisTick(uint8_t group) {
+  return group < PUZZLE_GROUP_COUNT && (s_changedGroups & (1UL << group));
+}
+
+bool EY_Sensors_ForceTrigger(uint8_t group, const char* sensorId) {
   if (!sensorId) return false;
 
   for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    if (group != EY_ALL_GROUPS && SENSORS[i].group != group) continue;
     if (strcmp(SENSORS[i].id, sensorId) == 0) {
-      SensorState& state = s_states[i];
+      SensorMask bit = EY_SensorBit(i);
+      uint8_t g = SENSORS[i].group;
 
       // Force the sensor to triggered state (locked until reset)
-      state.armed = true;
-      state.present = true;
-      state.latched = true;
-      state.forceLocked = true;
+      s_state.armed |= bit;
+      s_state.present |= bit;
+      s_state.latched |= bit;
+      s_state.forceLocked |= bit;
 
       Serial.print("[Sensor] ");
       Serial.print(sensorId);
       Serial.println(" -> FORCE TRIGGERED (GM)");
 
       // In SEQUENCE mode, GM force-trigger advances progress by one step.
-      // Force-triggering every sensor reaches SENSOR_COUNT -> solved.
-      if (SOLVE_MODE == SolveMode::SEQUENCE && s_sequenceIndex < SENSOR_COUNT) {
-        s_sequenceIndex++;
+      // One force-trigger per pattern step reaches its length -> solved.
+      if (PUZZLE_GROUPS[g].solveMode == SolveMode::SEQUENCE && s_sequenceIndex[g] < SEQUENCE_DFAS.group[g].length) {
+        s_sequenceIndex[g]++;
       }
 
+      // Same in RHYTHM mode: one force-trigger per press of the rhythm
+      if (PUZZLE_GROUPS[g].solveMode == SolveMode::RHYTHM) {
+        EY_Rhythm_ForcePress(g, (uint64_t)esp_timer_get_time());
+      }
+
+      refreshSolved(1UL << g, (uint64_t)esp_timer_get_time());
+
       // Publish event if not already sent
-      if (!state.eventSent) {
-        EY_PublishEvent(SENSORS[i].actionEvent, EY_MQTT::SRC_GM);
-        state.eventSent = true;
+      if (!(s_state.eventSent & bit)) {
+        EY_PublishGroupEvent(g, SENSORS[i].actionEvent, EY_MQTT::SRC_GM);
+        s_state.eventSent |= bit;
       }
 
       return true;
@@ -0,0 +1,255 @@
+#include "EY_Config.h"  // Must be first — brings in PROP_CONFIG which may define HAS_SERVO
+
+#ifdef HAS_SERVO
+
+#include "EY_Servo.h"
+#include "EY_Outputs.h"  // For EY_OUT_BANK_PCA9685
+#include "EY_Timer.h"
+
+#ifdef HAS_PCA9685
+#include "EY_PCA9685.h"
+#endif
+
+#include <esp_timer.h>
+
+#ifndef SERVO_MOVE_MS
+  #define SERVO_MOVE_MS 0
+#endif
+#ifndef SERVO_PROFILE
+  #define SERVO_PROFILE ServoProfile::EASE
+#endif
+
+static_assert(SERVO_COUNT >= 1, "HAS_SERVO needs at least one entry in SERVOS[]");
+
+static constexpr uint32_t FRAME_US = 20000;     // 50 Hz servo frame
+static constexpr uint8_t  LEDC_BITS = 16;
+static constexpr uint8_t  LEDC_CHANNELS = 16;
+
+struct ServoMove {
+  float target;
+  uint32_t ms;
+  ServoProfile profile;
+};
+
+struct ServoMotion {
+  float angle;        // Commanded now
+  float from;         // Angle the current move started at
+  ServoMove move;
+  uint64_t startUs;
+  bool moving;
+  bool queued;
+  ServoMove next;
+  int8_t channel;     // LEDC channel; -1 = PCA9685 channel or not driven
+  bool driven;
+};
+
+static ServoMotion s_servos[SERVO_COUNT];
+static portMUX_TYPE s_servoMux = portMUX_INITIALIZER_UNLOCKED;
+static int8_t s_timer = -1;
+
+// Fraction of the distance covered at fraction `u` of the duration
+static float shape(float u, ServoProfile profile) {
+  switch (profile) {
+    case ServoProfile::LINEAR:
+      return u;
+    case ServoProfile::TRAPEZOID:
+      // Accelerate for 1/3, cruise at 1.5x the mean speed, decelerate for 1/3
+      if (u < 1.0f / 3) return 2.25f * u * u;
+      if (u > 2.0f / 3) return 1.0f - 2.25f * (1.0f - u) * (1.0f - u);
+      return 1.5f * u - 0.25f;
+    case ServoProfile::EASE:
+    default:
+      return u * u * (3.0f - 2.0f * u);
+  }
+}
+
+static void writeAngle(uint8_t index, float angle) {
+  const ServoDef& def = SERVOS[index];
+  uint32_t us = def.minUs + (uint32_t)((def.maxUs - def.minUs) * angle / 180.0f + 0.5f);
+  if (s_servos[index].channel >= 0) {
+    ledcWrite(s_servos[index].channel, (us << LEDC_BITS) / FRAME_US);
+  }
+#ifdef HAS_PCA9685
+  else if (s_servos[index].driven) {
+    EY_PCA9685_SetDuty(def.pin & 0xFF, (uint16_t)((us * 4096UL * PCA9685_PWM_HZ) / 1000000UL));
+  }
+#endif
+}
+
+// Start a move from the current angle (call with s_servoMux held)
+static void startMove(ServoMotion& s, const ServoMove& move, uint64_t nowUs) {
+  s.from = s.angle;
+  s.move = move;
+  s.startUs = nowUs;
+  s.moving = true;
+}
+
+// Timer callback: advance every running move by one frame
+static void step(void*) {
+  uint64_t nowUs = (uint64_t)esp_timer_get_time();
+  float angles[SERVO_COUNT];
+  bool changed[SERVO_COUNT];
+  bool running = false;
+
+  portENTER_CRITICAL(&s_servoMux);
+  for (uint8_t i = 0; i < SERVO_COUNT; i++) {
+    ServoMotion& s = s_servos[i];
+    changed[i] = s.moving;
+    if (!s.moving) continue;
+    uint64_t elapsedUs = nowUs - s.startUs;
+    uint64_t durationUs = (uint64_t)s.move.ms * 1000;
+    if (elapsedUs >= durationUs) {
+      s.angle = s.move.target;
+      s.moving = false;
+      if (s.queued) {
+        s.queued = false;
+        startMove(s, s.next, nowUs);
+      }
+    } else {
+      float u = (float)elapsedUs / (float)durationUs;
+      s.angle = s.from + (s.move.target - s.from) * shape(u, s.move.profile);
+    }
+    angles[i] = s.angle;
+    running |= s.moving;
+  }
+  portEXIT_CRITICAL(&s_servoMux);
+
+  for (uint8_t i = 0; i < SERVO_COUNT; i++) {
+    if (changed[i]) writeAngle(i, angles[i]);
+  }
+  if (running) EY_Timer_At(s_timer, nowUs + FRAME_US);
+}
+
+static float clampAngle(float angle) {
+  return (angle < 0) ? 0 : (angle > 180) ? 180 : angle;
+}
+
+static void logMove(uint8_t index, float angle, uint32_t ms, const char* verb) {
+  Serial.print("[Servo] ");
+  Serial.print(SERVOS[index].id);
+  Serial.print(verb);
+  Serial.print((int)(angle + 0.5f));
+  Serial.print("° in ");
+  Serial.print(ms);
+  Serial.println(" ms");
+}
+
+// ---- Public API ----
+
+void EY_Servo_Begin() {
+  uint8_t channel = 0;
+  for (uint8_t i = 0; i < SERVO_COUNT; i++) {
+    const ServoDef& def = SERVOS[i];
+    ServoMotion& s = s_servos[i];
+    s = {};
+    s.channel = -1;
+    s.angle = clampAngle(def.closedAngle);
+
+    uint16_t pin = def.pin;
+    if (EY_PinBank(pin) == EY_OUT_BANK_GPIO && pin <= 33 && channel < LEDC_CHANNELS) {
+      s.channel = (int8_t)channel++;
+      ledcSetup(s.channel, 1000000UL / FRAME_US, LEDC_BITS);
+      ledcAttachPin(pin, s.channel);
+      s.driven = true;
+    }
+#ifdef HAS_PCA9685
+    else if (EY_PinBank(pin) == EY_OUT_BANK_PCA9685 && (pin & 0xFF) < PCA9685_COUNT * 16) {
+      s.driven = (PCA9685_PWM_HZ == 50);
+      if (!s.driven) Serial.println("[Servo] ERROR: PCA9685 servos need PCA9685_PWM_HZ 50");
+    }
+#endif
+    if (!s.driven) {
+      Serial.print("[Servo] ERROR: ");
+      Serial.print(def.id);
+      Serial.println(" has no usable pin (GPIO 0-33, 16 LEDC channels) — not driven");
+      continue;
+    }
+    writeAngle(i, s.angle);
+  }
+  s_timer = EY_Timer_Create(&step, nullptr);
+
+  Serial.print("[Servo] ");
+  Serial.print(SERVO_COUNT);
+  Serial.println(" servos parked");
+
+#ifdef SERVO_BOOT_SWEEP_MS
+  // Wiring check: open and back, in the background
+  for (uint8_t i = 0; i < SERVO_COUNT; i++) {
+    EY_Servo_Move(i, SERVOS[i].openAngle, SERVO_BOOT_SWEEP_MS, ServoProfile::EASE);
+    EY_Servo_Queue(i, SERVOS[i].closedAngle, SERVO_BOOT_SWEEP_MS, ServoProfile::EASE);
+  }
+#endif
+}
+
+void EY_Servo_Move(uint8_t index, float angle, uint32_t ms, ServoProfile profile) {
+  if (index >= SERVO_COUNT || !s_servos[index].driven) return;
+  angle = clampAngle(angle);
+  portENTER_CRITICAL(&s_servoMux);
+  ServoMotion& s = s_servos[index];
+  s.queued = false;
+  startMove(s, { angle, ms, profile }, (uint64_t)esp_timer_get_time());
+  portEXIT_CRITICAL(&s_servoMux);
+  logMove(index, angle, ms, " -> ");
+  EY_Timer_At(s_timer, 1);  // First frame now
+}
+
+void EY_Servo_Queue(uint8_t index, float angle, uint32_t ms, ServoProfile profile) {
+  if (index >= SERVO_COUNT || !s_servos[index].driven) return;
+  angle = clampAngle(angle);
+  portENTER_CRITICAL(&s_servoMux);
+  ServoMotion& s = s_servos[index];
+  bool idle = !s.moving;
+  if (idle) {
+    startMove(s, { angle, ms, profile }, (uint64_t)esp_timer_get_time());
+  } else {
+    s.next = { angle, ms, profile };
+    s.queued = true;
+  }
+  portEXIT_CRITICAL(&s_servoMux);
+  logMove(index, angle, ms, idle ? " -> " : " then -> ");
+  if (idle) EY_Timer_At(s_timer, 1);
+}
+
+void EY_Servo_Open(uint8_t group) {
+  for (uint8_t i = 0; i < SERVO_COUNT; i++) {
+    if (group == EY_ALL_GROUPS || SERVOS[i].group == group) {
+      EY_Servo_Move(i, SERVOS[i].openAngle, SERVO_MOVE_MS, SERVO_PROFILE);
+    }
+  }
+}
+
+void EY_Servo_Close(uint8_t group) {
+  for (uint8_t i = 0; i < SERVO_COUNT; i++) {
+    if (group == EY_ALL_GROUPS || SERVOS[i].group == group) {
+      EY_Servo_Move(i, SERVOS[i].closedAngle, SERVO_MOVE_MS, SERVO_PROFILE);
+    }
+  }
+}
+
+int8_t EY_Servo_Find(uint8_t group, const char* id) {
+  if (!id) return -1;
+  for (uint8_t i = 0; i < SERVO_COUNT; i++) {
+    if ((group == EY_ALL_GROUPS || SERVOS[i].group == group) && strcmp(SERVOS[i].id, id) == 0) {
+      return (int8_t)i;
+    }
+  }
+  return -1;
+}
+
+float EY_Servo_GetAngle(uint8_t index) {
+  if (index >= SERVO_COUNT) return 0;
+  portENTER_CRITICAL(&s_servoMux);
+  float angle = s_servos[index].angle;
+  portEXIT_CRITICAL(&s_servoMux);
+  return angle;
+}
+
+bool EY_Servo_IsMoving(uint8_t index) {
+  if (index >= SERVO_COUNT) return false;
+  portENTER_CRITICAL(&s_servoMux);
+  bool moving = s_servos[index].moving;
+  portEXIT_CRITICAL(&s_servoMux);
+  return moving;
+}
+
+#endif // HAS_SERVO
@@ -4,6 +4,7 @@
 
 #include "EY_Shaker.h"
 #include "EY_Mqtt.h"
+#include "EY_Loop.h"
 #include <esp_now.h>
 #include <WiFi.h>
 
@@ -33,6 +34,7 @@ static void onEspNowRecv(const uint8_t *mac, const uint8_t *data, int len) {
       s_lastShakeMs = millis();
       s_shakeReceived = true;
       s_packetCount++;
+      EY_Loop_Wake();  // Count the shake from now, not from the next poll
     }
   }
 }
@@ -127,6 +129,14 @@ bool EY_Shaker_Tick() {
     return true;
   }
 
+  // Next pass no later than the next report, the solve if the shaking
+  // keeps up, or the end of the shake window
+  EY_Loop_WakeAt(s_lastReportMs + SHAKE_REPORT_INTERVAL_MS);
+  if (shaking) {
+    EY_Loop_WakeAt(now + (uint32_t)((float)SHAKE_TARGET_MS - s_accumulatedMs));
+    EY_Loop_WakeAt(s_lastShakeMs + SHAKE_TIMEOUT_MS);
+  }
+
   return false;
 }
 
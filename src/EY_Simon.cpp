@@ -4,23 +4,47 @@
 
 #include "EY_Simon.h"
 #include "EY_Mqtt.h"
+#include "EY_Inputs.h"
+#include "EY_Outputs.h"
+#include "EY_Debounce.h"
+#include "EY_Loop.h"
 #include <Arduino.h>
 
 // ---- Per-button state ----
 struct SimonButton {
-  // Game
   bool locked;
   bool ledOn;
   unsigned long nextBlinkAt;
   unsigned long blinkOffAt;
-
-  // Debounce
-  bool lastRead;
-  unsigned long lastChangeMs;
-  bool stablePressed;
 };
 
 static SimonButton s_btns[SIMON_COUNT];
+
+// All buttons debounced together: bit i = button i pressed
+typedef EY_DebounceWord<SIMON_COUNT> SimonWord;
+static EY_Debouncer<SimonWord> s_debouncer;
+
+// Read position in the input sampler's ring
+static EY_InputCursor s_cursor;
+
+// Raw pressed state of every button (LOW = pressed) from one GPIO snapshot
+static SimonWord rawPressedBits(uint64_t snapshot) {
+  SimonWord bits = 0;
+  for (uint8_t i = 0; i < SIMON_COUNT; i++) {
+    if (!EY_Inputs_PinHigh(snapshot, SIMON_BTN_PINS[i])) bits |= (SimonWord)1 << i;
+  }
+  return bits;
+}
+
+// Replay sampled input changes through the debouncer; returns buttons that
+// became pressed since the last tick
+static SimonWord debouncedPresses() {
+  SimonWord presses = 0;
+  EY_Inputs_Replay(s_cursor, [&presses](const EY_InputFrame& frame, uint64_t timeUs) {
+    presses |= s_debouncer.sampleUntil(EY_Inputs_Millis(timeUs), rawPressedBits(frame.bank[EY_BANK_GPIO])) & s_debouncer.state;
+  });
+  return presses;
+}
 static bool s_active = false;
 static uint8_t s_lockedCount = 0;
 
@@ -31,6 +55,66 @@ static bool s_victoryActive = false;
 static uint8_t s_victoryPhasesLeft = 0;
 static unsigned long s_victoryNextAt = 0;
 
+// Loop timer (EY_Loop.h): next blink edge or victory phase
+static int8_t s_timer = -1;
+
+// Arm the loop timer for the earliest pending LED deadline
+static void schedule() {
+  EY_Loop_Cancel(s_timer);
+  if (!s_active) return;
+  if (s_victoryActive) {
+    EY_Loop_At(s_timer, s_victoryNextAt);
+    return;
+  }
+  for (uint8_t i = 0; i < SIMON_COUNT; i++) {
+    const SimonButton& btn = s_btns[i];
+    if (!btn.locked) EY_Loop_At(s_timer, btn.ledOn ? btn.blinkOffAt : btn.nextBlinkAt);
+  }
+}
+
+// Loop timer callback: LED blinks and the victory animation
+static void step(void*) {
+  if (!s_active) return;
+  unsigned long now = millis();
+
+  // ---- Victory animation ----
+  // Runs after the last button locks. Drives every LED in lockstep; button
+  // blinks are over by then, so a stray late press can't fight it.
+  if (s_victoryActive) {
+    if ((long)(now - s_victoryNextAt) >= 0) {
+      s_victoryPhasesLeft--;
+      bool ledsOn = (s_victoryPhasesLeft % 2 == 0);
+      for (uint8_t i = 0; i < SIMON_COUNT; i++) {
+        EY_Outputs_WritePin(SIMON_LED_PINS[i], ledsOn);
+      }
+      if (s_victoryPhasesLeft == 0) {
+        s_victoryActive = false;
+      } else {
+        s_victoryNextAt = now + SIMON_VICTORY_BLINK_MS;
+      }
+    }
+    schedule();
+    return;
+  }
+
+  // ---- LED blinking ----
+  for (uint8_t i = 0; i < SIMON_COUNT; i++) {
+    SimonButton& btn = s_btns[i];
+    if (btn.locked) continue;
+
+    if (!btn.ledOn && (long)(now - btn.nextBlinkAt) >= 0) {
+      btn.ledOn = true;
+      btn.blinkOffAt = now + SIMON_BLINK_DURATION_MS;
+      EY_Outputs_WritePin(SIMON_LED_PINS[i], true);
+    } else if (btn.ledOn && (long)(now - btn.blinkOffAt) >= 0) {
+      btn.ledOn = false;
+      btn.nextBlinkAt = now + random(SIMON_BLINK_MIN_MS, SIMON_BLINK_MAX_MS);
+      EY_Outputs_WritePin(SIMON_LED_PINS[i], false);
+    }
+  }
+  schedule();
+}
+
 // ---- Public API ----
 
 void EY_Simon_Begin() {
@@ -44,21 +128,22 @@ void EY_Simon_Begin() {
       pinMode(SIMON_BTN_PINS[i], INPUT);
     }
 
-    pinMode(SIMON_LED_PINS[i], OUTPUT);
-    digitalWrite(SIMON_LED_PINS[i], LOW);
+    EY_Outputs_BeginPin(SIMON_LED_PINS[i], false);
 
     s_btns[i] = {};
   }
 
+  s_debouncer.begin(SIMON_DEBOUNCE_MS, 0);
   s_active = false;
   s_lockedCount = 0;
+  s_timer = EY_Loop_TimerCreate(&step, nullptr);
 
   // Boot LED test — blink all LEDs 3 times to confirm wiring
   Serial.println("[Simon] LED test...");
   for (int t = 0; t < 3; t++) {
-    for (uint8_t i = 0; i < SIMON_COUNT; i++) digitalWrite(SIMON_LED_PINS[i], HIGH);
+    for (uint8_t i = 0; i < SIMON_COUNT; i++) EY_Outputs_WritePin(SIMON_LED_PINS[i], true);
     delay(300);
-    for (uint8_t i = 0; i < SIMON_COUNT; i++) digitalWrite(SIMON_LED_PINS[i], LOW);
+    for (uint8_t i = 0; i < SIMON_COUNT; i++) EY_Outputs_WritePin(SIMON_LED_PINS[i], false);
     delay(300);
   }
   Serial.println("[Simon] LED test done");
@@ -80,77 +165,40 @@ void EY_Simon_Activate() {
     btn.ledOn = false;
     btn.nextBlinkAt = now + random(SIMON_BLINK_MIN_MS, SIMON_BLINK_MAX_MS);
     btn.blinkOffAt = 0;
-    btn.lastRead = false;
-    btn.lastChangeMs = now;
-    btn.stablePressed = false;
 
-    digitalWrite(SIMON_LED_PINS[i], LOW);
+    EY_Outputs_WritePin(SIMON_LED_PINS[i], false);
   }
+  EY_Simon_Resync();
+  schedule();
 
   Serial.println("[Simon] Game activated");
 }
 
+void EY_Simon_Resync() {
+  // Start from "nothing pressed": a button held through activation still
+  // registers as a press once it has been stable for the debounce window.
+  s_debouncer.reset(0);
+  EY_Inputs_CursorBegin(s_cursor);
+}
+
 bool EY_Simon_Tick() {
   if (!s_active) return false;
+  if (s_victoryActive) return true;
 
   unsigned long now = millis();
-
-  // ---- Victory animation ----
-  // Runs after the last button locks. Drives every LED in lockstep, so we have
-  // to handle it outside the per-button loop (and we skip the loop entirely
-  // while it's playing so a stray late press can't fight the animation).
-  if (s_victoryActive) {
-    if (now >= s_victoryNextAt) {
-      s_victoryPhasesLeft--;
-      bool ledsOn = (s_victoryPhasesLeft % 2 == 0);
-      for (uint8_t i = 0; i < SIMON_COUNT; i++) {
-        digitalWrite(SIMON_LED_PINS[i], ledsOn ? HIGH : LOW);
-      }
-      if (s_victoryPhasesLeft == 0) {
-        s_victoryActive = false;
-      } else {
-        s_victoryNextAt = now + SIMON_VICTORY_BLINK_MS;
-      }
-    }
-    return true;
-  }
+  SimonWord presses = debouncedPresses();
 
   for (uint8_t i = 0; i < SIMON_COUNT; i++) {
     SimonButton& btn = s_btns[i];
 
     if (btn.locked) continue;
 
-    // ---- LED blinking ----
-    if (!btn.ledOn && now >= btn.nextBlinkAt) {
-      btn.ledOn = true;
-      btn.blinkOffAt = now + SIMON_BLINK_DURATION_MS;
-      digitalWrite(SIMON_LED_PINS[i], HIGH);
-    }
-
-    if (btn.ledOn && now >= btn.blinkOffAt) {
-      btn.ledOn = false;
-      btn.nextBlinkAt = now + random(SIMON_BLINK_MIN_MS, SIMON_BLINK_MAX_MS);
-      digitalWrite(SIMON_LED_PINS[i], LOW);
-    }
-
-    // ---- Button debounce ----
-    bool raw = (digitalRead(SIMON_BTN_PINS[i]) == LOW);
-    if (raw != btn.lastRead) {
-      btn.lastRead = raw;
-      btn.lastChangeMs = now;
-    }
-
-    if (now - btn.lastChangeMs < SIMON_DEBOUNCE_MS) continue;
-
-    bool wasPressed = btn.stablePressed;
-    btn.stablePressed = btn.lastRead;
-
-    // ---- Press detection (rising edge) ----
-    if (btn.stablePressed && !wasPressed) {
+    // ---- Press detection (debounced rising edge) ----
+    if (presses & ((SimonWord)1 << i)) {
       if (btn.ledOn) {
         // Correct — lock this button, LED stays on
         btn.locked = true;
-        digitalWrite(SIMON_LED_PINS[i], HIGH);
+        EY_Outputs_WritePin(SIMON_LED_PINS[i], true);
         s_lockedCount++;
 
         Serial.print("[Simon] Button ");
@@ -170,6 +218,7 @@ bool EY_Simon_Tick() {
           s_victoryActive = true;
           s_victoryPhasesLeft = 6;
           s_victoryNextAt = now + SIMON_VICTORY_BLINK_MS;
+          schedule();
           Serial.println("[Simon] Win animation started");
         }
       }
@@ -188,7 +237,7 @@ void EY_Simon_Reset() {
 
   for (uint8_t i = 0; i < SIMON_COUNT; i++) {
     s_btns[i] = {};
-    digitalWrite(SIMON_LED_PINS[i], LOW);
+    EY_Outputs_WritePin(SIMON_LED_PINS[i], false);
   }
 
   Serial.println("[Simon] Reset");
@@ -202,11 +251,12 @@ void EY_Simon_ForceSolve() {
   s_lockedCount = SIMON_COUNT;
   s_victoryActive = false;
   s_victoryPhasesLeft = 0;
+  EY_Loop_Cancel(s_timer);
 
   for (uint8_t i = 0; i < SIMON_COUNT; i++) {
     s_btns[i].locked = true;
     s_btns[i].ledOn = true;
-    digitalWrite(SIMON_LED_PINS[i], HIGH);
+    EY_Outputs_WritePin(SIMON_LED_PINS[i], true);
   }
 
   Serial.println("[Simon] Force solved");
@@ -223,9 +273,6 @@ uint8_t EY_Simon_GetLockedCount() {
 #ifdef SIMON_TEST_MODE
 // ---- Dev wiring test: all LEDs solid on; press a button → its LED blinks 3x → solid ----
 struct SimonTestBtn {
-  bool lastRead;
-  unsigned long lastChangeMs;
-  bool stablePressed;
   bool blinking;
   uint8_t phasesLeft;   // 6 = off,on,off,on,off,on → ends solid on
   bool ledOn;
@@ -235,18 +282,19 @@ static SimonTestBtn s_test[SIMON_COUNT];
 static constexpr unsigned long SIMON_TEST_BLINK_MS = 150;
 
 void EY_Simon_TestBegin() {
-  unsigned long now = millis();
   for (uint8_t i = 0; i < SIMON_COUNT; i++) {
     s_test[i] = {};
     s_test[i].ledOn = true;
-    s_test[i].lastChangeMs = now;
-    digitalWrite(SIMON_LED_PINS[i], HIGH);  // solid on
+    EY_Outputs_WritePin(SIMON_LED_PINS[i], true);  // solid on
   }
+  s_debouncer.begin(SIMON_DEBOUNCE_MS, 0);
+  EY_Inputs_CursorBegin(s_cursor);
   Serial.println("[Simon TEST] All LEDs on. Press a button -> 3 blinks -> back on.");
 }
 
 void EY_Simon_TestTick() {
   unsigned long now = millis();
+  SimonWord presses = debouncedPresses();
 
   for (uint8_t i = 0; i < SIMON_COUNT; i++) {
     SimonTestBtn& b = s_test[i];
@@ -257,31 +305,20 @@ void EY_Simon_TestTick() {
       if (b.phasesLeft == 0) {
         b.blinking = false;
         b.ledOn = true;
-        digitalWrite(SIMON_LED_PINS[i], HIGH);  // back to solid on
+        EY_Outputs_WritePin(SIMON_LED_PINS[i], true);  // back to solid on
       } else {
         b.ledOn = !b.ledOn;
-        digitalWrite(SIMON_LED_PINS[i], b.ledOn ? HIGH : LOW);
+        EY_Outputs_WritePin(SIMON_LED_PINS[i], b.ledOn);
         b.nextToggleAt = now + SIMON_TEST_BLINK_MS;
       }
     }
 
-    // ---- debounced press detection ----
-    bool raw = (digitalRead(SIMON_BTN_PINS[i]) == LOW);
-    if (raw != b.lastRead) {
-      b.lastRead = raw;
-      b.lastChangeMs = now;
-    }
-    if (now - b.lastChangeMs < SIMON_DEBOUNCE_MS) continue;
-
-    bool wasPressed = b.stablePressed;
-    b.stablePressed = b.lastRead;
-
-    // rising edge → start the 3-blink sequence (ignored if already blinking)
-    if (b.stablePressed && !wasPressed && !b.blinking) {
+    // debounced rising edge → start the 3-blink sequence (ignored if already blinking)
+    if ((presses & ((SimonWord)1 << i)) && !b.blinking) {
       b.blinking = true;
       b.phasesLeft = 6;
       b.ledOn = false;
-      digitalWrite(SIMON_LED_PINS[i], LOW);
+      EY_Outputs_WritePin(SIMON_LED_PINS[i], false);
       b.nextToggleAt = now + SIMON_TEST_BLINK_MS;
       Serial.print("[Simon TEST] Button ");
       Serial.print(i + 1);
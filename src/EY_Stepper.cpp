@@ -0,0 +1,535 @@
+#include "EY_Config.h"  // Must be first — brings in PROP_CONFIG which may define HAS_STEPPER
+
+#ifdef HAS_STEPPER
+
+#include "EY_Stepper.h"
+#include "EY_Sensors.h"  // For EY_Sensors_InputPin, EY_Sensors_ActiveLow
+#include "EY_Inputs.h"
+#include "EY_Timer.h"
+#include "EY_Loop.h"
+
+#ifdef HAS_PIXELS
+#include "EY_Pixels.h"  // For PIXELS_RMT_CHANNEL / PIXELS_RMT_MEM_BLOCKS
+#endif
+
+#include <driver/rmt.h>
+#include <esp_timer.h>
+#include <math.h>
+
+#ifndef STEPPER_PULSE_US
+  #define STEPPER_PULSE_US 5
+#endif
+#ifndef STEPPER_HOME_BACKOFF
+  #define STEPPER_HOME_BACKOFF 50
+#endif
+#ifndef STEPPER_HOME_MAX_STEPS
+  #define STEPPER_HOME_MAX_STEPS 100000
+#endif
+#ifndef STEPPER_RMT_CHANNEL
+  #ifdef HAS_PIXELS
+    #define STEPPER_RMT_CHANNEL (PIXELS_RMT_CHANNEL + PIXELS_RMT_MEM_BLOCKS)
+  #else
+    #define STEPPER_RMT_CHANNEL 0
+  #endif
+#endif
+
+static_assert(STEPPER_COUNT >= 1, "HAS_STEPPER needs at least one entry in STEPPERS[]");
+static_assert(STEPPER_RMT_CHANNEL + STEPPER_COUNT <= 8, "One RMT channel per stepper: not enough channels left");
+#ifdef HAS_PIXELS
+static_assert(STEPPER_RMT_CHANNEL >= PIXELS_RMT_CHANNEL + PIXELS_RMT_MEM_BLOCKS ||
+              STEPPER_RMT_CHANNEL + STEPPER_COUNT <= PIXELS_RMT_CHANNEL,
+              "Stepper RMT channels overlap the pixel strip's RMT memory");
+#endif
+
+// RMT clock 80 MHz / 80 = 1 µs per tick; an item half holds at most 32767 ticks
+static constexpr uint8_t  RMT_CLK_DIV = 80;
+static constexpr uint32_t MAX_PERIOD_US = 32767;
+static constexpr uint32_t MIN_PERIOD_US = STEPPER_PULSE_US * 2;
+
+static constexpr uint32_t POLL_US = 5000;          // Run end / home switch checks
+static constexpr uint32_t HOME_BURST_STEPS = 8;    // Steps between home switch checks
+
+enum class StepperPhase : uint8_t { IDLE, MOVE, HOME_SEEK, HOME_BACKOFF };
+
+// Log lines owed by the timer task, printed by EY_Stepper_Tick()
+static constexpr uint8_t NOTE_HOMING         = 0x01;
+static constexpr uint8_t NOTE_HOMED          = 0x02;
+static constexpr uint8_t NOTE_HOME_NOT_FOUND = 0x04;
+static constexpr uint8_t NOTE_SWITCH_HIT     = 0x08;
+
+// One run of step pulses: read and advanced by the RMT interrupt
+// (translator), under s_runMux. Periods are µs in 24.8 fixed point.
+struct StepperRun {
+  uint32_t total;   // Steps in this run
+  uint32_t done;    // Steps handed to the RMT so far
+  uint32_t n;       // Ramp index (steps of acceleration taken)
+  uint32_t c;       // Current period
+  uint32_t c0;      // First period (from the acceleration)
+  uint32_t cMin;    // Cruise period
+};
+
+struct StepperMotor {
+  StepperRun run;
+  StepperPhase phase;
+  bool running;         // RMT transmission in progress
+  int8_t runDir;
+  int32_t runStart;     // Position when the run started
+  int32_t position;     // Valid while not running
+  bool homed;
+  int16_t limitSensor;  // SENSORS[] index of the home switch, -1 = none
+  bool limitHit;        // Switch seen active since the last check
+  uint32_t homeSteps;   // Steps taken while seeking
+  bool driven;          // RMT channel set up
+
+  // Requests from the API, picked up by the timer task
+  bool wantTarget;
+  int32_t target;
+  uint16_t targetSpeed;
+  bool wantHome;
+  bool wantStop;
+
+  uint8_t notes;        // NOTE_* for loop(), under s_reqMux
+};
+
+static StepperMotor s_motors[STEPPER_COUNT];
+static portMUX_TYPE s_runMux = portMUX_INITIALIZER_UNLOCKED;   // StepperRun
+static portMUX_TYPE s_reqMux = portMUX_INITIALIZER_UNLOCKED;   // Requests, notes
+static EY_InputCursor s_cursor;
+static bool s_tracking = false;  // s_cursor drained by the last poll (a motor was busy)
+static int8_t s_timer = -1;
+
+// Source "sample" handed to rmt_write_sample: the translators generate
+// steps from StepperRun, and consume this single byte when a run ends
+static const uint8_t s_runToken = 0;
+
+static rmt_channel_t channelOf(uint8_t index) {
+  return (rmt_channel_t)(STEPPER_RMT_CHANNEL + index);
+}
+
+// ---- RMT translator (interrupt context) ----
+
+// Period of the next step: Austin's ramp, c(n) = c(n-1) - 2c(n-1) / (4n + 1),
+// run backwards once the steps left no longer cover the ramp
+static inline uint32_t IRAM_ATTR nextPeriod(StepperRun& r) {
+  if (r.done == 0) {
+    r.c = r.c0;
+    r.n = 0;
+    return r.c;
+  }
+  uint32_t remaining = r.total - r.done;
+  if (remaining <= r.n && r.n > 0) {
+    r.c += 2 * r.c / (4 * r.n - 1);
+    r.n--;
+    if (r.c > r.c0) r.c = r.c0;
+  } else if (r.c > r.cMin) {
+    r.n++;
+    r.c -= 2 * r.c / (4 * r.n + 1);
+    if (r.c < r.cMin) r.c = r.cMin;
+  }
+  return r.c;
+}
+
+static void IRAM_ATTR fillSteps(uint8_t index, rmt_item32_t* dest, size_t wanted,
+                                size_t* translated, size_t* itemCount) {
+  StepperRun& r = s_motors[index].run;
+  size_t n = 0;
+  portENTER_CRITICAL_SAFE(&s_runMux);
+  while (n < wanted && r.done < r.total) {
+    uint32_t periodUs = nextPeriod(r) >> 8;
+    dest[n].duration0 = STEPPER_PULSE_US;
+    dest[n].level0 = 1;
+    dest[n].duration1 = periodUs - STEPPER_PULSE_US;
+    dest[n].level1 = 0;
+    r.done++;
+    n++;
+  }
+  bool finished = r.done >= r.total;
+  portEXIT_CRITICAL_SAFE(&s_runMux);
+  *itemCount = n;
+  *translated = finished ? 1 : 0;
+}
+
+template <uint8_t I>
+static void IRAM_ATTR translate(const void*, rmt_item32_t* dest, size_t, size_t wanted,
+                                size_t* translated, size_t* itemCount) {
+  fillSteps(I, dest, wanted, translated, itemCount);
+}
+
+static const sample_to_rmt_t TRANSLATORS[8] = {
+  translate<0>, translate<1>, translate<2>, translate<3>,
+  translate<4>, translate<5>, translate<6>, translate<7>,
+};
+
+// ---- Runs (timer task) ----
+
+static uint32_t periodFor(uint32_t speed) {
+  uint32_t us = speed ? 1000000UL / speed : MAX_PERIOD_US;
+  if (us > MAX_PERIOD_US) us = MAX_PERIOD_US;
+  if (us < MIN_PERIOD_US) us = MIN_PERIOD_US;
+  return us << 8;
+}
+
+static void startRun(uint8_t index, int8_t dir, uint32_t steps, uint16_t speed, bool ramp) {
+  const StepperDef& def = STEPPERS[index];
+  StepperMotor& m = s_motors[index];
+
+  uint32_t cMin = periodFor(speed);
+  uint32_t c0 = cMin;
+  if (ramp && def.accel) {
+    // First step of a ramp from standstill: 0.676 * sqrt(2 / accel) s
+    float us = 0.676f * sqrtf(2.0f / def.accel) * 1e6f;
+    c0 = (us >= MAX_PERIOD_US) ? (MAX_PERIOD_US << 8) : (uint32_t)(us * 256.0f);
+    if (c0 < cMin) c0 = cMin;
+  }
+
+  digitalWrite(def.dirPin, dir > 0 ? HIGH : LOW);
+  m.runDir = dir;
+  m.runStart = m.position;
+  m.running = true;
+  portENTER_CRITICAL(&s_runMux);
+  m.run = { steps, 0, 0, c0, c0, cMin };
+  portEXIT_CRITICAL(&s_runMux);
+  rmt_write_sample(channelOf(index), &s_runToken, 1, false);
+}
+
+// Cut the current run short: `decelerate` down the ramp, or at once.
+// Returns true if steps were dropped.
+static bool truncateRun(uint8_t index, bool decelerate) {
+  StepperRun& r = s_motors[index].run;
+  portENTER_CRITICAL(&s_runMux);
+  uint32_t end = decelerate ? r.done + r.n : r.done;
+  bool cut = end < r.total;
+  if (cut) r.total = end;
+  portEXIT_CRITICAL(&s_runMux);
+  return cut;
+}
+
+// Queue a log line for loop(): the timer task must not print
+static void note(uint8_t index, uint8_t what) {
+  portENTER_CRITICAL(&s_reqMux);
+  s_motors[index].notes |= what;
+  portEXIT_CRITICAL(&s_reqMux);
+  EY_Loop_Wake();
+}
+
+static int32_t runPosition(const StepperMotor& m) {
+  portENTER_CRITICAL(&s_runMux);
+  uint32_t done = m.run.done;
+  portEXIT_CRITICAL(&s_runMux);
+  return m.runStart + m.runDir * (int32_t)done;
+}
+
+static void startHoming(uint8_t index) {
+  StepperMotor& m = s_motors[index];
+  m.phase = StepperPhase::HOME_SEEK;
+  m.homed = false;
+  m.homeSteps = 0;
+  m.limitHit = false;
+  note(index, NOTE_HOMING);
+}
+
+static void startMove(uint8_t index, int32_t target, uint16_t speed) {
+  StepperMotor& m = s_motors[index];
+  int32_t delta = target - m.position;
+  if (delta == 0) return;
+  m.phase = StepperPhase::MOVE;
+  startRun(index, delta > 0 ? 1 : -1, (uint32_t)(delta > 0 ? delta : -delta),
+           speed ? speed : STEPPERS[index].maxSpeed, true);
+}
+
+// A run finished (all steps out): next phase, or the pending request
+static void runEnded(uint8_t index, bool limitHit) {
+  const StepperDef& def = STEPPERS[index];
+  StepperMotor& m = s_motors[index];
+
+  switch (m.phase) {
+    case StepperPhase::HOME_SEEK:
+      if (limitHit) {
+        // Back off so the switch releases; position 0 is there
+        m.phase = StepperPhase::HOME_BACKOFF;
+        startRun(index, -def.homeDir, STEPPER_HOME_BACKOFF, def.homeSpeed, false);
+        return;
+      }
+      if (m.homeSteps >= STEPPER_HOME_MAX_STEPS) {
+        m.phase = StepperPhase::IDLE;
+        portENTER_CRITICAL(&s_reqMux);
+        m.wantTarget = false;  // Would only home again
+        portEXIT_CRITICAL(&s_reqMux);
+        note(index, NOTE_HOME_NOT_FOUND);
+        return;
+      }
+      m.homeSteps += HOME_BURST_STEPS;
+      startRun(index, def.homeDir, HOME_BURST_STEPS, def.homeSpeed, false);
+      return;
+
+    case StepperPhase::HOME_BACKOFF:
+      m.position = 0;
+      m.homed = true;
+      note(index, NOTE_HOMED);
+      break;
+
+    default:
+      break;
+  }
+  m.phase = StepperPhase::IDLE;
+}
+
+// Timer callback: track running motors, watch the home switches, and
+// start whatever was requested once a motor is free
+static void poll(void*) {
+  // Home switches, from every input frame since the last check. While all
+  // motors were idle nobody drained the cursor: start again from the
+  // current frame instead of replaying stale switch presses.
+  if (!s_tracking) EY_Inputs_CursorBegin(s_cursor);
+  EY_InputSample sample;
+  while (EY_Inputs_Next(s_cursor, sample)) {
+    for (uint8_t i = 0; i < STEPPER_COUNT; i++) {
+      int16_t s = s_motors[i].limitSensor;
+      if (s < 0 || !s_motors[i].running) continue;
+      if (EY_Inputs_PinHigh(sample.frame, EY_Sensors_InputPin(SENSORS[s])) != EY_Sensors_ActiveLow(SENSORS[s])) {
+        s_motors[i].limitHit = true;
+      }
+    }
+  }
+
+  bool busy = false;
+  for (uint8_t i = 0; i < STEPPER_COUNT; i++) {
+    const StepperDef& def = STEPPERS[i];
+    StepperMotor& m = s_motors[i];
+    int16_t s = m.limitSensor;
+    bool limitActive = s >= 0 &&
+      (EY_Inputs_PinHigh(s_cursor.frame, EY_Sensors_InputPin(SENSORS[s])) != EY_Sensors_ActiveLow(SENSORS[s]));
+    m.limitHit |= limitActive;  // Held until the run ends: a burst spans several polls
+    bool limitHit = m.limitHit;
+
+    portENTER_CRITICAL(&s_reqMux);
+    bool wantStop = m.wantStop;
+    bool wantHome = m.wantHome;
+    bool wantTarget = m.wantTarget;
+    int32_t target = m.target;
+    uint16_t targetSpeed = m.targetSpeed;
+    m.wantStop = false;
+    portEXIT_CRITICAL(&s_reqMux);
+
+    if (m.running) {
+      if (wantStop || wantHome || (wantTarget && m.phase == StepperPhase::MOVE)) {
+        // New orders: come to a stop first
+        bool homing = m.phase == StepperPhase::HOME_SEEK || m.phase == StepperPhase::HOME_BACKOFF;
+        truncateRun(i, !homing);
+        if (homing && (wantStop || wantHome)) m.phase = StepperPhase::IDLE;
+      }
+      if (m.phase == StepperPhase::MOVE && limitHit && m.runDir == def.homeDir && truncateRun(i, false)) {
+        // Ran into the home switch outside homing
+        m.homed = false;
+        note(i, NOTE_SWITCH_HIT);
+      }
+
+      portENTER_CRITICAL(&s_runMux);
+      bool allOut = m.run.done >= m.run.total;
+      portEXIT_CRITICAL(&s_runMux);
+      if (allOut && rmt_wait_tx_done(channelOf(i), 0) == ESP_OK) {
+        m.position = runPosition(m);
+        m.running = false;
+        m.limitHit = false;
+        runEnded(i, limitHit);
+      }
+    }
+    if (!m.running) m.limitHit = false;
+
+    if (!m.running && m.phase == StepperPhase::IDLE) {
+      if (wantStop) {
+        portENTER_CRITICAL(&s_reqMux);
+        m.wantTarget = false;
+        m.wantHome = false;
+        portEXIT_CRITICAL(&s_reqMux);
+      } else if (wantHome || (wantTarget && !m.homed && m.limitSensor >= 0)) {
+        portENTER_CRITICAL(&s_reqMux);
+        m.wantHome = false;
+        portEXIT_CRITICAL(&s_reqMux);
+        startHoming(i);
+        runEnded(i, limitActive);  // First burst (or straight to backoff): current frame only
+      } else if (wantTarget) {
+        portENTER_CRITICAL(&s_reqMux);
+        m.wantTarget = false;
+        portEXIT_CRITICAL(&s_reqMux);
+        startMove(i, target, targetSpeed);
+      }
+    }
+
+    busy |= m.running || m.phase != StepperPhase::IDLE;
+  }
+
+  s_tracking = busy;
+  if (busy) EY_Timer_At(s_timer, (uint64_t)esp_timer_get_time() + POLL_US);
+}
+
+// ---- Public API ----
+
+void EY_Stepper_Begin() {
+  for (uint8_t i = 0; i < STEPPER_COUNT; i++) {
+    const StepperDef& def = STEPPERS[i];
+    StepperMotor& m = s_motors[i];
+    m = {};
+    m.limitSensor = -1;
+
+    if (def.limitSensorId) {
+      for (uint8_t s = 0; s < SENSOR_COUNT; s++) {
+        if (strcmp(SENSORS[s].id, def.limitSensorId) == 0) m.limitSensor = s;
+      }
+      if (m.limitSensor < 0) {
+        Serial.print("[Stepper] ERROR: ");
+        Serial.print(def.id);
+        Serial.print(" home switch sensor not found: ");
+        Serial.println(def.limitSensorId);
+      }
+    }
+
+    pinMode(def.dirPin, OUTPUT);
+    if (def.enablePin != EY_NO_PIN) {
+      pinMode(def.enablePin, OUTPUT);
+      digitalWrite(def.enablePin, LOW);  // Driver on: holds position
+    }
+
+    rmt_config_t config = RMT_DEFAULT_CONFIG_TX((gpio_num_t)def.stepPin, channelOf(i));
+    config.clk_div = RMT_CLK_DIV;
+    config.mem_block_num = 1;
+    if (rmt_config(&config) != ESP_OK || rmt_driver_install(channelOf(i), 0, 0) != ESP_OK ||
+        rmt_translator_init(channelOf(i), TRANSLATORS[i]) != ESP_OK) {
+      Serial.print("[Stepper] ERROR: RMT init failed — ");
+      Serial.print(def.id);
+      Serial.println(" not driven");
+      continue;
+    }
+    m.driven = true;
+  }
+  s_timer = EY_Timer_Create(&poll, nullptr);
+
+  Serial.print("[Stepper] ");
+  Serial.print(STEPPER_COUNT);
+  Serial.println(" motors ready (position unknown until homed)");
+
+#ifdef STEPPER_HOME_ON_BOOT
+  for (uint8_t i = 0; i < STEPPER_COUNT; i++) {
+    if (s_motors[i].limitSensor >= 0) EY_Stepper_Home(i);
+  }
+#endif
+}
+
+void EY_Stepper_Tick() {
+  for (uint8_t i = 0; i < STEPPER_COUNT; i++) {
+    portENTER_CRITICAL(&s_reqMux);
+    uint8_t notes = s_motors[i].notes;
+    s_motors[i].notes = 0;
+    portEXIT_CRITICAL(&s_reqMux);
+    if (!notes) continue;
+
+    const char* id = STEPPERS[i].id;
+    if (notes & NOTE_HOMING) {
+      Serial.print("[Stepper] ");
+      Serial.print(id);
+      Serial.println(" homing");
+    }
+    if (notes & NOTE_HOMED) {
+      Serial.print("[Stepper] ");
+      Serial.print(id);
+      Serial.println(" homed");
+    }
+    if (notes & NOTE_HOME_NOT_FOUND) {
+      Serial.print("[Stepper] ERROR: ");
+      Serial.print(id);
+      Serial.println(" home switch not found — motor stays unhomed");
+    }
+    if (notes & NOTE_SWITCH_HIT) {
+      Serial.print("[Stepper] ERROR: ");
+      Serial.print(id);
+      Serial.println(" hit its home switch — stopped, position lost");
+    }
+  }
+}
+
+bool EY_Stepper_StopAll(uint32_t timeoutMs) {
+  for (uint8_t i = 0; i < STEPPER_COUNT; i++) EY_Stepper_Stop(i);
+  unsigned long start = millis();
+  for (;;) {
+    bool moving = false;
+    for (uint8_t i = 0; i < STEPPER_COUNT; i++) moving |= s_motors[i].running;
+    if (!moving) return true;
+    if (millis() - start >= timeoutMs) return false;
+    delay(5);
+  }
+}
+
+void EY_Stepper_MoveTo(uint8_t index, int32_t position, uint16_t speed) {
+  if (index >= STEPPER_COUNT || !s_motors[index].driven) return;
+  StepperMotor& m = s_motors[index];
+  portENTER_CRITICAL(&s_reqMux);
+  m.wantTarget = true;
+  m.target = position;
+  m.targetSpeed = speed;
+  portEXIT_CRITICAL(&s_reqMux);
+  Serial.print("[Stepper] ");
+  Serial.print(STEPPERS[index].id);
+  Serial.print(" -> ");
+  Serial.println(position);
+  EY_Timer_At(s_timer, 1);
+}
+
+void EY_Stepper_Home(uint8_t index) {
+  if (index >= STEPPER_COUNT || !s_motors[index].driven || s_motors[index].limitSensor < 0) return;
+  portENTER_CRITICAL(&s_reqMux);
+  s_motors[index].wantHome = true;
+  portEXIT_CRITICAL(&s_reqMux);
+  EY_Timer_At(s_timer, 1);
+}
+
+void EY_Stepper_Stop(uint8_t index) {
+  if (index >= STEPPER_COUNT) return;
+  portENTER_CRITICAL(&s_reqMux);
+  s_motors[index].wantStop = true;
+  s_motors[index].wantTarget = false;
+  s_motors[index].wantHome = false;
+  portEXIT_CRITICAL(&s_reqMux);
+  EY_Timer_At(s_timer, 1);
+}
+
+void EY_Stepper_Open(uint8_t group) {
+  for (uint8_t i = 0; i < STEPPER_COUNT; i++) {
+    if (group == EY_ALL_GROUPS || STEPPERS[i].group == group) {
+      EY_Stepper_MoveTo(i, STEPPERS[i].openPosition, 0);
+    }
+  }
+}
+
+void EY_Stepper_Close(uint8_t group) {
+  for (uint8_t i = 0; i < STEPPER_COUNT; i++) {
+    if (group == EY_ALL_GROUPS || STEPPERS[i].group == group) {
+      EY_Stepper_MoveTo(i, 0, 0);
+    }
+  }
+}
+
+int8_t EY_Stepper_Find(uint8_t group, const char* id) {
+  if (!id) return -1;
+  for (uint8_t i = 0; i < STEPPER_COUNT; i++) {
+    if ((group == EY_ALL_GROUPS || STEPPERS[i].group == group) && strcmp(STEPPERS[i].id, id) == 0) {
+      return (int8_t)i;
+    }
+  }
+  return -1;
+}
+
+int32_t EY_Stepper_GetPosition(uint8_t index) {
+  if (index >= STEPPER_COUNT) return 0;
+  const StepperMotor& m = s_motors[index];
+  return m.running ? runPosition(m) : m.position;
+}
+
+bool EY_Stepper_IsMoving(uint8_t index) {
+  return index < STEPPER_COUNT && s_motors[index].running;
+}
+
+bool EY_Stepper_IsHomed(uint8_t index) {
+  return index < STEPPER_COUNT && s_motors[index].homed;
+}
+
+#endif // HAS_STEPPER
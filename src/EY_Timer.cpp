@@ -0,0 +1,97 @@
+#include "EY_Timer.h"
+
+#include <esp_timer.h>
+
+struct TimerSlot {
+  EY_TimerCallback callback;
+  void* arg;
+  uint64_t atUs;  // 0 = no pending deadline
+};
+
+static TimerSlot s_slots[EY_TIMER_SLOTS];
+static uint8_t s_slotCount = 0;
+static portMUX_TYPE s_slotMux = portMUX_INITIALIZER_UNLOCKED;
+
+static esp_timer_handle_t s_timer = nullptr;
+
+// Bumped every time the earliest deadline is recomputed. A re-arm that
+// raced with another one starts over, so the last esp_timer start always
+// matches the slot table.
+static uint32_t s_generation = 0;
+
+static void rearm() {
+  for (;;) {
+    uint64_t earliest = 0;
+    portENTER_CRITICAL(&s_slotMux);
+    for (uint8_t i = 0; i < s_slotCount; i++) {
+      if (s_slots[i].atUs && (earliest == 0 || s_slots[i].atUs < earliest)) earliest = s_slots[i].atUs;
+    }
+    uint32_t generation = ++s_generation;
+    portEXIT_CRITICAL(&s_slotMux);
+
+    esp_timer_stop(s_timer);  // ESP_ERR_INVALID_STATE when not running: fine
+    if (earliest) {
+      uint64_t nowUs = (uint64_t)esp_timer_get_time();
+      esp_timer_start_once(s_timer, (earliest > nowUs) ? earliest - nowUs : 0);
+    }
+
+    portENTER_CRITICAL(&s_slotMux);
+    bool current = (generation == s_generation);
+    portEXIT_CRITICAL(&s_slotMux);
+    if (current) return;
+  }
+}
+
+// Timer callback: run every slot that is due, then wait for the next one
+static void timerFired(void*) {
+  uint64_t nowUs = (uint64_t)esp_timer_get_time();
+  for (uint8_t i = 0; i < s_slotCount; i++) {
+    portENTER_CRITICAL(&s_slotMux);
+    bool due = s_slots[i].atUs && s_slots[i].atUs <= nowUs;
+    if (due) s_slots[i].atUs = 0;
+    portEXIT_CRITICAL(&s_slotMux);
+    if (due) s_slots[i].callback(s_slots[i].arg);
+  }
+  rearm();
+}
+
+int8_t EY_Timer_Create(EY_TimerCallback callback, void* arg) {
+  if (!callback || s_slotCount >= EY_TIMER_SLOTS) return -1;
+
+  if (!s_timer) {
+    esp_timer_create_args_t args = {};
+    args.callback = &timerFired;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "ey_timer";
+    if (esp_timer_create(&args, &s_timer) != ESP_OK) {
+      Serial.println("[Timer] ERROR: esp_timer creation failed");
+      s_timer = nullptr;
+      return -1;
+    }
+  }
+
+  portENTER_CRITICAL(&s_slotMux);
+  int8_t id = (int8_t)s_slotCount;
+  s_slots[id] = { callback, arg, 0 };
+  s_slotCount++;
+  portEXIT_CRITICAL(&s_slotMux);
+  return id;
+}
+
+void EY_Timer_At(int8_t timer, uint64_t atUs) {
+  if (timer < 0 || timer >= (int8_t)s_slotCount) return;
+  if (atUs == 0) atUs = 1;
+  portENTER_CRITICAL(&s_slotMux);
+  uint64_t& pending = s_slots[timer].atUs;
+  if (pending == 0 || atUs < pending) pending = atUs;
+  portEXIT_CRITICAL(&s_slotMux);
+  rearm();
+}
+
+void EY_Timer_Cancel(int8_t timer) {
+  if (timer < 0 || timer >= (int8_t)s_slotCount) return;
+  portENTER_CRITICAL(&s_slotMux);
+  s_slots[timer].atUs = 0;
+  portEXIT_CRITICAL(&s_slotMux);
+  rearm();
+}
@@ -0,0 +1,189 @@
+#include "EY_Config.h"  // Must be first — brings in PROP_CONFIG which may define HAS_TOUCH
+
+#ifdef HAS_TOUCH
+
+#include "EY_Touch.h"
+#include "EY_Inputs.h"
+
+#include <driver/touch_pad.h>
+
+static constexpr uint8_t TOUCH_THRESHOLD_PCT   = 70;   // Touch below 70% of baseline
+static constexpr uint8_t TOUCH_HYSTERESIS_PCT  = 10;   // Release above 80% of baseline
+static constexpr uint32_t TOUCH_FILTER_MS      = 10;   // IIR filter period
+static constexpr uint8_t TOUCH_CALIBRATE_READS = 16;   // Filtered reads averaged for the baseline
+static constexpr unsigned long TOUCH_DRIFT_MS  = 500;  // Baseline tracking period
+static constexpr uint8_t TOUCH_DRIFT_SHIFT     = 4;    // Baseline moves 1/16 of the gap per period
+
+static const uint8_t TOUCH_PADS = 10;
+
+// Touch pad number of a GPIO, -1 if the pin has none
+static constexpr int8_t touchPad(uint8_t gpio) {
+  switch (gpio) {
+    case 4:  return 0;
+    case 0:  return 1;
+    case 2:  return 2;
+    case 15: return 3;
+    case 13: return 4;
+    case 12: return 5;
+    case 14: return 6;
+    case 27: return 7;
+    case 33: return 8;
+    case 32: return 9;
+    default: return -1;
+  }
+}
+
+// Per-pad settings, from the first touch sensor on each pin
+struct TouchConfig {
+  uint16_t padMask;
+  uint8_t gpio[TOUCH_PADS];
+  uint8_t touchPct[TOUCH_PADS];
+  uint8_t releasePct[TOUCH_PADS];
+};
+
+static constexpr TouchConfig buildTouchConfig() {
+  TouchConfig c = {};
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    if (SENSORS[i].presentWhen != PresentWhen::TOUCH) continue;
+    int8_t pad = touchPad((uint8_t)SENSORS[i].pin);
+    if (pad < 0 || (c.padMask & (1 << pad))) continue;
+    uint8_t pct = SENSORS[i].threshold ? (uint8_t)SENSORS[i].threshold : TOUCH_THRESHOLD_PCT;
+    uint8_t hyst = SENSORS[i].hysteresis ? (uint8_t)SENSORS[i].hysteresis : TOUCH_HYSTERESIS_PCT;
+    c.padMask |= (uint16_t)(1 << pad);
+    c.gpio[pad] = (uint8_t)SENSORS[i].pin;
+    c.touchPct[pad] = pct;
+    c.releasePct[pad] = (pct + hyst < 100) ? (uint8_t)(pct + hyst) : 99;
+  }
+  return c;
+}
+static constexpr TouchConfig TOUCH = buildTouchConfig();
+
+static constexpr bool validTouchSensors() {
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    if (SENSORS[i].presentWhen != PresentWhen::TOUCH) continue;
+    if (touchPad((uint8_t)SENSORS[i].pin) < 0) return false;
+    if (SENSORS[i].threshold >= 100 || SENSORS[i].hysteresis >= 100) return false;
+  }
+  return true;
+}
+static_assert(validTouchSensors(), "Touch sensors need a touch GPIO (4,0,2,15,13,12,14,27,33,32) and threshold/hysteresis in % (< 100)");
+static_assert(TOUCH.padMask != 0, "HAS_TOUCH set but no PresentWhen::TOUCH sensor in SENSORS[]");
+
+// ---- ISR state ----
+static volatile uint32_t s_isrPads = 0;  // Pads that crossed their threshold since the last poll
+
+// ---- Sampler state ----
+static uint16_t s_baseline[TOUCH_PADS];
+static uint16_t s_value[TOUCH_PADS];
+static uint16_t s_touchedPads = 0;
+static uint64_t s_touched = 0;           // Published word: bit = GPIO touched
+static unsigned long s_lastDriftMs = 0;
+
+static uint16_t scaled(uint16_t baseline, uint8_t pct) {
+  return (uint16_t)((uint32_t)baseline * pct / 100);
+}
+
+static void IRAM_ATTR isrTouch(void*) {
+  uint32_t status = touch_pad_get_status();
+  touch_pad_clear_status();
+  s_isrPads |= status;
+}
+
+// Follow slow drift on untouched pads (never while touched, or a held
+// finger would become the new baseline)
+static void trackDrift() {
+  for (uint8_t pad = 0; pad < TOUCH_PADS; pad++) {
+    if (!(TOUCH.padMask & (1 << pad)) || (s_touchedPads & (1 << pad))) continue;
+    uint16_t v = s_value[pad];
+    if (v < scaled(s_baseline[pad], TOUCH.releasePct[pad])) continue;  // Approaching finger
+    int32_t gap = (int32_t)v - (int32_t)s_baseline[pad];
+    s_baseline[pad] = (uint16_t)(s_baseline[pad] + gap / (1 << TOUCH_DRIFT_SHIFT));
+    touch_pad_set_thresh((touch_pad_t)pad, scaled(s_baseline[pad], TOUCH.touchPct[pad]));
+  }
+}
+
+// Sampler hook: collect touches from the ISR, check touched pads for release
+static void poll(uint64_t) {
+  uint32_t fired = __atomic_exchange_n(&s_isrPads, 0, __ATOMIC_RELAXED);
+  s_touchedPads |= (uint16_t)(fired & TOUCH.padMask);
+
+  unsigned long now = millis();
+  bool drift = (now - s_lastDriftMs >= TOUCH_DRIFT_MS);
+  if (s_touchedPads == 0 && !drift) return;
+
+  for (uint8_t pad = 0; pad < TOUCH_PADS; pad++) {
+    uint16_t padBit = (uint16_t)(1 << pad);
+    if (!(TOUCH.padMask & padBit)) continue;
+    if (!(s_touchedPads & padBit) && !drift) continue;
+    touch_pad_read_filtered((touch_pad_t)pad, &s_value[pad]);
+    if ((s_touchedPads & padBit) && s_value[pad] > scaled(s_baseline[pad], TOUCH.releasePct[pad])) {
+      s_touchedPads &= (uint16_t)~padBit;
+    }
+  }
+  if (drift) {
+    s_lastDriftMs = now;
+    trackDrift();
+  }
+
+  uint64_t touched = 0;
+  for (uint8_t pad = 0; pad < TOUCH_PADS; pad++) {
+    if (s_touchedPads & (1 << pad)) touched |= EY_PinBit(TOUCH.gpio[pad]);
+  }
+  if (touched != s_touched) {
+    s_touched = touched;
+    EY_Inputs_PublishBank(EY_BANK_TOUCH, touched);
+  }
+}
+
+void EY_Touch_Begin() {
+  touch_pad_init();
+  touch_pad_set_voltage(TOUCH_HVOLT_2V7, TOUCH_LVOLT_0V5, TOUCH_HVOLT_ATTEN_1V);
+  for (uint8_t pad = 0; pad < TOUCH_PADS; pad++) {
+    if (TOUCH.padMask & (1 << pad)) touch_pad_config((touch_pad_t)pad, 0);
+  }
+  touch_pad_filter_start(TOUCH_FILTER_MS);
+  delay(TOUCH_FILTER_MS * 4);  // Let the IIR filter settle
+
+  // Baseline = average of a few filtered reads, taken untouched
+  uint32_t sums[TOUCH_PADS] = {};
+  for (uint8_t n = 0; n < TOUCH_CALIBRATE_READS; n++) {
+    for (uint8_t pad = 0; pad < TOUCH_PADS; pad++) {
+      if (!(TOUCH.padMask & (1 << pad))) continue;
+      uint16_t v = 0;
+      touch_pad_read_filtered((touch_pad_t)pad, &v);
+      sums[pad] += v;
+    }
+    delay(TOUCH_FILTER_MS);
+  }
+  for (uint8_t pad = 0; pad < TOUCH_PADS; pad++) {
+    if (!(TOUCH.padMask & (1 << pad))) continue;
+    s_baseline[pad] = (uint16_t)(sums[pad] / TOUCH_CALIBRATE_READS);
+    s_value[pad] = s_baseline[pad];
+    touch_pad_set_thresh((touch_pad_t)pad, scaled(s_baseline[pad], TOUCH.touchPct[pad]));
+
+    Serial.print("[Touch] GPIO ");
+    Serial.print(TOUCH.gpio[pad]);
+    Serial.print(" baseline ");
+    Serial.println(s_baseline[pad]);
+  }
+
+  touch_pad_set_trigger_mode(TOUCH_TRIGGER_BELOW);
+  touch_pad_clear_status();
+  touch_pad_isr_register(isrTouch, nullptr);
+  touch_pad_intr_enable();
+
+  s_lastDriftMs = millis();
+  EY_Inputs_AddPoller(&poll);
+}
+
+uint16_t EY_Touch_GetValue(uint8_t gpio) {
+  int8_t pad = touchPad(gpio);
+  return (pad >= 0) ? s_value[pad] : 0;
+}
+
+uint16_t EY_Touch_GetBaseline(uint8_t gpio) {
+  int8_t pad = touchPad(gpio);
+  return (pad >= 0) ? s_baseline[pad] : 0;
+}
+
+#endif // HAS_TOUCH
@@ -4,6 +4,8 @@
 
 #include "EY_Vehicles.h"
 #include "EY_Mqtt.h"
+#include "EY_Inputs.h"
+#include "EY_Debounce.h"
 #include <Arduino.h>
 
 static const char* POS_NAME[3] = { "LEFT", "CENTRE", "RIGHT" };
@@ -11,18 +13,52 @@ static const char* POS_NAME[3] = { "LEFT", "CENTRE", "RIGHT" };
 // ---- Per-switch state ----
 struct VehicleSwitch {
   uint8_t position;        // last debounced position (VEH_LEFT/CENTRE/RIGHT, or 0xFF = invalid)
-  uint8_t rawPosition;     // last raw reading
-  unsigned long lastChangeMs;
 };
 
 static VehicleSwitch s_sw[VEHICLE_COUNT];
 static bool s_active = false;
 static uint8_t s_correctCount = 0;
 
-// Read the live position of switch i from its two GPIOs.
-static uint8_t readPosition(uint8_t i) {
-  bool leftLow  = (digitalRead(VEHICLE_PINS[i][0]) == LOW);
-  bool rightLow = (digitalRead(VEHICLE_PINS[i][1]) == LOW);
+// ---- Compile-time pin masks (bit n = GPIO n), built from VEHICLE_PINS ----
+static constexpr uint64_t buildVehiclePinMask() {
+  uint64_t mask = 0;
+  for (uint8_t i = 0; i < VEHICLE_COUNT; i++) {
+    mask |= EY_PinBit(VEHICLE_PINS[i][0]) | EY_PinBit(VEHICLE_PINS[i][1]);
+  }
+  return mask;
+}
+static constexpr uint64_t VEHICLE_PIN_MASK = buildVehiclePinMask();
+
+// Pins pulled LOW (closed to COM) in a snapshot — both sides of every switch
+// in one mask operation.
+static uint64_t lowPins(uint64_t snapshot) {
+  return ~snapshot & VEHICLE_PIN_MASK;
+}
+
+// Every switch contact debounced together:
+//   bit 2i   = switch i LEFT contact closed
+//   bit 2i+1 = switch i RIGHT contact closed
+typedef EY_DebounceWord<VEHICLE_COUNT * 2> VehicleWord;
+static EY_Debouncer<VehicleWord> s_debouncer;
+
+// Read position in the input sampler's ring
+static EY_InputCursor s_cursor;
+
+// Raw contact bits of every switch from one snapshot
+static VehicleWord contactBits(uint64_t snapshot) {
+  uint64_t low = lowPins(snapshot);
+  VehicleWord bits = 0;
+  for (uint8_t i = 0; i < VEHICLE_COUNT; i++) {
+    if (low & EY_PinBit(VEHICLE_PINS[i][0])) bits |= (VehicleWord)1 << (2 * i);
+    if (low & EY_PinBit(VEHICLE_PINS[i][1])) bits |= (VehicleWord)1 << (2 * i + 1);
+  }
+  return bits;
+}
+
+// Position of switch i from a contactBits() word (raw or debounced).
+static uint8_t readPosition(VehicleWord contacts, uint8_t i) {
+  bool leftLow  = (contacts >> (2 * i)) & 1;
+  bool rightLow = (contacts >> (2 * i + 1)) & 1;
 
   if (leftLow && !rightLow)  return VEH_LEFT;
   if (!leftLow && rightLow)  return VEH_RIGHT;
@@ -43,10 +79,13 @@ void EY_Vehicles_Begin() {
   for (uint8_t i = 0; i < VEHICLE_COUNT; i++) {
     pinMode(VEHICLE_PINS[i][0], INPUT_PULLUP);
     pinMode(VEHICLE_PINS[i][1], INPUT_PULLUP);
+  }
+  EY_Inputs_CursorBegin(s_cursor);
+  VehicleWord contacts = contactBits(s_cursor.frame.bank[EY_BANK_GPIO]);
+  s_debouncer.begin(VEHICLE_DEBOUNCE_MS, contacts);
+  for (uint8_t i = 0; i < VEHICLE_COUNT; i++) {
     s_sw[i] = {};
-    s_sw[i].position    = readPosition(i);
-    s_sw[i].rawPosition = s_sw[i].position;
-    s_sw[i].lastChangeMs = millis();
+    s_sw[i].position = readPosition(contacts, i);
   }
   recomputeCorrect();
   s_active = false;
@@ -62,11 +101,11 @@ void EY_Vehicles_Begin() {
 
 void EY_Vehicles_Activate() {
   s_active = true;
-  unsigned long now = millis();
+  EY_Inputs_CursorBegin(s_cursor);
+  VehicleWord contacts = contactBits(s_cursor.frame.bank[EY_BANK_GPIO]);
+  s_debouncer.reset(contacts);
   for (uint8_t i = 0; i < VEHICLE_COUNT; i++) {
-    s_sw[i].position    = readPosition(i);
-    s_sw[i].rawPosition = s_sw[i].position;
-    s_sw[i].lastChangeMs = now;
+    s_sw[i].position = readPosition(contacts, i);
   }
   recomputeCorrect();
   Serial.println("[Vehicles] Activated");
@@ -75,27 +114,26 @@ void EY_Vehicles_Activate() {
 bool EY_Vehicles_Tick() {
   if (!s_active) return false;
 
-  unsigned long now = millis();
+  // Debounce every contact at once, replaying sampled input changes in order;
+  // a position is only accepted once both of its contacts have been stable
+  // for VEHICLE_DEBOUNCE_MS.
+  VehicleWord flipped = 0;
+  EY_Inputs_Replay(s_cursor, [&flipped](const EY_InputFrame& frame, uint64_t timeUs) {
+    flipped |= s_debouncer.sampleUntil(EY_Inputs_Millis(timeUs), contactBits(frame.bank[EY_BANK_GPIO]));
+  });
+  if (!flipped) return (s_correctCount >= VEHICLE_COUNT);
 
   for (uint8_t i = 0; i < VEHICLE_COUNT; i++) {
     VehicleSwitch& sw = s_sw[i];
 
-    uint8_t raw = readPosition(i);
-
-    // Debounce: only accept a position after it's been stable for DEBOUNCE_MS
-    if (raw != sw.rawPosition) {
-      sw.rawPosition = raw;
-      sw.lastChangeMs = now;
-    }
-    if (now - sw.lastChangeMs < VEHICLE_DEBOUNCE_MS) continue;
-
-    if (raw != sw.position) {
-      sw.position = raw;
+    uint8_t pos = readPosition(s_debouncer.state, i);
+    if (pos != sw.position) {
+      sw.position = pos;
       Serial.print("[Vehicles] Switch ");
       Serial.print(i + 1);
       Serial.print(" -> ");
-      Serial.print(raw == 0xFF ? "INVALID" : POS_NAME[raw]);
-      Serial.print(raw != 0xFF && raw == VEHICLE_TARGET[i] ? " (correct)" : "");
+      Serial.print(pos == 0xFF ? "INVALID" : POS_NAME[pos]);
+      Serial.print(pos != 0xFF && pos == VEHICLE_TARGET[i] ? " (correct)" : "");
       Serial.println();
       recomputeCorrect();
     }
@@ -143,8 +181,9 @@ void EY_Vehicles_TestBegin() {
 }
 
 void EY_Vehicles_TestTick() {
+  VehicleWord contacts = contactBits(EY_Inputs_Snapshot());
   for (uint8_t i = 0; i < VEHICLE_COUNT; i++) {
-    uint8_t pos = readPosition(i);
+    uint8_t pos = readPosition(contacts, i);
     if (pos != s_testLast[i]) {
       s_testLast[i] = pos;
       Serial.print("[Vehicles TEST] Switch ");
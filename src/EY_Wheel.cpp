@@ -0,0 +1,240 @@
+#include "EY_Config.h"  // Must be first — brings in PROP_CONFIG which may define HAS_WHEEL
+
+#ifdef HAS_WHEEL
+
+#include "EY_Wheel.h"
+#include "EY_Inputs.h"
+#include "EY_Mqtt.h"
+
+#include <driver/pcnt.h>
+#include <ArduinoJson.h>
+
+#ifndef WHEEL_SEGMENT_OFFSET
+  #define WHEEL_SEGMENT_OFFSET 0
+#endif
+#ifndef WHEEL_SETTLE_MS
+  #define WHEEL_SETTLE_MS 1500
+#endif
+#ifndef WHEEL_MIN_SPIN_PULSES
+  #define WHEEL_MIN_SPIN_PULSES (WHEEL_PULSES_PER_REV / 2)
+#endif
+
+static_assert(WHEEL_PULSES_PER_REV >= 1 && WHEEL_PULSES_PER_REV <= 32767, "WHEEL_PULSES_PER_REV must be 1-32767");
+static_assert(WHEEL_SEGMENTS >= 1 && WHEEL_SEGMENTS <= 64, "WHEEL_SEGMENTS must be 1-64 (one input bank)");
+static_assert(WHEEL_MIN_SPIN_PULSES >= 1, "WHEEL_MIN_SPIN_PULSES must be at least 1");
+
+static constexpr pcnt_unit_t WHEEL_UNIT = PCNT_UNIT_0;
+// The counter clears to 0 on reaching either limit, so it never reads a
+// limit: 32767 pulses take it from 0 back to 0 in either direction.
+static constexpr int16_t COUNTER_HIGH = 32767;
+static constexpr int16_t COUNTER_LOW  = -32767;
+static constexpr int32_t COUNTER_CYCLE = COUNTER_HIGH;
+static constexpr uint16_t FILTER_APB_CYCLES = 1000;  // Ignore glitches < 12.5 µs (max 1023)
+static constexpr unsigned long SPEED_WINDOW_MS = 100;
+
+// A settled spin, handed from the sampler to loop()
+struct WheelSpin {
+  uint32_t pulses;       // Pulses counted, either direction
+  int32_t netPulses;     // Signed sum (direction of travel)
+  uint32_t durationMs;   // First to last pulse
+  uint32_t peakRpmX10;
+  uint8_t segment;
+};
+
+// ---- Sampler state ----
+static int16_t s_lastCount = 0;
+static int32_t s_position = 0;          // 0..WHEEL_PULSES_PER_REV-1
+static bool s_lastIndex = false;
+static bool s_moving = false;
+static unsigned long s_lastPulseMs = 0;
+static WheelSpin s_current = {};
+static unsigned long s_moveStartMs = 0;
+static unsigned long s_windowStartMs = 0;
+static uint32_t s_windowPulses = 0;
+static volatile uint32_t s_rpmX10 = 0;
+static uint64_t s_settled = 0;          // Published word: bit = settled segment
+static volatile bool s_resetRequest = false;
+
+// ---- Handoff to loop() ----
+static portMUX_TYPE s_spinMux = portMUX_INITIALIZER_UNLOCKED;
+static WheelSpin s_done = {};
+static bool s_doneReady = false;
+
+static uint8_t segmentAt(int32_t position) {
+  int32_t p = (position - (WHEEL_SEGMENT_OFFSET % WHEEL_PULSES_PER_REV) + WHEEL_PULSES_PER_REV) % WHEEL_PULSES_PER_REV;
+  return (uint8_t)((uint32_t)p * WHEEL_SEGMENTS / WHEEL_PULSES_PER_REV);
+}
+
+static void publishSettled(uint64_t bits) {
+  if (bits == s_settled) return;
+  s_settled = bits;
+  EY_Inputs_PublishBank(EY_BANK_WHEEL, bits);
+}
+
+// Pulses since the last read. At 1 kHz the counter moves a few counts per
+// read, so a jump of more than half a cycle is a wrap through a limit.
+static int32_t readDelta() {
+  int16_t count = 0;
+  pcnt_get_counter_value(WHEEL_UNIT, &count);
+  int32_t delta = (int32_t)count - s_lastCount;
+  if (delta < -COUNTER_CYCLE / 2) delta += COUNTER_CYCLE;
+  else if (delta > COUNTER_CYCLE / 2) delta -= COUNTER_CYCLE;
+  s_lastCount = count;
+  return delta;
+}
+
+// Sampler hook
+static void poll(uint64_t gpio) {
+  unsigned long now = millis();
+  if (s_resetRequest) {
+    s_resetRequest = false;
+    publishSettled(0);
+  }
+
+  int32_t delta = readDelta();
+  if (delta != 0) {
+    s_position = ((s_position + delta) % WHEEL_PULSES_PER_REV + WHEEL_PULSES_PER_REV) % WHEEL_PULSES_PER_REV;
+    uint32_t mag = (uint32_t)(delta < 0 ? -delta : delta);
+    if (!s_moving) {
+      s_moving = true;
+      s_moveStartMs = now;
+      s_current = {};
+    }
+    s_current.pulses += mag;
+    s_current.netPulses += delta;
+    s_windowPulses += mag;
+    s_lastPulseMs = now;
+    if (s_current.pulses >= WHEEL_MIN_SPIN_PULSES) publishSettled(0);  // Spinning: no segment yet
+  }
+
+#ifdef WHEEL_INDEX_PIN
+  bool index = !EY_Inputs_PinHigh(gpio, WHEEL_INDEX_PIN);
+  if (index && !s_lastIndex) s_position = 0;
+  s_lastIndex = index;
+#else
+  (void)gpio;
+  (void)s_lastIndex;
+#endif
+
+  // Speed over a short window
+  if (now - s_windowStartMs >= SPEED_WINDOW_MS) {
+    uint32_t elapsed = now - s_windowStartMs;
+    s_rpmX10 = (uint32_t)((uint64_t)s_windowPulses * 600000ULL / ((uint64_t)WHEEL_PULSES_PER_REV * elapsed));
+    if (s_moving && s_rpmX10 > s_current.peakRpmX10) s_current.peakRpmX10 = s_rpmX10;
+    s_windowPulses = 0;
+    s_windowStartMs = now;
+  }
+
+  // Settle: quiet for WHEEL_SETTLE_MS after a real spin
+  if (s_moving && now - s_lastPulseMs >= WHEEL_SETTLE_MS) {
+    s_moving = false;
+    if (s_current.pulses >= WHEEL_MIN_SPIN_PULSES) {
+      s_current.segment = segmentAt(s_position);
+      s_current.durationMs = s_lastPulseMs - s_moveStartMs;
+      publishSettled(1ULL << s_current.segment);
+
+      portENTER_CRITICAL(&s_spinMux);
+      s_done = s_current;
+      s_doneReady = true;
+      portEXIT_CRITICAL(&s_spinMux);
+    }
+  }
+}
+
+void EY_Wheel_Begin() {
+  pcnt_config_t config = {};
+  config.pulse_gpio_num = WHEEL_PULSE_PIN;
+#ifdef WHEEL_DIR_PIN
+  config.ctrl_gpio_num = WHEEL_DIR_PIN;
+  config.lctrl_mode = PCNT_MODE_REVERSE;   // B LOW: count down
+#else
+  config.ctrl_gpio_num = PCNT_PIN_NOT_USED;
+  config.lctrl_mode = PCNT_MODE_KEEP;
+#endif
+  config.hctrl_mode = PCNT_MODE_KEEP;
+  config.pos_mode = PCNT_COUNT_INC;         // Rising edges
+  config.neg_mode = PCNT_COUNT_DIS;
+  config.counter_h_lim = COUNTER_HIGH;
+  config.counter_l_lim = COUNTER_LOW;
+  config.unit = WHEEL_UNIT;
+  config.channel = PCNT_CHANNEL_0;
+
+  if (pcnt_unit_config(&config) != ESP_OK) {
+    Serial.println("[Wheel] ERROR: PCNT config failed");
+    return;
+  }
+  pcnt_set_filter_value(WHEEL_UNIT, FILTER_APB_CYCLES);
+  pcnt_filter_enable(WHEEL_UNIT);
+  pcnt_counter_pause(WHEEL_UNIT);
+  pcnt_counter_clear(WHEEL_UNIT);
+  pcnt_counter_resume(WHEEL_UNIT);
+
+#ifdef WHEEL_INDEX_PIN
+  pinMode(WHEEL_INDEX_PIN, INPUT_PULLUP);
+#endif
+
+  s_windowStartMs = millis();
+  EY_Inputs_AddPoller(&poll);
+
+  Serial.print("[Wheel] PCNT on GPIO ");
+  Serial.print(WHEEL_PULSE_PIN);
+  Serial.print(", ");
+  Serial.print(WHEEL_PULSES_PER_REV);
+  Serial.print(" pulses/rev, ");
+  Serial.print(WHEEL_SEGMENTS);
+  Serial.println(" segments");
+}
+
+void EY_Wheel_Tick() {
+  WheelSpin spin;
+  portENTER_CRITICAL(&s_spinMux);
+  bool ready = s_doneReady;
+  spin = s_done;
+  s_doneReady = false;
+  portEXIT_CRITICAL(&s_spinMux);
+  if (!ready) return;
+
+  float revs = (float)spin.pulses / WHEEL_PULSES_PER_REV;
+  Serial.print("[Wheel] Stopped on segment ");
+  Serial.print(spin.segment);
+  Serial.print(" after ");
+  Serial.print(revs, 2);
+  Serial.println(" turns");
+
+  char segment[4];
+  snprintf(segment, sizeof(segment), "%u", spin.segment);
+  EY_PublishEventWithData("wheel_stopped", EY_MQTT::SRC_PLAYER, "segment", segment);
+
+  StaticJsonDocument<256> doc;
+  doc[EY_MQTT::F_PROP_ID] = DEVICE_ID;
+  doc[EY_MQTT::F_TYPE] = "wheel_spin";
+  doc["segment"] = spin.segment;
+  doc["pulses"] = spin.pulses;
+  doc["revs"] = revs;
+  doc["dir"] = (spin.netPulses < 0) ? -1 : 1;
+  doc["durationMs"] = spin.durationMs;
+  doc["peakRpm"] = spin.peakRpmX10 / 10.0f;
+  char out[256];
+  size_t len = serializeJson(doc, out, sizeof(out));
+  EY_PublishDiag(out, len);
+}
+
+void EY_Wheel_Reset() {
+  s_resetRequest = true;
+  portENTER_CRITICAL(&s_spinMux);
+  s_doneReady = false;
+  portEXIT_CRITICAL(&s_spinMux);
+  // Return once the sampler has dropped the settled segment and stored a
+  // frame without it
+  EY_Inputs_Sync();
+}
+
+uint8_t EY_Wheel_GetSegment() {
+  return segmentAt(s_position);
+}
+
+float EY_Wheel_GetRpm() {
+  return s_rpmX10 / 10.0f;
+}
+
+#endif // HAS_WHEEL
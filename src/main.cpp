@@ -5,6 +5,8 @@
 #include "EY_Mqtt.h"
 #include "EY_Sensors.h"
 #include "EY_Outputs.h"
+#include "EY_Inputs.h"
+#include "EY_Loop.h"
 
 #ifdef HAS_SHAKER
 #include "EY_Shaker.h"
@@ -42,27 +44,97 @@
 #include "EY_PIR.h"
 #endif
 
+#ifdef HAS_MCP23017
+#include "EY_MCP23017.h"
+#endif
+
+#ifdef HAS_HC165
+#include "EY_HC165.h"
+#endif
+
+#ifdef HAS_MATRIX
+#include "EY_Matrix.h"
+#endif
+
+#ifdef HAS_HC595
+#include "EY_HC595.h"
+#endif
+
+#ifdef HAS_PCA9685
+#include "EY_PCA9685.h"
+#endif
+
+#ifdef HAS_PIXELS
+#include "EY_Pixels.h"
+#endif
+
+#ifdef HAS_DMX
+#include "EY_DMX.h"
+#endif
+
 #ifdef HAS_SERVO
-static void servoSetAngle(int angle) {
-  // DS3225: 500µs (0°) to 2500µs (180°)
-  // At 50Hz (20ms period), 16-bit resolution (65536 steps)
-  int dutyMin = (500 * 65536) / 20000;   // ~1638
-  int dutyMax = (2500 * 65536) / 20000;  // ~8192
-  int duty = map(angle, 0, 180, dutyMin, dutyMax);
-  ledcWrite(0, duty);  // channel 0
-  Serial.print("[Servo] Angle: ");
-  Serial.println(angle);
-}
+#include "EY_Servo.h"
+#endif
+
+#ifdef HAS_STEPPER
+#include "EY_Stepper.h"
+#endif
+
+#ifdef HAS_ANALOG
+#include "EY_Analog.h"
+#endif
+
+#ifdef HAS_TOUCH
+#include "EY_Touch.h"
+#endif
+
+#ifdef HAS_WHEEL
+#include "EY_Wheel.h"
+#endif
+
+#ifdef HAS_RFID
+#include "EY_RFID.h"
+#endif
+
+#ifdef HAS_NODES
+#include "EY_Nodes.h"
+#endif
+
+// Props solved by the generic sensor path (no module with its own solve logic)
+#if !defined(HAS_WIEGAND) && !defined(HAS_IR) && !defined(HAS_SIMON) && !defined(HAS_VEHICLES) && !defined(HAS_SHAKER)
+#define GENERIC_SOLVE
+#endif
+
+#if defined(HAS_PUZZLE_GROUPS) && !defined(GENERIC_SOLVE)
+#error "HAS_PUZZLE_GROUPS needs the generic sensor solve path (no Wiegand/IR/Simon/Vehicles/Shaker)"
 #endif
 
 // =====================
 // Prop State
 // =====================
-static bool solvedLatched = false;
+// One per puzzle group (PUZZLE_GROUPS[] — a single group unless the prop
+// declares HAS_PUZZLE_GROUPS). Board-level modules (Simon, servo, RF433...)
+// belong to group 0.
+struct PuzzleState {
+  bool solvedLatched;
+  const char* lastChangeSource;  // Who last changed solved state
+  bool overrideActive;           // Whether a GM override is active
+  bool solveUnreported;          // Player solve latched (outputs released), not yet published
+};
+static PuzzleState puzzles[PUZZLE_GROUP_COUNT];
+
+static void clearPuzzle(uint8_t group) {
+  puzzles[group] = { false, EY_MQTT::SRC_DEVICE, false, false };
+}
 
-// Track who last changed solved state and whether a GM override is active
-static const char* lastChangeSource = EY_MQTT::SRC_DEVICE;
-static bool overrideActive = false;
+static void publishStatus(uint8_t group) {
+  const PuzzleState& p = puzzles[group];
+  EY_PublishStatus(group, p.solvedLatched, p.lastChangeSource, p.overrideActive);
+}
+
+static void publishAllStatus() {
+  for (uint8_t g = 0; g < PUZZLE_GROUP_COUNT; g++) publishStatus(g);
+}
 
 // Ignore sensors briefly after reset (to avoid instant re-solve)
 static unsigned long ignoreSensorsStart = 0;
@@ -72,22 +144,63 @@ static bool ignoringSensors = false;
 static unsigned long lastBlink = 0;
 static bool ledState = false;
 
-// Counted-flash state (1 flash per press, 3 flashes on solve)
-static uint8_t       ledFlashesRemaining = 0;
-static bool          ledFlashPhaseOn = false;
-static unsigned long ledFlashPhaseStart = 0;
+static void setLed(bool on) {
+#ifdef HAS_SIMON
+  // GPIO2 (LED_PIN) doubles as Simon LED #1 — the game owns that pin.
+  // Suppress the onboard status LED so it can't fight the game's blink.
+  (void)on;
+  return;
+#else
+  if (LED_ACTIVE_LOW) {
+    digitalWrite(LED_PIN, on ? LOW : HIGH);
+  } else {
+    digitalWrite(LED_PIN, on ? HIGH : LOW);
+  }
+#endif
+}
+
+// Counted-flash state (1 flash per press, 3 flashes on solve), one loop
+// timer deadline per phase
+static uint8_t ledFlashesRemaining = 0;
+static bool    ledFlashPhaseOn = false;
+static int8_t  ledFlashTimer = -1;
 static constexpr unsigned long LED_FLASH_PHASE_MS = 120;
 
+static void ledFlashStep(void*) {
+  if (ledFlashPhaseOn) {
+    ledFlashPhaseOn = false;
+    setLed(false);
+  } else if (ledFlashesRemaining > 0 && --ledFlashesRemaining > 0) {
+    ledFlashPhaseOn = true;
+    setLed(true);
+  } else {
+    return;  // Done: loop() shows the solved state again
+  }
+  EY_Loop_After(ledFlashTimer, LED_FLASH_PHASE_MS);
+}
+
 static void triggerLedFlashes(uint8_t count) {
   ledFlashesRemaining = count;
   ledFlashPhaseOn = true;
-  ledFlashPhaseStart = millis();
+  setLed(true);
+  EY_Loop_Cancel(ledFlashTimer);  // Restart the phase
+  EY_Loop_After(ledFlashTimer, LED_FLASH_PHASE_MS);
 }
 
-// Reset feedback
+// Reset feedback (fast blink)
 static unsigned long resetFeedbackStart = 0;
 static bool resetFeedbackActive = false;
-static unsigned long lastResetBlink = 0;
+static int8_t resetFeedbackTimer = -1;
+
+static void resetFeedbackStep(void*) {
+  if (millis() - resetFeedbackStart >= RESET_FEEDBACK_MS) {
+    resetFeedbackActive = false;
+    return;
+  }
+  ledState = !ledState;
+  setLed(ledState);
+  EY_Loop_After(resetFeedbackTimer, RESET_FEEDBACK_BLINK_MS);
+}
 
 // MQTT status announcement tracking
 static bool statusAnnounced = false;
@@ -109,52 +222,79 @@ static bool manualResetWasPressed = false;
 // Callbacks
 // =====================
 
-static void onSetSolved(bool value, const char* source) {
-  // GM override: only allow forcing the puzzle forward (solved=true).
-  // Reverting state mid-session is not supported; use reset instead.
-  if (!value) return;
-
-  lastChangeSource = (source && source[0]) ? source : EY_MQTT::SRC_DEVICE;
+static void forceSolveGroup(uint8_t group, const char* source) {
+  PuzzleState& p = puzzles[group];
+  p.lastChangeSource = (source && source[0]) ? source : EY_MQTT::SRC_DEVICE;
 
-  if (strcmp(lastChangeSource, EY_MQTT::SRC_GM) == 0) {
-    overrideActive = true;
+  if (strcmp(p.lastChangeSource, EY_MQTT::SRC_GM) == 0) {
+    p.overrideActive = true;
   }
 
-  solvedLatched = true;
+  p.solvedLatched = true;
 
   // Unlock outputs (maglocks) on force solve
-  EY_Outputs_Release();
+  EY_Outputs_Release(group);
+#ifdef HAS_SERVO
+  EY_Servo_Open(group);
+#endif
+#ifdef HAS_STEPPER
+  EY_Stepper_Open(group);
+#endif
+
+  if (group == 0) {
 
 #ifdef HAS_SIMON
-  EY_Simon_ForceSolve();
+    EY_Simon_ForceSolve();
 #endif
 
 #ifdef HAS_VEHICLES
-  EY_Vehicles_ForceSolve();
+    EY_Vehicles_ForceSolve();
 #endif
 
 #ifdef HAS_CODE_SEQUENCE
-  EY_CodeSequence_ForceSolve();
-#endif
-
-#ifdef HAS_SERVO
-  servoSetAngle(SERVO_ANGLE_OPEN);
+    EY_CodeSequence_ForceSolve();
 #endif
 
 #ifdef HAS_BOBINE
-  // Bobine has no sensors — force_solved only fires via GM cmd from
-  // the dashboard. Treat it as "reveal everything now" (the bobine's
-  // semantic solved state). The Room Controller drives the looping
-  // light sequence via the separate `start_sequence` MQTT command.
-  EY_Bobine_RevealAll();
+    // Bobine has no sensors — force_solved only fires via GM cmd from
+    // the dashboard. Treat it as "reveal everything now" (the bobine's
+    // semantic solved state). The Room Controller drives the looping
+    // light sequence via the separate `start_sequence` MQTT command.
+    EY_Bobine_RevealAll();
 #endif
 
 #ifdef HAS_RF433
-  EY_RF433_Send(RF_CODE_UP);
+    EY_RF433_Send(RF_CODE_UP);
 #endif
+  }
 
-  EY_PublishEvent("force_solved", lastChangeSource);
-  EY_PublishStatus(true, lastChangeSource, overrideActive);
+  EY_PublishGroupEvent(group, "force_solved", p.lastChangeSource);
+  publishStatus(group);
+}
+
+#ifdef GENERIC_SOLVE
+// Player solve, called by EY_Sensors the moment a group's condition is met:
+// unlock first, everything else (servo, LED, status, logs) follows in loop()
+static void onSensorsSolved(uint8_t group) {
+  PuzzleState& p = puzzles[group];
+  if (p.solvedLatched) return;
+  p.solvedLatched = true;
+  p.lastChangeSource = EY_MQTT::SRC_PLAYER;
+  p.solveUnreported = true;
+
+  // Unlock outputs (maglocks) on player solve
+  EY_Outputs_Release(group);
+}
+#endif
+
+static void onSetSolved(uint8_t group, bool value, const char* source) {
+  // GM override: only allow forcing the puzzle forward (solved=true).
+  // Reverting state mid-session is not supported; use reset instead.
+  if (!value) return;
+
+  for (uint8_t g = 0; g < PUZZLE_GROUP_COUNT; g++) {
+    if (group == EY_ALL_GROUPS || g == group) forceSolveGroup(g, source);
+  }
 }
 
 #ifdef HAS_CODE_SEQUENCE
@@ -165,33 +305,45 @@ static void onCodeSubmitted(const char* code) {
 }
 #endif
 
-static void setLed(bool on) {
-#ifdef HAS_SIMON
-  // GPIO2 (LED_PIN) doubles as Simon LED #1 — the game owns that pin.
-  // Suppress the onboard status LED so it can't fight the game's blink.
-  (void)on;
-  return;
-#else
-  if (LED_ACTIVE_LOW) {
-    digitalWrite(LED_PIN, on ? LOW : HIGH);
-  } else {
-    digitalWrite(LED_PIN, on ? HIGH : LOW);
-  }
+// GM reset of one puzzle group: its sensors and outputs start over while
+// the other groups keep playing (no sensor ignore window, no LED feedback)
+static void handleGroupReset(uint8_t group) {
+  if (group >= PUZZLE_GROUP_COUNT) return;
+  clearPuzzle(group);
+  EY_Sensors_ResetGroup(group);
+  EY_Outputs_Reset(group);
+#ifdef HAS_SERVO
+  EY_Servo_Close(group);
+#endif
+#ifdef HAS_STEPPER
+  EY_Stepper_Close(group);
 #endif
+  publishStatus(group);
+  Serial.print("[Main] Reset complete for group ");
+  Serial.println(group);
 }
 
-static void handleReset() {
+static void handleReset(uint8_t group) {
+  if (group != EY_ALL_GROUPS && PUZZLE_GROUP_COUNT > 1) {
+    handleGroupReset(group);
+    return;
+  }
+
   // NOTE: Simon previously ignored external resets ("auto-manages") to avoid
   // reset storms, but that also broke the GM's manual "Réinitialiser". A GM
   // click is a legitimate one-shot, so resets now flow through and restart the
   // Simon game via EY_Simon_Reset() below.
-  solvedLatched = false;
-  lastChangeSource = EY_MQTT::SRC_DEVICE;
-  overrideActive = false;
+  for (uint8_t g = 0; g < PUZZLE_GROUP_COUNT; g++) clearPuzzle(g);
+
+#ifdef HAS_WHEEL
+  // Drop the settled segment first so sensors don't re-seed it as present
+  // (returns once the sampler's frame no longer holds it)
+  EY_Wheel_Reset();
+#endif
 
   // Reset sensor states and re-arm outputs (re-lock maglocks)
   EY_Sensors_Reset();
-  EY_Outputs_Reset();
+  EY_Outputs_Reset(EY_ALL_GROUPS);
 
 #ifdef HAS_SHAKER
   EY_Shaker_Reset();
@@ -214,7 +366,11 @@ static void handleReset() {
 #endif
 
 #ifdef HAS_SERVO
-  servoSetAngle(SERVO_ANGLE_CLOSED);
+  EY_Servo_Close(EY_ALL_GROUPS);
+#endif
+
+#ifdef HAS_STEPPER
+  EY_Stepper_Close(EY_ALL_GROUPS);
 #endif
 
 #ifdef HAS_BOBINE
@@ -231,29 +387,33 @@ static void handleReset() {
 
   ignoringSensors = true;
   ignoreSensorsStart = millis();
+  EY_Loop_WakeAt(ignoreSensorsStart + IGNORE_SENSORS_MS);
 
   // Visual feedback
   resetFeedbackActive = true;
   resetFeedbackStart = millis();
-  lastResetBlink = millis();
   ledState = false;
   setLed(false);
+  EY_Loop_Cancel(resetFeedbackTimer);
+  EY_Loop_After(resetFeedbackTimer, RESET_FEEDBACK_BLINK_MS);
 
   statusAnnounced = false;
 
-  EY_PublishStatus(false, lastChangeSource, overrideActive);
+  publishAllStatus();
   Serial.println("[Main] Reset complete");
 }
 
-static void handleArm() {
-  EY_Outputs_Arm();
+static void handleArm(uint8_t group) {
+  EY_Outputs_Arm(group);
 #ifdef HAS_SIMON
   EY_Simon_Activate();
 #endif
 #ifdef HAS_VEHICLES
   EY_Vehicles_Activate();
 #endif
-  EY_PublishStatus(solvedLatched, lastChangeSource, overrideActive);
+  for (uint8_t g = 0; g < PUZZLE_GROUP_COUNT; g++) {
+    if (group == EY_ALL_GROUPS || g == group) publishStatus(g);
+  }
   Serial.println("[Main] Outputs armed");
 }
 
@@ -269,6 +429,11 @@ void setup() {
   digitalWrite(RF433_TX_PIN, LOW);
 #endif
 
+  // Wake-ups and loop timers (before any module schedules one)
+  EY_Loop_Begin();
+  ledFlashTimer = EY_Loop_TimerCreate(&ledFlashStep, nullptr);
+  resetFeedbackTimer = EY_Loop_TimerCreate(&resetFeedbackStep, nullptr);
+
   Serial.begin(115200);
   delay(800);
   Serial.println("==============================");
@@ -279,19 +444,71 @@ void setup() {
   Serial.println(SENSOR_COUNT);
   Serial.print("Outputs: ");
   Serial.println(OUTPUT_COUNT);
+  Serial.print("Puzzle groups: ");
+  Serial.println(PUZZLE_GROUP_COUNT);
   Serial.println("==============================");
 
+  for (uint8_t g = 0; g < PUZZLE_GROUP_COUNT; g++) clearPuzzle(g);
+
   // Initialize hardware
   pinMode(LED_PIN, OUTPUT);
   pinMode(RESET_BTN_PIN, INPUT_PULLUP);
   setLed(false);
 
+  // Input backends (before the sampler starts polling them)
+#ifdef HAS_MCP23017
+  EY_MCP23017_Begin();
+#endif
+#ifdef HAS_HC165
+  EY_HC165_Begin();
+#endif
+#ifdef HAS_MATRIX
+  EY_Matrix_Begin();
+#endif
+#ifdef HAS_ANALOG
+  EY_Analog_Begin();
+#endif
+#ifdef HAS_TOUCH
+  EY_Touch_Begin();
+#endif
+#ifdef HAS_WHEEL
+  EY_Wheel_Begin();
+#endif
+#ifdef HAS_RFID
+  EY_RFID_Begin();
+#endif
+#ifdef HAS_NODES
+  EY_Nodes_Begin();
+#endif
+
+  // Start fixed-rate input sampling (before any module that reads inputs)
+  EY_Inputs_Begin();
+
   // Initialize sensor system
   EY_Sensors_Begin();
 
+  // Output backends (before the outputs write their fail-safe frame)
+#ifdef HAS_HC595
+  EY_HC595_Begin();
+#endif
+#ifdef HAS_PCA9685
+  EY_PCA9685_Begin();
+#endif
+#ifdef HAS_PIXELS
+  EY_Pixels_Begin();
+#endif
+#ifdef HAS_DMX
+  EY_DMX_Begin();
+#endif
+
   // Initialize output system (maglocks, relays — starts INACTIVE/unlocked)
   EY_Outputs_Begin();
 
+#ifdef GENERIC_SOLVE
+  // Release a group's outputs as soon as its sensors solve it
+  EY_Sensors_OnSolved(onSensorsSolved);
+#endif
+
 #ifdef HAS_SHAKER
   // Initialize shaker module (uses receiver pin from first sensor)
   EY_Shaker_Begin(SENSORS[0].pin);
@@ -331,13 +548,13 @@ void setup() {
 #endif
 
 #ifdef HAS_SERVO
-  ledcSetup(0, 50, 16);          // channel 0, 50Hz, 16-bit resolution
-  ledcAttachPin(SERVO_PIN, 0);   // attach servo pin to channel 0
-  // Startup test: sweep open then back to closed
-  servoSetAngle(SERVO_ANGLE_OPEN);
-  delay(1000);
-  servoSetAngle(SERVO_ANGLE_CLOSED);
-  Serial.println("[Servo] Initialized (startup sweep done)");
+  // Parks the servos; the optional boot sweep runs in the background
+  EY_Servo_Begin();
+#endif
+
+#ifdef HAS_STEPPER
+  // Motors hold position; homes at boot with STEPPER_HOME_ON_BOOT
+  EY_Stepper_Begin();
 #endif
 
   // Start networking (non-blocking)
@@ -353,6 +570,10 @@ void setup() {
 
   ArduinoOTA.onStart([]() {
     Serial.println("[OTA] Update starting...");
+#ifdef HAS_STEPPER
+    // Flash writes stall the RMT refill interrupt: no motor may be moving
+    if (!EY_Stepper_StopAll(2000)) Serial.println("[OTA] WARNING: a stepper is still moving");
+#endif
   });
   ArduinoOTA.onEnd([]() {
     Serial.println("[OTA] Update complete, rebooting...");
@@ -369,7 +590,7 @@ void setup() {
   // ArduinoOTA.begin() is deferred to loop() — requires WiFi to be connected
 
   // Announce initial state (will only publish if MQTT is already connected)
-  EY_PublishStatus(false, lastChangeSource, overrideActive);
+  publishAllStatus();
 
 #if defined(BOBINE_TEST_MODE) && defined(HAS_BOBINE)
   // Wiring-bench test: auto-start the looping sequence at boot so the
@@ -385,6 +606,13 @@ void setup() {
 // =====================
 
 void loop() {
+  // Sleep until an input changes, a deadline is due or the network needs polling
+  EY_Loop_Wait();
+
+  // ---- Sample every input once (single input frame per tick) ----
+  EY_Inputs_Sample();
+  const EY_InputFrame& inputs = EY_Inputs_SnapshotFrame();
+
 #if defined(SIMON_TEST_MODE) && defined(HAS_SIMON)
   // DEV WIRING TEST: all LEDs solid ON; press a lit button → it blinks 3x → solid.
   // Networking + OTA stay alive so we can flash back out of test mode.
@@ -419,25 +647,39 @@ void loop() {
   // This must be first to ensure instant response without network delays
   if (LED_MIRROR_SENSOR >= 0 && LED_MIRROR_SENSOR < SENSOR_COUNT) {
     const SensorDef& mirrorDef = SENSORS[LED_MIRROR_SENSOR];
-    bool present = (mirrorDef.presentWhen == PresentWhen::LOW_LEVEL)
-      ? (digitalRead(mirrorDef.pin) == LOW)
-      : (digitalRead(mirrorDef.pin) == HIGH);
+    bool high = EY_Inputs_PinHigh(inputs, EY_Sensors_InputPin(mirrorDef));
+    bool present = EY_Sensors_ActiveLow(mirrorDef) ? !high : high;
     setLed(present);
   }
 
   // Networking always ticks, but never blocks prop logic
   EY_Net_Tick();
 
-#ifdef HAS_BOBINE
-  // Ceiling bobine sequence — non-blocking; no-op when not running
-  EY_Bobine_Tick();
-#endif
-
 #ifdef HAS_PIR
   // PIR motion sensor — independent of solve/sensor logic, just publishes events
   EY_PIR_Tick();
 #endif
 
+#ifdef HAS_WHEEL
+  // Wheel spin telemetry — counting and settle detection run in the input sampler
+  EY_Wheel_Tick();
+#endif
+
+#ifdef HAS_RFID
+  // Tag UID events — readers are polled by their own task
+  EY_RFID_Tick();
+#endif
+
+#ifdef HAS_STEPPER
+  // Homing and limit switch logs — motors run from the timer service
+  EY_Stepper_Tick();
+#endif
+
+#ifdef HAS_NODES
+  // ESP-NOW start + link statistics — packets are consumed by the input sampler
+  EY_Nodes_Tick();
+#endif
+
   // Start OTA once WiFi is connected (deferred from setup)
   if (!otaStarted && WiFi.status() == WL_CONNECTED) {
     ArduinoOTA.begin();
@@ -452,7 +694,7 @@ void loop() {
 
   // If we (re)connected to MQTT, announce current status once
   if (EY_Mqtt_Connected() && !statusAnnounced) {
-    EY_PublishStatus(solvedLatched, lastChangeSource, overrideActive);
+    publishAllStatus();
     statusAnnounced = true;
   }
 
@@ -462,68 +704,69 @@ void loop() {
   // would un-do force-solve and constantly restart the game). Simon is reset via
   // the GM's MQTT command instead.
 #ifndef HAS_SIMON
-  bool resetPressed = (digitalRead(RESET_BTN_PIN) == LOW);
+  bool resetPressed = !EY_Inputs_PinHigh(inputs, RESET_BTN_PIN);
 
   if (resetPressed && !resetBtnWasPressed) {
     resetBtnPressedAt = millis();
     resetBtnWasPressed = true;
+    EY_Loop_WakeAt(resetBtnPressedAt + RESET_HOLD_MS);
   }
   if (!resetPressed) {
     resetBtnWasPressed = false;
   }
   if (resetBtnWasPressed && (millis() - resetBtnPressedAt >= RESET_HOLD_MS)) {
     Serial.println("[DEBUG] Reset triggered by BOOT button");
-    handleReset();
+    handleReset(EY_ALL_GROUPS);
     resetBtnWasPressed = false;
   }
 #endif
 
 #ifdef HAS_MANUAL_RESET
   // ---- Manual reset button (long-press) ----
-  bool manualResetPressed = (digitalRead(MANUAL_RESET_PIN) == LOW);
+  bool manualResetPressed = !EY_Inputs_PinHigh(inputs, MANUAL_RESET_PIN);
 
   if (manualResetPressed && !manualResetWasPressed) {
     manualResetPressedAt = millis();
     manualResetWasPressed = true;
+    EY_Loop_WakeAt(manualResetPressedAt + MANUAL_RESET_HOLD_MS);
   }
   if (!manualResetPressed) {
     manualResetWasPressed = false;
   }
   if (manualResetWasPressed && (millis() - manualResetPressedAt >= MANUAL_RESET_HOLD_MS)) {
     Serial.println("[DEBUG] Reset triggered by manual reset button (3s hold)");
-    handleReset();
+    handleReset(EY_ALL_GROUPS);
     manualResetWasPressed = false;
   }
 #endif
 
-  // ---- Reset feedback (fast blink) has priority ----
+  // ---- Reset feedback (fast blink, on a loop timer) has priority ----
   if (resetFeedbackActive) {
-    if (millis() - resetFeedbackStart >= RESET_FEEDBACK_MS) {
-      resetFeedbackActive = false;
-    } else {
-      if (millis() - lastResetBlink >= RESET_FEEDBACK_BLINK_MS) {
-        ledState = !ledState;
-        setLed(ledState);
-        lastResetBlink = millis();
-      }
-      return;  // Skip sensor processing during reset feedback
-    }
+    return;  // Skip sensor processing during reset feedback
   }
 
   // ---- Sensor processing ----
-  if (!ignoringSensors || millis() - ignoreSensorsStart >= IGNORE_SENSORS_MS) {
+  if (ignoringSensors && millis() - ignoreSensorsStart >= IGNORE_SENSORS_MS) {
     ignoringSensors = false;
+    // The sampler kept recording while sensors were ignored: skip those
+    // changes, or presses made during the window would be replayed now
+    EY_Sensors_Resync();
+#ifdef HAS_SIMON
+    EY_Simon_Resync();
+#endif
+  }
+  if (!ignoringSensors) {
 
 #ifdef HAS_WIEGAND
     // Wiegand: just tick the reader. Solve logic lives in code-sequence
     // module (if present); otherwise Pi handles puzzle state.
     EY_Wiegand_Tick();
   #ifdef HAS_CODE_SEQUENCE
-    if (!solvedLatched && EY_CodeSequence_IsSolved()) {
-      solvedLatched = true;
-      lastChangeSource = EY_MQTT::SRC_PLAYER;
-      EY_Outputs_Release();
-      EY_PublishStatus(solvedLatched, lastChangeSource, overrideActive);
+    if (!puzzles[0].solvedLatched && EY_CodeSequence_IsSolved()) {
+      puzzles[0].solvedLatched = true;
+      puzzles[0].lastChangeSource = EY_MQTT::SRC_PLAYER;
+      EY_Outputs_Release(0);
+      publishStatus(0);
       Serial.println("[Main] SOLVED by player!");
     }
   #endif
@@ -539,12 +782,12 @@ void loop() {
       static unsigned long lastSimonStatus = 0;
       if (millis() - lastSimonStatus >= SIMON_REPORT_INTERVAL_MS) {
         lastSimonStatus = millis();
-        EY_PublishStatus(solvedLatched, lastChangeSource, overrideActive);
+        publishStatus(0);
       }
     }
 
     // Onboard LED: blink proportional to progress, solid when solved
-    if (!solvedLatched) {
+    if (!puzzles[0].solvedLatched) {
       uint8_t progress = EY_Simon_GetProgress();
       if (progress == 0) {
         setLed(false);
@@ -561,13 +804,13 @@ void loop() {
     }
 
     // Latch solved state
-    if (!solvedLatched && simonSolved) {
-      solvedLatched = true;
-      lastChangeSource = EY_MQTT::SRC_PLAYER;
+    if (!puzzles[0].solvedLatched && simonSolved) {
+      puzzles[0].solvedLatched = true;
+      puzzles[0].lastChangeSource = EY_MQTT::SRC_PLAYER;
 
-      EY_Outputs_Release();
+      EY_Outputs_Release(0);
 
-      EY_PublishStatus(solvedLatched, lastChangeSource, overrideActive);
+      publishStatus(0);
       Serial.println("[Main] SOLVED by player!");
     }
 #elif defined(HAS_VEHICLES)
@@ -579,12 +822,12 @@ void loop() {
       static unsigned long lastVehiclesStatus = 0;
       if (millis() - lastVehiclesStatus >= VEHICLE_REPORT_INTERVAL_MS) {
         lastVehiclesStatus = millis();
-        EY_PublishStatus(solvedLatched, lastChangeSource, overrideActive);
+        publishStatus(0);
       }
     }
 
     // Onboard LED: blink proportional to progress, solid when solved
-    if (!solvedLatched) {
+    if (!puzzles[0].solvedLatched) {
       uint8_t progress = EY_Vehicles_GetProgress();
       if (progress == 0) {
         setLed(false);
@@ -602,13 +845,13 @@ void loop() {
 
     // Latch solved state. Note: once the combination latches it stays solved
     // even if a player nudges a switch afterward (until GM reset / re-arm).
-    if (!solvedLatched && vehiclesSolved) {
-      solvedLatched = true;
-      lastChangeSource = EY_MQTT::SRC_PLAYER;
+    if (!puzzles[0].solvedLatched && vehiclesSolved) {
+      puzzles[0].solvedLatched = true;
+      puzzles[0].lastChangeSource = EY_MQTT::SRC_PLAYER;
 
-      EY_Outputs_Release();
+      EY_Outputs_Release(0);
 
-      EY_PublishStatus(solvedLatched, lastChangeSource, overrideActive);
+      publishStatus(0);
       Serial.println("[Main] SOLVED by player!");
     }
 #elif defined(HAS_SHAKER)
@@ -620,12 +863,12 @@ void loop() {
       static unsigned long lastShakerStatus = 0;
       if (millis() - lastShakerStatus >= SHAKE_REPORT_INTERVAL_MS) {
         lastShakerStatus = millis();
-        EY_PublishStatus(solvedLatched, lastChangeSource, overrideActive);
+        publishStatus(0);
       }
     }
 
     // LED: blink proportional to shake progress
-    if (!solvedLatched) {
+    if (!puzzles[0].solvedLatched) {
       uint8_t progress = EY_Shaker_GetProgress();
       if (progress == 0) {
         setLed(false);
@@ -644,28 +887,24 @@ void loop() {
     }
 
     // Latch solved state
-    if (!solvedLatched && shakerSolved) {
-      solvedLatched = true;
-      lastChangeSource = EY_MQTT::SRC_PLAYER;
+    if (!puzzles[0].solvedLatched && shakerSolved) {
+      puzzles[0].solvedLatched = true;
+      puzzles[0].lastChangeSource = EY_MQTT::SRC_PLAYER;
 
       // Unlock outputs (maglocks) on player solve
-      EY_Outputs_Release();
+      EY_Outputs_Release(0);
 
-      EY_PublishStatus(solvedLatched, lastChangeSource, overrideActive);
+      publishStatus(0);
       Serial.println("[Main] SOLVED by player!");
     }
 #else
     // Track sensor count before tick to detect new triggers
     static uint8_t prevPresentCount = 0;
 
-    bool sensorsSolved = EY_Sensors_Tick();
+    EY_Sensors_Tick();
 
     // Count currently present sensors
-    uint8_t presentCount = 0;
-    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
-      const SensorState* st = EY_Sensors_GetState(i);
-      if (st && st->present) presentCount++;
-    }
+    uint8_t presentCount = EY_Sensors_GetPresentCount();
 
     // 1 LED flash per new press (wiring/debug feedback)
     if (presentCount > prevPresentCount) {
@@ -676,56 +915,55 @@ void loop() {
     }
     prevPresentCount = presentCount;
 
-    // Republish status on any sensor state change so the GM dashboard sees
-    // both SEQUENCE progress (latched per-step) and decorative button
-    // presses/releases (momentary triggered field) in real time.
-    static uint8_t prevSeqIndex = 0;
-    uint8_t curSeqIndex = EY_Sensors_GetSequenceIndex();
-    bool seqChanged = (curSeqIndex != prevSeqIndex);
-    if ((seqChanged || EY_Sensors_StateChangedThisTick()) && !sensorsSolved) {
-      EY_PublishStatus(solvedLatched, lastChangeSource, overrideActive);
-    }
-    prevSeqIndex = curSeqIndex;
+    static uint8_t prevSeqIndex[PUZZLE_GROUP_COUNT] = {};
+    bool allSolved = true;
+    for (uint8_t g = 0; g < PUZZLE_GROUP_COUNT; g++) {
+      PuzzleState& p = puzzles[g];
+      bool sensorsSolved = EY_Sensors_IsSolved(g);
+
+      // Republish status on any sensor state change so the GM dashboard sees
+      // both SEQUENCE progress (latched per-step) and decorative button
+      // presses/releases (momentary triggered field) in real time.
+      uint8_t curSeqIndex = EY_Sensors_GetSequenceIndex(g);
+      bool seqChanged = (curSeqIndex != prevSeqIndex[g]);
+      if ((seqChanged || EY_Sensors_StateChangedThisTick(g)) && !sensorsSolved) {
+        publishStatus(g);
+      }
+      prevSeqIndex[g] = curSeqIndex;
 
-    // Latch solved state (must run before the LED tick so the 3-flash
-    // burst supersedes any 1-flash queued earlier in the same iteration)
-    if (!solvedLatched && sensorsSolved) {
-      solvedLatched = true;
-      lastChangeSource = EY_MQTT::SRC_PLAYER;
+      // Solved outside a tick (e.g. sensors held through a reset)
+      if (!p.solvedLatched && sensorsSolved) onSensorsSolved(g);
 
-      // Unlock outputs (maglocks) on player solve
-      EY_Outputs_Release();
+      // Report a player solve (must run before the LED tick so the 3-flash
+      // burst supersedes any 1-flash queued earlier in the same iteration)
+      if (p.solveUnreported) {
+        p.solveUnreported = false;
 
 #ifdef HAS_SERVO
-      servoSetAngle(SERVO_ANGLE_OPEN);
+        EY_Servo_Open(g);
+#endif
+#ifdef HAS_STEPPER
+        EY_Stepper_Open(g);
 #endif
 
-      triggerLedFlashes(3);
-      EY_PublishStatus(solvedLatched, lastChangeSource, overrideActive);
-      Serial.println("[Main] SOLVED by player!");
-    }
-
-    // LED state machine: N counted flashes, otherwise solid = solvedLatched
-    if (ledFlashesRemaining > 0) {
-      unsigned long now = millis();
-      if (ledFlashPhaseOn) {
-        setLed(true);
-        if (now - ledFlashPhaseStart >= LED_FLASH_PHASE_MS) {
-          ledFlashPhaseOn = false;
-          ledFlashPhaseStart = now;
-        }
-      } else {
-        setLed(false);
-        if (now - ledFlashPhaseStart >= LED_FLASH_PHASE_MS) {
-          ledFlashesRemaining--;
-          if (ledFlashesRemaining > 0) {
-            ledFlashPhaseOn = true;
-            ledFlashPhaseStart = now;
-          }
+        triggerLedFlashes(3);
+        publishStatus(g);
+        Serial.print("[Main] SOLVED by player!");
+        uint64_t solvedAtUs = EY_Sensors_GetSolvedAtUs(g);
+        uint64_t releasedAtUs = EY_Outputs_GetReleasedAtUs(g);
+        if (solvedAtUs && releasedAtUs >= solvedAtUs) {
+          Serial.print(" Outputs released ");
+          Serial.print((uint32_t)(releasedAtUs - solvedAtUs));
+          Serial.print(" µs after the input");
         }
+        Serial.println();
       }
-    } else {
-      setLed(solvedLatched);
+      allSolved = allSolved && p.solvedLatched;
+    }
+
+    // LED: N counted flashes (loop timer), otherwise solid = every group solved
+    if (ledFlashesRemaining == 0) {
+      setLed(allSolved);
     }
 #endif
   }
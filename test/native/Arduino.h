@@ -0,0 +1,32 @@
+#pragma once
+// Host stand-in for the Arduino core, native test env only (see
+// platformio.ini [env:native]). Just enough for the hardware-free headers
+// and sources under test; the clock is driven by the tests.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+inline unsigned long g_testMillis = 0;
+
+inline unsigned long millis() { return g_testMillis; }
+inline unsigned long micros() { return g_testMillis * 1000UL; }
+
+#define INPUT_PULLUP 0x05
+inline void pinMode(uint8_t, uint8_t) {}
+
+class IPAddress {
+ public:
+  constexpr IPAddress(uint8_t, uint8_t, uint8_t, uint8_t) {}
+};
+
+// Serial output goes to stdout
+class HostSerial {
+ public:
+  void print(const char* s) { fputs(s, stdout); }
+  void print(long v) { printf("%ld", v); }
+  void println(const char* s = "") { puts(s); }
+  void println(long v) { printf("%ld\n", v); }
+};
+inline HostSerial Serial;
@@ -0,0 +1,5 @@
+#pragma once
+// Host stand-in for ESP-IDF esp_timer.h (native test env): the test clock
+#include <Arduino.h>
+
+inline int64_t esp_timer_get_time() { return (int64_t)micros(); }
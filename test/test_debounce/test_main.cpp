@@ -0,0 +1,133 @@
+// Shared vertical-counter debouncer (EY_Debounce.h): behavior, and a
+// microbenchmark against the per-input lastRaw/lastChangeMs debounce it
+// replaced, at 10, 32 and 64 inputs.
+//   pio test -e native -f test_debounce -v   (-v shows the timings)
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include <chrono>
+
+#include "EY_Debounce.h"
+
+static constexpr unsigned long WINDOW_MS = 20;
+
+void setUp() { g_testMillis = 0; }
+void tearDown() {}
+
+// ---- Behavior ----
+
+static void test_flips_after_four_differing_samples() {
+  EY_Debouncer<uint32_t> d;
+  d.begin(WINDOW_MS, 0);
+  for (int n = 0; n < 3; n++) TEST_ASSERT_EQUAL_UINT32(0, d.sample(0x5));
+  TEST_ASSERT_EQUAL_UINT32(0x5, d.sample(0x5));
+  TEST_ASSERT_EQUAL_UINT32(0x5, d.state);
+}
+
+static void test_bounce_restarts_the_count() {
+  EY_Debouncer<uint32_t> d;
+  d.begin(WINDOW_MS, 0);
+  d.sample(1);
+  d.sample(1);
+  d.sample(1);
+  d.sample(0);  // Bounce back: counter cleared
+  for (int n = 0; n < 3; n++) TEST_ASSERT_EQUAL_UINT32(0, d.sample(1));
+  TEST_ASSERT_EQUAL_UINT32(1, d.sample(1));
+}
+
+static void test_inputs_are_independent() {
+  EY_Debouncer<uint64_t> d;
+  d.begin(WINDOW_MS, 1ULL << 63);
+  uint64_t flipped = 0;
+  for (int n = 0; n < 4; n++) flipped |= d.sample(1 | (1ULL << 63));
+  TEST_ASSERT_EQUAL_UINT64(1, flipped);  // Bit 63 never disagreed
+  TEST_ASSERT_EQUAL_UINT64(1 | (1ULL << 63), d.state);
+}
+
+static void test_sample_until_follows_the_grid() {
+  EY_Debouncer<uint32_t> d;
+  d.begin(WINDOW_MS, 0);               // One sample every 5 ms
+  g_testMillis = 19;
+  TEST_ASSERT_EQUAL_UINT32(0, d.sampleUntil(g_testMillis, 1));  // 3 samples
+  g_testMillis = 20;
+  TEST_ASSERT_EQUAL_UINT32(1, d.sampleUntil(g_testMillis, 1));  // 4th
+}
+
+// ---- Microbenchmark ----
+
+// The per-input debounce EY_Debouncer replaced (one pair per sensor,
+// millis() arithmetic on every input at every tick)
+struct PerInput {
+  bool lastRaw;
+  bool level;
+  unsigned long lastChangeMs;
+};
+
+template <uint8_t N>
+static uint64_t perInputTick(PerInput (&inputs)[N], uint64_t raw, unsigned long nowMs) {
+  uint64_t flipped = 0;
+  for (uint8_t i = 0; i < N; i++) {
+    PerInput& in = inputs[i];
+    bool bit = (raw >> i) & 1;
+    if (bit != in.lastRaw) {
+      in.lastRaw = bit;
+      in.lastChangeMs = nowMs;
+    }
+    if (nowMs - in.lastChangeMs < WINDOW_MS) continue;
+    if (in.level != bit) {
+      in.level = bit;
+      flipped |= 1ULL << i;
+    }
+  }
+  return flipped;
+}
+
+static constexpr uint32_t BENCH_TICKS = 2000000;
+
+// Raw input words: a few inputs change every tick
+static uint64_t rawAt(uint32_t tick, uint8_t n) {
+  uint64_t x = tick * 0x9E3779B97F4A7C15ULL;
+  uint64_t word = (x ^ (x >> 29)) & (x >> 7);
+  return (n < 64) ? (word & ((1ULL << n) - 1)) : word;
+}
+
+template <uint8_t N>
+static void benchmark() {
+  using Word = EY_DebounceWord<N>;
+  using Clock = std::chrono::steady_clock;
+  volatile uint64_t sink = 0;
+
+  PerInput inputs[N] = {};
+  auto start = Clock::now();
+  for (uint32_t t = 0; t < BENCH_TICKS; t++) sink = sink + perInputTick(inputs, rawAt(t, N), t);
+  double perInputNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / BENCH_TICKS;
+
+  EY_Debouncer<Word> d;
+  d.begin(WINDOW_MS, 0);
+  start = Clock::now();
+  for (uint32_t t = 0; t < BENCH_TICKS; t++) sink = sink + d.sample((Word)rawAt(t, N));
+  double verticalNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / BENCH_TICKS;
+
+  char line[120];
+  snprintf(line, sizeof(line), "%2u inputs: per-input %6.2f ns/tick, vertical counter %6.2f ns/tick (x%.1f)",
+           N, perInputNs, verticalNs, perInputNs / verticalNs);
+  TEST_MESSAGE(line);
+  (void)sink;
+}
+
+static void test_benchmark_10_inputs() { benchmark<10>(); }
+static void test_benchmark_32_inputs() { benchmark<32>(); }
+static void test_benchmark_64_inputs() { benchmark<64>(); }
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_flips_after_four_differing_samples);
+  RUN_TEST(test_bounce_restarts_the_count);
+  RUN_TEST(test_inputs_are_independent);
+  RUN_TEST(test_sample_until_follows_the_grid);
+  RUN_TEST(test_benchmark_10_inputs);
+  RUN_TEST(test_benchmark_32_inputs);
+  RUN_TEST(test_benchmark_64_inputs);
+  return UNITY_END();
+}
@@ -0,0 +1,163 @@
+// Debounce policies (EY_Debounce.h) replayed against bounce traces
+// (traces.h) at the input sampler's 1 kHz: press/release latency and
+// spurious edges per policy, and the ADAPTIVE window converging.
+//   pio test -e native -f test_debounce_replay -v   (-v shows the table)
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "EY_Debounce.h"
+#include "traces.h"
+
+// EY_Config.h defaults
+static constexpr unsigned long DEBOUNCE_MS = 20;
+static constexpr unsigned long ADAPTIVE_MIN_MS = 2;
+static constexpr unsigned long ADAPTIVE_MAX_MS = 80;
+static constexpr uint8_t MAJORITY_SAMPLES = 8;
+static constexpr uint8_t MAJORITY_THRESHOLD = 6;
+
+static constexpr uint32_t SAMPLE_US = 1000;  // INPUT_SAMPLE_HZ = 1000
+
+enum class Policy : uint8_t { TRAILING, LEADING, ADAPTIVE, MAJORITY };
+static const char* const POLICY_NAMES[] = { "trailing", "leading", "adaptive", "majority" };
+
+// One input through one policy, state kept across replays
+struct Replayer {
+  Policy policy;
+  uint64_t level;
+  EY_Debouncer<uint32_t> trailing;
+  EY_LeadingDebounce<1> leading;
+  EY_AdaptiveDebounce<1> adaptive;
+  EY_MajorityDebounce<1> majority;
+
+  explicit Replayer(Policy p) : policy(p), level(0) {
+    g_testMillis = 0;
+    trailing.begin(DEBOUNCE_MS, 0);
+    leading.begin(DEBOUNCE_MS);
+    adaptive.begin(DEBOUNCE_MS, ADAPTIVE_MIN_MS, ADAPTIVE_MAX_MS, 0);
+    majority.begin(DEBOUNCE_MS, MAJORITY_SAMPLES, MAJORITY_THRESHOLD, 0);
+  }
+
+  // Returns true if the debounced level flipped
+  bool step(bool raw, unsigned long nowMs) {
+    switch (policy) {
+      case Policy::TRAILING:
+        if (!trailing.sampleUntil(nowMs, raw ? 1 : 0)) return false;
+        level = trailing.state;
+        return true;
+      case Policy::LEADING:  return leading.update(raw, level, 1, nowMs) != 0;
+      case Policy::ADAPTIVE: return adaptive.update(raw, level, 1, nowMs) != 0;
+      case Policy::MAJORITY: return majority.update(raw, level, 1, nowMs) != 0;
+    }
+    return false;
+  }
+};
+
+struct ReplayResult {
+  int32_t pressMs;    // Raw press to accepted press (-1 = never)
+  int32_t releaseMs;  // Raw release to accepted release (-1 = never)
+  uint8_t spurious;   // Accepted edges beyond the one press and release
+};
+
+// Replay a trace starting at `offsetMs` on the replayer's clock
+static ReplayResult replay(Replayer& r, const BounceTrace& trace, unsigned long offsetMs) {
+  ReplayResult result = { -1, -1, 0 };
+  for (uint32_t t = 0; t <= trace.lengthUs; t += SAMPLE_US) {
+    unsigned long nowMs = offsetMs + t / 1000;
+    g_testMillis = nowMs;
+    if (!r.step(EY_TraceLevel(trace, t), nowMs)) continue;
+
+    bool pressed = r.level & 1;
+    uint32_t from = pressed ? trace.pressUs : trace.releaseUs;
+    int32_t& slot = pressed ? result.pressMs : result.releaseMs;
+    bool expected = from && t >= from && slot < 0 &&
+                    (pressed ? (!trace.releaseUs || t < trace.releaseUs) : true);
+    if (expected) slot = (int32_t)((t - from) / 1000);
+    else result.spurious++;
+  }
+  return result;
+}
+
+static ReplayResult s_results[4][TRACE_COUNT];
+
+void setUp() {}
+void tearDown() {}
+
+static void test_replay_every_trace() {
+  char line[120];
+  TEST_MESSAGE("trace          policy     press ms  release ms  spurious");
+  for (uint8_t p = 0; p < 4; p++) {
+    for (uint8_t t = 0; t < TRACE_COUNT; t++) {
+      Replayer r((Policy)p);
+      s_results[p][t] = replay(r, TRACES[t], 0);
+      const ReplayResult& res = s_results[p][t];
+      snprintf(line, sizeof(line), "%-14s %-10s %8ld  %10ld  %8u", TRACES[t].name, POLICY_NAMES[p],
+               (long)res.pressMs, (long)res.releaseMs, res.spurious);
+      TEST_MESSAGE(line);
+    }
+  }
+}
+
+static void test_clean_contacts_every_policy_one_press_one_release() {
+  for (uint8_t p = 0; p < 4; p++) {
+    for (uint8_t t = 0; t < 2; t++) {  // reed, button
+      TEST_ASSERT_GREATER_OR_EQUAL(0, s_results[p][t].pressMs);
+      TEST_ASSERT_GREATER_OR_EQUAL(0, s_results[p][t].releaseMs);
+      TEST_ASSERT_EQUAL_UINT8(0, s_results[p][t].spurious);
+    }
+  }
+}
+
+static void test_leading_acts_on_the_first_edge() {
+  for (uint8_t t = 0; t < 2; t++) {
+    TEST_ASSERT_LESS_OR_EQUAL(1, s_results[(uint8_t)Policy::LEADING][t].pressMs);
+  }
+}
+
+static void test_trailing_waits_out_the_window() {
+  // 4 agreeing samples on the DEBOUNCE_MS / 4 grid: 3 to 4 periods after the edge
+  for (uint8_t t = 0; t < 2; t++) {
+    TEST_ASSERT_GREATER_OR_EQUAL((int32_t)(DEBOUNCE_MS * 3 / 4), s_results[(uint8_t)Policy::TRAILING][t].pressMs);
+    TEST_ASSERT_LESS_OR_EQUAL((int32_t)DEBOUNCE_MS, s_results[(uint8_t)Policy::TRAILING][t].pressMs);
+  }
+}
+
+static void test_majority_rides_out_cable_noise() {
+  const ReplayResult& res = s_results[(uint8_t)Policy::MAJORITY][2];
+  TEST_ASSERT_EQUAL_UINT8(0, res.spurious);
+  TEST_ASSERT_GREATER_OR_EQUAL(0, res.pressMs);
+  TEST_ASSERT_LESS_THAN((int32_t)DEBOUNCE_MS, res.pressMs);
+}
+
+static void test_adaptive_converges_on_a_clean_reed() {
+  Replayer r(Policy::ADAPTIVE);
+  const BounceTrace& reed = TRACES[0];
+  int32_t first = -1, last = -1;
+  char line[80];
+  for (uint8_t n = 0; n < 12; n++) {
+    ReplayResult res = replay(r, reed, n * (reed.lengthUs / 1000 + 1));
+    TEST_ASSERT_EQUAL_UINT8(0, res.spurious);
+    if (n == 0) first = res.pressMs;
+    last = res.pressMs;
+    snprintf(line, sizeof(line), "adaptive press %2u: %ld ms (window %lu ms)", n + 1, (long)res.pressMs,
+             r.adaptive.inputs[0].windowMs);
+    TEST_MESSAGE(line);
+  }
+  TEST_ASSERT_GREATER_OR_EQUAL((int32_t)DEBOUNCE_MS, first);
+  // Sampled at 1 kHz the reed's bounce never shows (every sample reads
+  // the settled level), so its target is 2 x 0 ms clamped to the minimum:
+  // the learned window must land on it exactly
+  TEST_ASSERT_EQUAL_UINT32(ADAPTIVE_MIN_MS, r.adaptive.inputs[0].windowMs);
+  TEST_ASSERT_LESS_OR_EQUAL((int32_t)ADAPTIVE_MIN_MS, last);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_replay_every_trace);
+  RUN_TEST(test_clean_contacts_every_policy_one_press_one_release);
+  RUN_TEST(test_leading_acts_on_the_first_edge);
+  RUN_TEST(test_trailing_waits_out_the_window);
+  RUN_TEST(test_majority_rides_out_cable_noise);
+  RUN_TEST(test_adaptive_converges_on_a_clean_reed);
+  return UNITY_END();
+}
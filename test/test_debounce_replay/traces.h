@@ -0,0 +1,55 @@
+#pragma once
+// Bounce traces for test_debounce_replay: raw edge times in µs, the input
+// starting released (0) and toggling at each time. Synthetic, shaped after
+// typical contact bounce and cable noise; replace or extend them with real
+// captures from the edge log (EY_EdgeLog) when tuning a prop.
+
+#include <stdint.h>
+
+struct BounceTrace {
+  const char* name;
+  const uint32_t* edgesUs;
+  uint16_t edgeCount;
+  uint32_t pressUs;    // First edge of the real press
+  uint32_t releaseUs;  // First edge of the real release (0 = held to the end)
+  uint32_t lengthUs;
+};
+
+// Reed switch: ~2 ms of bounce on both edges
+static const uint32_t REED_EDGES[] = {
+  100000, 100300, 100600, 101100, 101900,
+  400000, 400400, 400700, 401200, 401800,
+};
+
+// Tactile button: ~5 ms of bounce on press, ~3 ms on release
+static const uint32_t BUTTON_EDGES[] = {
+  100000, 100400, 100900, 101700, 102200, 103600, 104900,
+  300000, 300800, 302900,
+};
+
+// Long cable (Walk of Fame RFID line): single-sample spikes while idle,
+// then a held press with short dropouts, then more spikes
+static const uint32_t CABLE_EDGES[] = {
+  31200, 32100,   57400, 58300,   88900, 89800,            // idle spikes
+  150000,                                                  // press
+  167300, 168200, 201100, 202000, 236800, 237700,          // dropouts while held
+  300000,                                                  // release
+  331500, 332400, 364700, 365600,                          // idle spikes
+};
+
+#define EY_TRACE(name, edges, pressUs, releaseUs, lengthUs) \
+  { name, edges, sizeof(edges) / sizeof(edges[0]), pressUs, releaseUs, lengthUs }
+
+static const BounceTrace TRACES[] = {
+  EY_TRACE("reed 2 ms",    REED_EDGES,   100000, 400000, 600000),
+  EY_TRACE("button 5 ms",  BUTTON_EDGES, 100000, 300000, 500000),
+  EY_TRACE("noisy cable",  CABLE_EDGES,  150000, 300000, 450000),
+};
+static const uint8_t TRACE_COUNT = sizeof(TRACES) / sizeof(TRACES[0]);
+
+// Raw level at `timeUs` (odd number of edges passed = pressed)
+inline bool EY_TraceLevel(const BounceTrace& trace, uint32_t timeUs) {
+  uint16_t passed = 0;
+  while (passed < trace.edgeCount && trace.edgesUs[passed] <= timeUs) passed++;
+  return passed & 1;
+}
@@ -0,0 +1,169 @@
+// DMX512 frame timing (EY_DMX.h) against ANSI E1.11 transmitter limits:
+// the slot arithmetic, then EY_DMX_NextFrame() driving a model of the UART
+// (frame, trailing break, then idle until the next write) to measure the
+// break-to-break spacing and mark-after-break that reach the wire.
+//   pio test -e native -f test_dmx -v   (-v shows the measured timings)
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "EY_DMX.h"
+
+void setUp() {}
+void tearDown() {}
+
+static void test_bit_and_slot_times() {
+  TEST_ASSERT_EQUAL_UINT32(4, EY_DMX_BIT_US);
+  TEST_ASSERT_EQUAL_UINT32(44, EY_DMX_SLOT_US);  // 1 start, 8 data, 2 stop bits
+}
+
+static void test_break_within_spec() {
+  uint32_t breakUs = EY_DMX_BREAK_BITS * EY_DMX_BIT_US;
+  TEST_ASSERT_EQUAL_UINT32(100, breakUs);
+  TEST_ASSERT_GREATER_OR_EQUAL(92, breakUs);      // Transmitted break >= 92 µs
+  TEST_ASSERT_LESS_THAN(1000000, breakUs);        // ... and < 1 s
+  TEST_ASSERT_GREATER_OR_EQUAL(12, EY_DMX_MAB_BITS * EY_DMX_BIT_US);  // UART idle floor
+}
+
+static void test_full_universe_frame() {
+  // Break + shortest MAB, then start code + 512 slots
+  TEST_ASSERT_EQUAL_UINT32(112 + 513 * 44, EY_DMX_FrameUs(512));
+  TEST_ASSERT_EQUAL_UINT32(22684, EY_DMX_FrameUs(512));
+  TEST_ASSERT_EQUAL_UINT32(44, EY_DMX_MaxRefreshHz(512));  // DMX_REFRESH_HZ default
+}
+
+// ---- Scheduling against a UART model ----
+
+struct WireTiming {
+  uint32_t frames;
+  uint32_t minMabUs, maxMabUs;  // End of a break to the next start code
+  uint32_t minB2bUs, maxB2bUs;  // Break start to break start
+  uint32_t lastMabUs;
+  uint32_t retries;             // Timer passes that found the UART busy
+};
+
+// Run the timer callback's scheduling for `durationUs`. The timer fires
+// `lateUs` after its deadline; frame `stallFrame` (0 = none) keeps the
+// driver busy `stallUs` past its break.
+static WireTiming simulate(uint16_t channels, uint32_t hz, uint64_t durationUs,
+                           uint32_t lateUs = 0, uint32_t stallFrame = 0, uint32_t stallUs = 0) {
+  const uint32_t periodUs = 1000000UL / hz;
+  WireTiming w = { 0, UINT32_MAX, 0, UINT32_MAX, 0, 0, 0 };
+  uint64_t nextUs = 0, atUs = 0;  // EY_DMX_Begin(): due now
+  uint64_t doneUs = 0;            // uart_wait_tx_done() succeeds from here
+  uint64_t breakStartUs = 0, breakEndUs = 0;
+
+  while (atUs < durationUs) {
+    uint64_t nowUs = atUs + lateUs;
+    if (!EY_DMX_NextFrame(nextUs, periodUs, nowUs, nowUs < doneUs, atUs)) {
+      w.retries++;
+      continue;
+    }
+
+    // The UART idles at least EY_DMX_MAB_BITS after the break
+    uint64_t floorUs = breakEndUs + EY_DMX_MAB_BITS * EY_DMX_BIT_US;
+    uint64_t startUs = (w.frames > 0 && nowUs < floorUs) ? floorUs : nowUs;
+    uint64_t nextBreakUs = startUs + (1 + channels) * EY_DMX_SLOT_US;
+    if (w.frames > 0) {
+      uint32_t mab = (uint32_t)(startUs - breakEndUs);
+      uint32_t b2b = (uint32_t)(nextBreakUs - breakStartUs);
+      if (mab < w.minMabUs) w.minMabUs = mab;
+      if (mab > w.maxMabUs) w.maxMabUs = mab;
+      if (b2b < w.minB2bUs) w.minB2bUs = b2b;
+      if (b2b > w.maxB2bUs) w.maxB2bUs = b2b;
+      w.lastMabUs = mab;
+    }
+    breakStartUs = nextBreakUs;
+    breakEndUs = breakStartUs + EY_DMX_BREAK_BITS * EY_DMX_BIT_US;
+    w.frames++;
+    doneUs = breakEndUs + (w.frames == stallFrame ? stallUs : 0);
+  }
+  return w;
+}
+
+static void report(const char* name, const WireTiming& w) {
+  char line[140];
+  snprintf(line, sizeof(line), "%-28s %4lu frames  MAB %lu-%lu us  break-to-break %lu-%lu us", name,
+           (unsigned long)w.frames, (unsigned long)w.minMabUs, (unsigned long)w.maxMabUs,
+           (unsigned long)w.minB2bUs, (unsigned long)w.maxB2bUs);
+  TEST_MESSAGE(line);
+}
+
+// ANSI E1.11 transmitter limits
+static void assertWithinSpec(const WireTiming& w) {
+  TEST_ASSERT_GREATER_OR_EQUAL(12, w.minMabUs);
+  TEST_ASSERT_LESS_THAN(1000000, w.maxMabUs);
+  TEST_ASSERT_GREATER_OR_EQUAL(1204, w.minB2bUs);
+  TEST_ASSERT_LESS_OR_EQUAL(1250000, w.maxB2bUs);
+}
+
+static void test_full_universe_at_44_hz() {
+  WireTiming w = simulate(512, 44, 10000000);
+  report("512 ch, 44 Hz", w);
+  assertWithinSpec(w);
+  TEST_ASSERT_UINT32_WITHIN(1, 440, w.frames);
+  // The period leaves 22727 - 22672 µs between break and start code
+  TEST_ASSERT_EQUAL_UINT32(55, w.minMabUs);
+  TEST_ASSERT_EQUAL_UINT32(55, w.maxMabUs);
+  TEST_ASSERT_EQUAL_UINT32(22727, w.minB2bUs);
+  TEST_ASSERT_EQUAL_UINT32(22727, w.maxB2bUs);
+}
+
+static void test_full_universe_at_44_hz_late_timer() {
+  // A constant timer latency shifts every frame alike
+  WireTiming w = simulate(512, 44, 10000000, 300);
+  report("512 ch, 44 Hz, timer +300 us", w);
+  assertWithinSpec(w);
+  TEST_ASSERT_EQUAL_UINT32(55, w.minMabUs);
+  TEST_ASSERT_EQUAL_UINT32(22727, w.maxB2bUs);
+  TEST_ASSERT_EQUAL_UINT32(0, w.retries);
+}
+
+static void test_busy_uart_retries_then_recovers() {
+  // The driver finishes frame 10 late: the frame after it waits one
+  // retry, then the period restarts from it
+  WireTiming w = simulate(512, 44, 10000000, 0, 10, 200);
+  report("512 ch, 44 Hz, one stall", w);
+  assertWithinSpec(w);
+  TEST_ASSERT_EQUAL_UINT32(55, w.minMabUs);
+  TEST_ASSERT_EQUAL_UINT32(55 + EY_DMX_RETRY_US, w.maxMabUs);
+  TEST_ASSERT_EQUAL_UINT32(22727 + EY_DMX_RETRY_US, w.maxB2bUs);
+  TEST_ASSERT_EQUAL_UINT32(55, w.lastMabUs);  // Back to the normal spacing...
+  TEST_ASSERT_EQUAL_UINT32(1, w.retries);     // ...without retrying every frame after
+  TEST_ASSERT_UINT32_WITHIN(1, 440, w.frames);
+}
+
+static void test_low_refresh_rates() {
+  WireTiming w = simulate(512, 10, 10000000);
+  report("512 ch, 10 Hz", w);
+  assertWithinSpec(w);
+  TEST_ASSERT_EQUAL_UINT32(100000 - 22672, w.minMabUs);
+
+  w = simulate(512, 1, 10000000);
+  report("512 ch, 1 Hz", w);
+  assertWithinSpec(w);
+  TEST_ASSERT_EQUAL_UINT32(1000000, w.maxB2bUs);
+}
+
+static void test_shortest_frame_at_its_highest_rate() {
+  // 24 slots at the most they allow: break-to-break right at 1204 µs,
+  // the MAB only from the UART's idle floor
+  WireTiming w = simulate(24, EY_DMX_MaxRefreshHz(24), 1000000);
+  report("24 ch, max Hz", w);
+  assertWithinSpec(w);
+  TEST_ASSERT_EQUAL_UINT32(12, w.minMabUs);
+  TEST_ASSERT_LESS_THAN(1204, EY_DMX_FrameUs(23));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_bit_and_slot_times);
+  RUN_TEST(test_break_within_spec);
+  RUN_TEST(test_full_universe_frame);
+  RUN_TEST(test_full_universe_at_44_hz);
+  RUN_TEST(test_full_universe_at_44_hz_late_timer);
+  RUN_TEST(test_busy_uart_retries_then_recovers);
+  RUN_TEST(test_low_refresh_rates);
+  RUN_TEST(test_shortest_frame_at_its_highest_rate);
+  return UNITY_END();
+}
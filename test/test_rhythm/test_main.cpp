@@ -0,0 +1,118 @@
+// Rhythm matching (EY_Rhythm.cpp) for a EY_RHYTHM(2, 1, 1, 2) knock:
+// exact and half tempo solve, an off-rhythm gap does not, a long pause
+// starts over, and GM force-presses solve in 5 steps.
+//   pio test -e native -f test_rhythm
+
+#include <Arduino.h>
+#include <unity.h>
+
+// The prop header is included from include/EY_Config.h
+#define PROP_CONFIG "../test/test_rhythm/prop_rhythm.h"
+#include "../../src/EY_Rhythm.cpp"
+
+static constexpr uint64_t UNIT_US = 200000;  // 1 pattern unit at the reference tempo
+
+// Knock the group at the given gaps (in µs) from `startUs`; returns the
+// last press time
+static uint64_t knock(uint64_t startUs, const uint64_t* gapsUs, uint8_t count) {
+  uint64_t t = startUs;
+  EY_Rhythm_Press(0, t);
+  for (uint8_t j = 0; j < count; j++) {
+    t += gapsUs[j];
+    EY_Rhythm_Press(0, t);
+  }
+  return t;
+}
+
+void setUp() { EY_Rhythm_Reset(0); }
+void tearDown() {}
+
+static void test_exact_tempo_solves() {
+  const uint64_t gaps[] = { 2 * UNIT_US, UNIT_US, UNIT_US, 2 * UNIT_US };
+  knock(1000000, gaps, 4);
+  TEST_ASSERT_TRUE(EY_Rhythm_IsSolved(0));
+  TEST_ASSERT_EQUAL_UINT8(100, EY_Rhythm_GetQuality(0));
+  TEST_ASSERT_EQUAL_UINT8(100, EY_Rhythm_GetProgress(0));
+}
+
+static void test_half_tempo_solves() {
+  // Twice as slow, still well under RHYTHM_TIMEOUT_MS per gap
+  const uint64_t gaps[] = { 4 * UNIT_US, 2 * UNIT_US, 2 * UNIT_US, 4 * UNIT_US };
+  knock(1000000, gaps, 4);
+  TEST_ASSERT_TRUE(EY_Rhythm_IsSolved(0));
+  TEST_ASSERT_EQUAL_UINT8(100, EY_Rhythm_GetQuality(0));
+}
+
+static void test_within_tolerance_solves() {
+  // Human timing: every gap a little off, under RHYTHM_TOLERANCE_PCT
+  const uint64_t gaps[] = { 2 * UNIT_US, UNIT_US * 110 / 100, UNIT_US * 90 / 100, 2 * UNIT_US };
+  knock(1000000, gaps, 4);
+  TEST_ASSERT_TRUE(EY_Rhythm_IsSolved(0));
+  TEST_ASSERT_LESS_THAN(100, EY_Rhythm_GetQuality(0));
+  TEST_ASSERT_GREATER_OR_EQUAL(100 - RHYTHM_TOLERANCE_PCT, EY_Rhythm_GetQuality(0));
+}
+
+static void test_off_rhythm_does_not_solve() {
+  // Even knocks: the 2nd gap should be half the 1st
+  const uint64_t gaps[] = { UNIT_US, UNIT_US, UNIT_US, UNIT_US };
+  knock(1000000, gaps, 4);
+  TEST_ASSERT_FALSE(EY_Rhythm_IsSolved(0));
+  TEST_ASSERT_LESS_THAN(100, EY_Rhythm_GetProgress(0));
+}
+
+static void test_broken_rhythm_keeps_the_fitting_tail() {
+  // A stray knock, then the whole rhythm: the stray one is dropped
+  const uint64_t gaps[] = { 3 * UNIT_US, 2 * UNIT_US, UNIT_US, UNIT_US, 2 * UNIT_US };
+  knock(1000000, gaps, 5);
+  TEST_ASSERT_TRUE(EY_Rhythm_IsSolved(0));
+}
+
+static void test_long_pause_starts_over() {
+  const uint64_t start[] = { 2 * UNIT_US, UNIT_US };
+  uint64_t t = knock(1000000, start, 2);
+  TEST_ASSERT_EQUAL_UINT8(3 * 100 / 5, EY_Rhythm_GetProgress(0));
+
+  t += (RHYTHM_TIMEOUT_MS + 1) * 1000ULL;
+  EY_Rhythm_Press(0, t);
+  TEST_ASSERT_EQUAL_UINT8(1 * 100 / 5, EY_Rhythm_GetProgress(0));
+  TEST_ASSERT_FALSE(EY_Rhythm_IsSolved(0));
+}
+
+static void test_force_press_solves_in_five_steps() {
+  uint64_t t = 1000000;
+  for (uint8_t n = 0; n < 4; n++) {
+    TEST_ASSERT_FALSE(EY_Rhythm_ForcePress(0, t));
+    t += 50000;  // GM clicks, at any pace
+  }
+  TEST_ASSERT_TRUE(EY_Rhythm_ForcePress(0, t));
+  TEST_ASSERT_TRUE(EY_Rhythm_IsSolved(0));
+}
+
+static void test_real_presses_carry_on_after_a_force() {
+  // Two real knocks set the tempo, the GM forces the 3rd, the player
+  // finishes on time from the forced one
+  uint64_t t = 1000000;
+  EY_Rhythm_Press(0, t);
+  t += 2 * UNIT_US;
+  EY_Rhythm_Press(0, t);
+  t += 300000;  // Whenever the GM clicks
+  EY_Rhythm_ForcePress(0, t);
+  t += UNIT_US;
+  EY_Rhythm_Press(0, t);
+  TEST_ASSERT_EQUAL_UINT8(4 * 100 / 5, EY_Rhythm_GetProgress(0));
+  t += 2 * UNIT_US;
+  TEST_ASSERT_TRUE(EY_Rhythm_Press(0, t));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_exact_tempo_solves);
+  RUN_TEST(test_half_tempo_solves);
+  RUN_TEST(test_within_tolerance_solves);
+  RUN_TEST(test_off_rhythm_does_not_solve);
+  RUN_TEST(test_broken_rhythm_keeps_the_fitting_tail);
+  RUN_TEST(test_long_pause_starts_over);
+  RUN_TEST(test_force_press_solves_in_five_steps);
+  RUN_TEST(test_real_presses_carry_on_after_a_force);
+  return UNITY_END();
+}
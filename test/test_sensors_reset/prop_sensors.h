@@ -0,0 +1,30 @@
+#pragma once
+// =====================================================
+// Test prop: a knock sensor, SolveMode::RHYTHM (test_sensors_reset)
+// =====================================================
+
+// Identity
+static const char* SITE_ID     = "ey1";
+static const char* ROOM_ID     = "hollywood";
+static const char* DEVICE_ID   = "test_sensors";
+static const char* DEVICE_NAME = "Test Sensors";
+
+// Static IP
+static const IPAddress STATIC_IP(192, 168, 2, 251);
+
+// Sensors
+static constexpr SensorDef SENSORS[] = {
+  //  id       pin  presentWhen              actionEvent  needsArming
+  { "knock",   13,  PresentWhen::LOW_LEVEL,  "knock",     false },
+};
+static constexpr uint8_t SENSOR_COUNT = sizeof(SENSORS) / sizeof(SENSORS[0]);
+static constexpr SolveMode SOLVE_MODE = SolveMode::RHYTHM;
+#define RHYTHM_PATTERN EY_RHYTHM(1, 1)  // 3 even knocks
+
+// No outputs
+static const OutputDef OUTPUTS[] = {};
+static constexpr uint8_t OUTPUT_COUNT = 0;
+
+// LED
+static const bool LED_ACTIVE_LOW = false;
+static const int LED_MIRROR_SENSOR = 0;  // knock
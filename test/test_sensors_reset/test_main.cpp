@@ -0,0 +1,147 @@
+// Sensors after a prop reset (EY_Sensors.cpp): changes the sampler
+// records while main.cpp ignores sensors (IGNORE_SENSORS_MS) must not be
+// replayed when ticking resumes, once EY_Sensors_Resync() is called. A
+// RHYTHM prop, whose presses are timed during the replay itself.
+//   pio test -e native -f test_sensors_reset
+
+#include <Arduino.h>
+#include <unity.h>
+
+// The prop header is included from include/EY_Config.h
+#define PROP_CONFIG "../test/test_sensors_reset/prop_sensors.h"
+#include "../../src/EY_Sensors.cpp"
+#include "../../src/EY_Rhythm.cpp"
+
+// ---- Input sampler stand-in: every change stored, none lost ----
+
+static EY_InputSample s_samples[64];
+static uint32_t s_sampleCount = 0;
+static EY_InputFrame s_frame;
+
+void EY_Inputs_CursorBegin(EY_InputCursor& cursor) {
+  cursor.seq = s_sampleCount;
+  cursor.frame = s_frame;
+  cursor.lastUs = (uint64_t)esp_timer_get_time();
+  cursor.overruns = 0;
+}
+
+bool EY_Inputs_Next(EY_InputCursor& cursor, EY_InputSample& out) {
+  if (cursor.seq == s_sampleCount) return false;
+  out = s_samples[cursor.seq++];
+  if (out.timeUs < cursor.lastUs) out.timeUs = cursor.lastUs;
+  cursor.lastUs = out.timeUs;
+  cursor.frame = out.frame;
+  return true;
+}
+
+uint64_t EY_Inputs_CursorNowUs(EY_InputCursor& cursor) {
+  uint64_t nowUs = (uint64_t)esp_timer_get_time();
+  if (nowUs > cursor.lastUs) cursor.lastUs = nowUs;
+  return cursor.lastUs;
+}
+
+// Knock sensor (GPIO 13, present when LOW) pressed or released now
+static void knock(bool pressed) {
+  if (pressed) s_frame.bank[EY_BANK_GPIO] &= ~EY_PinBit(13);
+  else         s_frame.bank[EY_BANK_GPIO] |= EY_PinBit(13);
+  s_samples[s_sampleCount++] = { (uint64_t)esp_timer_get_time(), s_frame };
+}
+
+// ---- Other modules ----
+
+static uint8_t s_events = 0;
+static uint8_t s_accepted = 0;  // Debounced transitions
+
+void EY_PublishGroupEvent(uint8_t, const char*, const char*) { s_events++; }
+void EY_EdgeLog_Reset() {}
+void EY_EdgeLog_RawEdge(uint8_t, bool, bool, uint64_t) {}
+void EY_EdgeLog_Accepted(uint8_t, uint64_t) { s_accepted++; }
+
+// ---- Tests ----
+
+// loop() ticking every 5 ms for `ms`
+static void tickFor(unsigned long ms) {
+  for (unsigned long end = g_testMillis + ms; g_testMillis < end;) {
+    g_testMillis += 5;
+    EY_Sensors_Tick();
+  }
+}
+
+// loop() not ticking sensors for `ms`
+static void waitFor(unsigned long ms) {
+  g_testMillis += ms;
+}
+
+void setUp() {
+  s_sampleCount = 0;
+  s_frame = {};
+  s_frame.bank[EY_BANK_GPIO] = EY_PinBit(13) | EY_PinBit(14);  // Pull-ups: released
+  g_testMillis = 1000;
+  EY_Sensors_Begin();
+  tickFor(100);
+  s_events = 0;
+  s_accepted = 0;
+}
+void tearDown() {}
+
+// Prop reset, then the whole rhythm knocked inside the ignore window
+static void resetThenKnockInWindow() {
+  EY_Sensors_Reset();
+  for (uint8_t n = 0; n < 3; n++) {
+    waitFor(300);
+    knock(true);
+    waitFor(100);
+    knock(false);
+  }
+  waitFor(IGNORE_SENSORS_MS - 3 * 400);
+}
+
+static void test_knocks_inside_ignore_window_yield_no_event() {
+  resetThenKnockInWindow();
+  EY_Sensors_Resync();
+  tickFor(200);
+  TEST_ASSERT_EQUAL_UINT8(0, s_events);
+  TEST_ASSERT_EQUAL_UINT8(0, s_accepted);
+  TEST_ASSERT_EQUAL_UINT8(0, EY_Rhythm_GetProgress(0));
+  TEST_ASSERT_FALSE(EY_Sensors_IsSolved(0));
+}
+
+static void test_without_resync_the_window_is_replayed() {
+  // What the resync prevents: the stored knocks are debounced, timed and
+  // solve the group
+  resetThenKnockInWindow();
+  tickFor(200);
+  TEST_ASSERT_EQUAL_UINT8(6, s_accepted);
+  TEST_ASSERT_TRUE(EY_Sensors_IsSolved(0));
+}
+
+static void test_knock_after_window_counts() {
+  resetThenKnockInWindow();
+  EY_Sensors_Resync();
+  tickFor(50);
+  knock(true);
+  tickFor(100);
+  TEST_ASSERT_EQUAL_UINT8(1, s_events);
+  TEST_ASSERT_EQUAL_UINT8(100 / 3, EY_Rhythm_GetProgress(0));
+}
+
+static void test_held_through_window_counts_from_resync() {
+  // Like a sensor already present at the reset
+  EY_Sensors_Reset();
+  waitFor(500);
+  knock(true);
+  waitFor(IGNORE_SENSORS_MS - 500);
+  EY_Sensors_Resync();
+  tickFor(100);
+  TEST_ASSERT_EQUAL_UINT8(1, s_events);
+  TEST_ASSERT_EQUAL_UINT8(1, EY_Sensors_GetPresentCount());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_knocks_inside_ignore_window_yield_no_event);
+  RUN_TEST(test_without_resync_the_window_is_replayed);
+  RUN_TEST(test_knock_after_window_counts);
+  RUN_TEST(test_held_through_window_counts_from_resync);
+  return UNITY_END();
+}